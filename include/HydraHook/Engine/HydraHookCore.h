@@ -73,6 +73,7 @@ extern "C" {
         HYDRAHOOK_ERROR_CREATE_EVENT_FAILED = 0xE0000008,       /**< CreateEvent failed for cancellation. */
         HYDRAHOOK_ERROR_CREATE_LOGGER_FAILED = 0xE0000009,      /**< Failed to create fallback logger. */
         HYDRAHOOK_ERROR_NO_LOADER_LOCK = 0xE000000A,            /**< Initialization attempted outside of loader lock. */
+        HYDRAHOOK_ERROR_INVALID_PARAMETER = 0xE000000B,         /**< A parameter is NULL or out of range. */
 
     } HYDRAHOOK_ERROR;
 
@@ -87,6 +88,29 @@ extern "C" {
         HydraHookDirect3DVersion12 = 1 << 3   /**< Direct3D 12. */
     } HYDRAHOOK_D3D_VERSION, *PHYDRAHOOK_D3D_VERSION;
 
+    /**
+     * @brief Accounting tags for memory obtained from the HydraHook allocator.
+     *
+     * Engine subsystems use the reserved tags below HydraHookMemoryTagHostUser0;
+     * hosts may assign their own subsystems (capture rings, UI atlases, ...) to
+     * the HostUser tags.
+     */
+    typedef enum _HYDRAHOOK_MEMORY_TAG {
+        HydraHookMemoryTagEngine = 0,     /**< Engine internals (hook bookkeeping, containers). */
+        HydraHookMemoryTagLogging = 1,    /**< Logger sinks and buffers. */
+        HydraHookMemoryTagContext = 2,    /**< Memory from HydraHookEngineAllocCustomContext. */
+        HydraHookMemoryTagHost = 3,       /**< Untagged host allocations (HydraHookAlloc). */
+        HydraHookMemoryTagHostUser0 = 8,  /**< First host-defined tag. */
+        HydraHookMemoryTagHostUser1,      /**< Host-defined tag. */
+        HydraHookMemoryTagHostUser2,      /**< Host-defined tag. */
+        HydraHookMemoryTagHostUser3,      /**< Host-defined tag. */
+        HydraHookMemoryTagHostUser4,      /**< Host-defined tag. */
+        HydraHookMemoryTagHostUser5,      /**< Host-defined tag. */
+        HydraHookMemoryTagHostUser6,      /**< Host-defined tag. */
+        HydraHookMemoryTagHostUser7,      /**< Last host-defined tag. */
+        HydraHookMemoryTagCount           /**< Number of tags; not a valid tag. */
+    } HYDRAHOOK_MEMORY_TAG;
+
     /** @brief Opaque handle to the HydraHook engine instance. */
     typedef struct _HYDRAHOOK_ENGINE *PHYDRAHOOK_ENGINE;
 
@@ -207,6 +231,85 @@ extern "C" {
 
     typedef EVT_HYDRAHOOK_GAME_EXIT *PFN_HYDRAHOOK_GAME_EXIT;
 
+    /**
+     * @brief Memory usage of a single accounting tag.
+     */
+    typedef struct _HYDRAHOOK_MEMORY_STATS
+    {
+        SIZE_T CurrentBytes;  /**< Bytes currently allocated under the tag (size-class rounded). */
+        SIZE_T PeakBytes;     /**< Highest CurrentBytes observed (sampled each second and on query). */
+        SIZE_T BudgetBytes;   /**< Configured budget, or 0 if unlimited. */
+        SIZE_T HeapBytes;     /**< Bytes the allocator holds from the OS across all tags. */
+
+    } HYDRAHOOK_MEMORY_STATS, *PHYDRAHOOK_MEMORY_STATS;
+
+    /**
+     * @brief Callback invoked on the engine thread when a tag crosses its warning
+     *        threshold or exceeds its budget.
+     */
+    typedef
+        _Function_class_(EVT_HYDRAHOOK_MEMORY_BUDGET)
+        VOID
+        EVT_HYDRAHOOK_MEMORY_BUDGET(
+            PHYDRAHOOK_ENGINE EngineHandle,
+            HYDRAHOOK_MEMORY_TAG Tag,
+            SIZE_T CurrentBytes,
+            SIZE_T BudgetBytes
+        );
+
+    typedef EVT_HYDRAHOOK_MEMORY_BUDGET *PFN_HYDRAHOOK_MEMORY_BUDGET;
+
+    /**
+     * @brief Per-tag memory budget passed to HydraHookEngineSetMemoryBudget.
+     */
+    typedef struct _HYDRAHOOK_MEMORY_BUDGET
+    {
+        SIZE_T BudgetBytes;   /**< Hard budget; 0 = unlimited. */
+        SIZE_T WarningBytes;  /**< Soft threshold; 0 = no warning. */
+        PFN_HYDRAHOOK_MEMORY_BUDGET EvtMemoryBudgetWarning;  /**< Invoked once each time usage rises above WarningBytes. */
+        PFN_HYDRAHOOK_MEMORY_BUDGET EvtMemoryBudgetExceeded; /**< Invoked on every check while usage exceeds BudgetBytes; release (evict) cached data for the tag. */
+
+    } HYDRAHOOK_MEMORY_BUDGET, *PHYDRAHOOK_MEMORY_BUDGET;
+
+    /**
+     * @brief Initializes a memory budget structure (unlimited, no callbacks).
+     * @param[out] Budget Budget structure to initialize.
+     */
+    VOID FORCEINLINE HYDRAHOOK_MEMORY_BUDGET_INIT(
+        PHYDRAHOOK_MEMORY_BUDGET Budget
+    )
+    {
+        ZeroMemory(Budget, sizeof(HYDRAHOOK_MEMORY_BUDGET));
+    }
+
+    /**
+     * @brief Visitor invoked by HydraHookEngineEnumerateThreadContexts for each slot.
+     * @return TRUE to continue enumeration, FALSE to stop.
+     */
+    typedef
+        _Function_class_(EVT_HYDRAHOOK_THREAD_CONTEXT_VISITOR)
+        BOOL
+        EVT_HYDRAHOOK_THREAD_CONTEXT_VISITOR(
+            PHYDRAHOOK_ENGINE EngineHandle,
+            DWORD ThreadId,
+            PVOID ThreadContext,
+            PVOID UserData
+        );
+
+    typedef EVT_HYDRAHOOK_THREAD_CONTEXT_VISITOR *PFN_HYDRAHOOK_THREAD_CONTEXT_VISITOR;
+
+    /**
+     * @brief Callback CPU budget counters, see HydraHookEngineGetCallbackBudgetStats.
+     */
+    typedef struct _HYDRAHOOK_CALLBACK_BUDGET_STATS
+    {
+        ULONGLONG Invocations;        /**< Timed callback invocations. */
+        ULONGLONG Overruns;           /**< Invocations that took longer than the budget. */
+        ULONGLONG Skipped;            /**< Invocations skipped by automatic throttling. */
+        ULONG PeakMicroseconds;       /**< Longest single invocation observed. */
+
+    } HYDRAHOOK_CALLBACK_BUDGET_STATS, *PHYDRAHOOK_CALLBACK_BUDGET_STATS;
+
     /**
      * @brief Engine configuration passed to HydraHookEngineCreate.
      */
@@ -234,6 +337,9 @@ extern "C" {
         {
             BOOL IsEnabled;       /**< TRUE to enable logging. */
             PCSTR FilePath;      /**< Fallback log path (e.g. %TEMP%\\HydraHook.log); used if process/DLL dirs fail. */
+            ULONGLONG MaxFileSize; /**< Size in bytes at which the log file is rotated (default: 16 MiB); 0 = single unbounded file. */
+            ULONG MaxFiles;       /**< Rotated log files to keep next to the active one (default: 5). */
+            BOOL Compress;        /**< TRUE to gzip rotated log files on a background thread (default). */
         } Logging;
 
         struct
@@ -244,6 +350,19 @@ extern "C" {
             PFN_HYDRAHOOK_CRASH_HANDLER EvtCrashHandler; /**< Optional pre-dump callback; return FALSE to skip dump. */
         } CrashHandler;
 
+        struct
+        {
+            ULONG BudgetMicroseconds;    /**< CPU budget of each host callback per invocation (i.e. per frame for Present); 0 = disabled (default). */
+            BOOL AutoThrottle;           /**< TRUE to invoke per-frame callbacks whose moving average exceeds the budget only every Nth time; resize/reset callbacks always run. */
+            ULONG MaxThrottleInterval;   /**< Upper bound for N when throttling (default: 8). */
+        } CallbackBudget;
+
+        struct
+        {
+            BOOL IsEnabled;              /**< TRUE to record every hooked call to a binary file (see HydraHookRecord.h). */
+            PCSTR FilePath;              /**< Recording path; environment variables are expanded (default: %TEMP%\\HydraHook.hhrec). */
+        } Recorder;
+
     } HYDRAHOOK_ENGINE_CONFIG, *PHYDRAHOOK_ENGINE_CONFIG;
 
     /**
@@ -258,8 +377,15 @@ extern "C" {
 
         EngineConfig->Logging.IsEnabled = TRUE;
         EngineConfig->Logging.FilePath = "%TEMP%\\HydraHook.log";
+        EngineConfig->Logging.MaxFileSize = 16 * 1024 * 1024;
+        EngineConfig->Logging.MaxFiles = 5;
+        EngineConfig->Logging.Compress = TRUE;
 
         EngineConfig->CrashHandler.DumpType = HydraHookDumpTypeNormal;
+
+        EngineConfig->CallbackBudget.MaxThrottleInterval = 8;
+
+        EngineConfig->Recorder.FilePath = "%TEMP%\\HydraHook.hhrec";
     }
 
     /**
@@ -314,7 +440,7 @@ BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID) \
      * @retval HYDRAHOOK_ERROR_NONE Success.
      * @retval HYDRAHOOK_ERROR_ENGINE_ALREADY_ALLOCATED Engine already exists for this HMODULE.
      * @retval HYDRAHOOK_ERROR_GET_MODULE_HANDLE_FAILED GetModuleHandleEx failed (deprecated alias: HYDRAHOOK_ERROR_REFERENCE_INCREMENT_FAILED).
-     * @retval HYDRAHOOK_ERROR_ENGINE_ALLOCATION_FAILED malloc failed.
+     * @retval HYDRAHOOK_ERROR_ENGINE_ALLOCATION_FAILED Engine structure allocation failed.
      * @retval HYDRAHOOK_ERROR_CREATE_EVENT_FAILED CreateEvent failed.
      * @retval HYDRAHOOK_ERROR_CREATE_THREAD_FAILED CreateThread failed.
      * @retval HYDRAHOOK_ERROR_CREATE_LOGGER_FAILED Fallback logger creation failed.
@@ -350,7 +476,7 @@ BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID) \
      * @param[in] ContextSize Size in bytes.
      * @retval HYDRAHOOK_ERROR_NONE Success.
      * @retval HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE Engine is NULL.
-     * @retval HYDRAHOOK_ERROR_CONTEXT_ALLOCATION_FAILED malloc failed.
+     * @retval HYDRAHOOK_ERROR_CONTEXT_ALLOCATION_FAILED Context allocation failed.
      */
     HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineAllocCustomContext(
         _In_
@@ -382,6 +508,224 @@ BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID) \
         PHYDRAHOOK_ENGINE Engine
     );
 
+    /**
+     * @brief Declares the size of per-thread context slots.
+     *
+     * Unlike the single custom context, each hooking thread (render, audio,
+     * command submission, ...) lazily gets its own zeroed slot on its first
+     * HydraHookEngineGetThreadContext call. Slots start on a cache line and are
+     * padded to whole cache lines, so hot per-thread state needs no atomics and
+     * never false-shares. Replaces (frees) any existing slots; call before hooks
+     * run (e.g. in EvtHydraHookGameHooked) or after unhooking.
+     *
+     * @param[in] Engine Valid engine handle.
+     * @param[in] ContextSize Size of each slot in bytes.
+     * @retval HYDRAHOOK_ERROR_NONE Success.
+     * @retval HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE Engine is NULL.
+     * @retval HYDRAHOOK_ERROR_INVALID_PARAMETER ContextSize is zero.
+     */
+    HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineAllocThreadContext(
+        _In_
+        PHYDRAHOOK_ENGINE Engine,
+        _In_
+        size_t ContextSize
+    );
+
+    /**
+     * @brief Returns the calling thread's context slot, creating it on first use.
+     *
+     * The fast path is a thread-local compare; safe to call on every callback.
+     *
+     * @param[in] Engine Valid engine handle.
+     * @return Pointer to the slot (cache-line aligned, zeroed on creation), or NULL if
+     *         no slot size was declared or allocation failed.
+     */
+    HYDRAHOOK_API PVOID HydraHookEngineGetThreadContext(
+        _In_
+        PHYDRAHOOK_ENGINE Engine
+    );
+
+    /**
+     * @brief Visits every per-thread context slot, e.g. to aggregate statistics.
+     *
+     * Slots of exited threads are kept and visited as well. Slot creation is
+     * blocked while the visitor runs; the owning threads may still write
+     * their slots concurrently, so read plain data with that in mind.
+     *
+     * @param[in] Engine Valid engine handle.
+     * @param[in] Visitor Callback invoked per slot.
+     * @param[in] UserData Passed through to Visitor.
+     * @retval HYDRAHOOK_ERROR_NONE Success.
+     * @retval HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE Engine is NULL.
+     * @retval HYDRAHOOK_ERROR_INVALID_PARAMETER Visitor is NULL.
+     */
+    HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineEnumerateThreadContexts(
+        _In_
+        PHYDRAHOOK_ENGINE Engine,
+        _In_
+        PFN_HYDRAHOOK_THREAD_CONTEXT_VISITOR Visitor,
+        _In_opt_
+        PVOID UserData
+    );
+
+    /**
+     * @brief Frees all per-thread context slots of the engine.
+     *
+     * Must not race with callbacks still using their slots; call after
+     * unhooking (e.g. in EvtHydraHookGamePostUnhook). Also done by
+     * HydraHookEngineDestroy.
+     *
+     * @param[in] Engine Valid engine handle.
+     * @retval HYDRAHOOK_ERROR_NONE Success.
+     * @retval HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE Engine is NULL.
+     */
+    HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineFreeThreadContexts(
+        _In_
+        PHYDRAHOOK_ENGINE Engine
+    );
+
+    /**
+     * @brief Allocates memory from HydraHook's private thread-caching allocator.
+     *
+     * Blocks up to 32 KiB come from per-thread size-class caches and never touch
+     * the process heap on the fast path, which avoids contending with the game's
+     * allocator on the render thread. Safe to call from any thread, including
+     * event callbacks. Not tied to an engine instance.
+     *
+     * @param[in] Size Size in bytes; zero returns a unique, freeable pointer.
+     * @return Pointer to uninitialized memory, or NULL on exhaustion.
+     */
+    HYDRAHOOK_API PVOID HydraHookAlloc(
+        _In_
+        size_t Size
+    );
+
+    /**
+     * @brief Frees memory obtained from HydraHookAlloc.
+     *
+     * May be called on a different thread than the allocating one.
+     *
+     * @param[in] Memory Block to free; NULL is ignored.
+     */
+    HYDRAHOOK_API VOID HydraHookFree(
+        _In_opt_
+        PVOID Memory
+    );
+
+    /**
+     * @brief Allocates memory from the private allocator and charges it to a tag.
+     *
+     * Accounting costs one per-thread counter update; free with HydraHookFree.
+     *
+     * @param[in] Tag Accounting tag (e.g. HydraHookMemoryTagHostUser0).
+     * @param[in] Size Size in bytes.
+     * @return Pointer to uninitialized memory, or NULL on exhaustion or invalid tag.
+     */
+    HYDRAHOOK_API PVOID HydraHookAllocTagged(
+        _In_
+        HYDRAHOOK_MEMORY_TAG Tag,
+        _In_
+        size_t Size
+    );
+
+    /**
+     * @brief Sets the tag charged by HydraHookAlloc (and HYDRAHOOK_DEFINE_OPERATOR_NEW) on the calling thread.
+     *
+     * Useful to attribute third-party allocations (e.g. via ImGui::SetAllocatorFunctions)
+     * to a host subsystem. Pass HydraHookMemoryTagCount to restore the default.
+     *
+     * @param[in] Tag New thread tag, or HydraHookMemoryTagCount to clear.
+     * @return Previous thread tag (HydraHookMemoryTagCount if none was set); pass it back to restore.
+     */
+    HYDRAHOOK_API HYDRAHOOK_MEMORY_TAG HydraHookSetThreadMemoryTag(
+        _In_
+        HYDRAHOOK_MEMORY_TAG Tag
+    );
+
+    /**
+     * @brief Sets or replaces the budget of a memory tag.
+     *
+     * Budgets are checked once per second on the engine thread, which also
+     * invokes the budget callbacks.
+     *
+     * @param[in] Engine Valid engine handle.
+     * @param[in] Tag Tag to configure.
+     * @param[in] Budget Budget settings; copied.
+     * @retval HYDRAHOOK_ERROR_NONE Success.
+     * @retval HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE Engine is NULL.
+     * @retval HYDRAHOOK_ERROR_INVALID_PARAMETER Tag is out of range or Budget is NULL.
+     */
+    HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineSetMemoryBudget(
+        _In_
+        PHYDRAHOOK_ENGINE Engine,
+        _In_
+        HYDRAHOOK_MEMORY_TAG Tag,
+        _In_
+        const HYDRAHOOK_MEMORY_BUDGET* Budget
+    );
+
+    /**
+     * @brief Retrieves current and peak usage of a memory tag.
+     * @param[in] Engine Valid engine handle.
+     * @param[in] Tag Tag to query.
+     * @param[out] Stats Receives the usage statistics.
+     * @retval HYDRAHOOK_ERROR_NONE Success.
+     * @retval HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE Engine is NULL.
+     * @retval HYDRAHOOK_ERROR_INVALID_PARAMETER Tag is out of range or Stats is NULL.
+     */
+    HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineGetMemoryStats(
+        _In_
+        PHYDRAHOOK_ENGINE Engine,
+        _In_
+        HYDRAHOOK_MEMORY_TAG Tag,
+        _Out_
+        PHYDRAHOOK_MEMORY_STATS Stats
+    );
+
+    /**
+     * @brief Returns the CPU time left for the currently executing callback.
+     *
+     * Call from inside an event callback to scale optional work (e.g. skip a
+     * pass when little budget remains). Outside a callback the full budget is
+     * returned.
+     *
+     * @param[in] Engine Valid engine handle.
+     * @return Remaining microseconds (negative once overrun), or MAXLONG if no budget is configured.
+     */
+    HYDRAHOOK_API LONG HydraHookEngineGetCallbackBudgetRemaining(
+        _In_
+        PHYDRAHOOK_ENGINE Engine
+    );
+
+    /**
+     * @brief Reports whether the currently executing callback should reduce its quality.
+     *
+     * TRUE when the moving average of the calling callback exceeds the
+     * configured budget, so hosts can degrade before throttling kicks in.
+     *
+     * @param[in] Engine Valid engine handle.
+     * @return TRUE to degrade; FALSE if within budget, no budget is set, or not called from a callback.
+     */
+    HYDRAHOOK_API BOOL HydraHookEngineShouldDegrade(
+        _In_
+        PHYDRAHOOK_ENGINE Engine
+    );
+
+    /**
+     * @brief Retrieves callback CPU budget counters.
+     * @param[in] Engine Valid engine handle.
+     * @param[out] Stats Receives the counters.
+     * @retval HYDRAHOOK_ERROR_NONE Success.
+     * @retval HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE Engine is NULL.
+     * @retval HYDRAHOOK_ERROR_INVALID_PARAMETER Stats is NULL.
+     */
+    HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineGetCallbackBudgetStats(
+        _In_
+        PHYDRAHOOK_ENGINE Engine,
+        _Out_
+        PHYDRAHOOK_CALLBACK_BUDGET_STATS Stats
+    );
+
 #ifndef HYDRAHOOK_NO_D3D9
 
     /**
@@ -498,4 +842,37 @@ BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID) \
 }
 #endif
 
+/**
+ * @brief Replaces global operator new/delete of the current module with HydraHookAlloc/HydraHookFree.
+ *
+ * Use this macro in exactly one translation unit of your hosting DLL to move its
+ * C++ allocations (STL containers, overlay state, etc.) off the process heap.
+ * Allocations are charged to HydraHookMemoryTagHost unless the thread tag was
+ * changed with HydraHookSetThreadMemoryTag.
+ * Because the CRT is linked statically, the replacement only affects the module
+ * that expands it, not the game. Requires <new> to be included before use.
+ * Over-aligned (align_val_t) overloads keep their CRT defaults.
+ */
+#define HYDRAHOOK_DEFINE_OPERATOR_NEW() \
+void* operator new(size_t size) \
+{ \
+    void* p = HydraHookAlloc(size); \
+    if (!p) throw std::bad_alloc(); \
+    return p; \
+} \
+void* operator new[](size_t size) \
+{ \
+    void* p = HydraHookAlloc(size); \
+    if (!p) throw std::bad_alloc(); \
+    return p; \
+} \
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return HydraHookAlloc(size); } \
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return HydraHookAlloc(size); } \
+void operator delete(void* p) noexcept { HydraHookFree(p); } \
+void operator delete[](void* p) noexcept { HydraHookFree(p); } \
+void operator delete(void* p, size_t) noexcept { HydraHookFree(p); } \
+void operator delete[](void* p, size_t) noexcept { HydraHookFree(p); } \
+void operator delete(void* p, const std::nothrow_t&) noexcept { HydraHookFree(p); } \
+void operator delete[](void* p, const std::nothrow_t&) noexcept { HydraHookFree(p); }
+
 #endif // HydraHookCore_h__
\ No newline at end of file
@@ -0,0 +1,458 @@
+/**
+ * @file HydraHookCpp.h
+ * @brief Header-only C++ binding layer over the HydraHook C callback API.
+ *
+ * Generates C-ABI callback thunks at compile time from member functions or
+ * captureless lambdas operating on a typed host context, so hosts no longer
+ * write free functions that cast Extension->Context. A thunk is a plain
+ * function pointer assigned straight into the *_EVENT_CALLBACKS structures;
+ * there is no std::function, no type erasure and no extra indirection.
+ *
+ * @code
+ * struct Overlay
+ * {
+ *     void OnPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags);
+ * };
+ *
+ * Overlay* overlay = nullptr;
+ * HydraHook::Cpp::CreateContext(EngineHandle, &overlay);
+ *
+ * d3d11.EvtHydraHookD3D11PrePresent = HydraHook::Cpp::Member<&Overlay::OnPresent>;
+ * @endcode
+ *
+ * Requires C++17; lambda binding requires C++20.
+ *
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef HydraHookCpp_h__
+#define HydraHookCpp_h__
+
+#include "HydraHookCore.h"
+
+#if defined(_MSVC_LANG)
+#define HYDRAHOOK_CPLUSPLUS _MSVC_LANG
+#else
+#define HYDRAHOOK_CPLUSPLUS __cplusplus
+#endif
+
+#if HYDRAHOOK_CPLUSPLUS < 201703L
+#error HydraHookCpp.h requires C++17 or newer
+#endif
+
+#include <functional>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace HydraHook
+{
+    namespace Cpp
+    {
+        namespace Detail
+        {
+            template <typename T>
+            struct IsExtension : std::false_type {};
+
+            template <>
+            struct IsExtension<PHYDRAHOOK_EVT_PRE_EXTENSION> : std::true_type {};
+
+            template <>
+            struct IsExtension<PHYDRAHOOK_EVT_POST_EXTENSION> : std::true_type {};
+
+            template <typename... A>
+            using LastOf = std::tuple_element_t<sizeof...(A) - 1, std::tuple<A...>>;
+
+            template <typename M>
+            struct MemberTraits;
+
+            template <typename T, typename R, typename... A>
+            struct MemberTraits<R (T::*)(A...)> { using Class = T; };
+
+            template <typename T, typename R, typename... A>
+            struct MemberTraits<R (T::*)(A...) noexcept> { using Class = T; };
+
+            template <typename T, typename R, typename... A>
+            struct MemberTraits<R (T::*)(A...) const> { using Class = const T; };
+
+            template <typename T, typename R, typename... A>
+            struct MemberTraits<R (T::*)(A...) const noexcept> { using Class = const T; };
+
+            template <typename F, typename Tuple, std::size_t... I>
+            FORCEINLINE decltype(auto) InvokePrefix(F&& f, Tuple&& args, std::index_sequence<I...>)
+            {
+                return std::invoke(std::forward<F>(f), std::get<I>(std::forward<Tuple>(args))...);
+            }
+
+            /**
+             * @brief Calls @p f with the context followed by all callback arguments,
+             *        or, if it does not accept them, all but the trailing extension.
+             */
+            template <typename R, typename F, typename Self, typename... A>
+            FORCEINLINE R Dispatch(F&& f, Self&& self, A... args)
+            {
+                if constexpr (std::is_invocable_v<F, Self, A...>)
+                {
+                    return static_cast<R>(std::invoke(std::forward<F>(f), std::forward<Self>(self), args...));
+                }
+                else
+                {
+                    static_assert(sizeof...(A) > 0 && IsExtension<LastOf<A...>>::value,
+                        "Bound callable does not match the callback signature");
+
+                    return static_cast<R>(InvokePrefix(std::forward<F>(f),
+                        std::forward_as_tuple(std::forward<Self>(self), args...),
+                        std::make_index_sequence<sizeof...(A)>{}));
+                }
+            }
+
+            /**
+             * @brief Returns the extension passed as the last callback argument.
+             */
+            template <typename... A>
+            FORCEINLINE LastOf<A...> ExtensionOf(A... args)
+            {
+                return std::get<sizeof...(A) - 1>(std::forward_as_tuple(args...));
+            }
+
+            template <typename R>
+            FORCEINLINE R Default()
+            {
+                if constexpr (!std::is_void_v<R>)
+                {
+                    return R{};
+                }
+            }
+        }
+
+        /**
+         * @brief Holder for the host object used by callbacks without an extension (D3D9, D3D10).
+         *
+         * Those callbacks do not receive the engine or its context, so the
+         * object is looked up per type. Set it before the callbacks are
+         * registered and clear it after unhooking.
+         */
+        template <typename T>
+        struct Instance
+        {
+            static inline T* Pointer = nullptr;
+
+            static void Set(T* Object) noexcept { Pointer = Object; }
+            static T* Get() noexcept { return Pointer; }
+        };
+
+        /**
+         * @brief Allocates the engine's custom context and constructs a @p T in it.
+         *
+         * Replaces HydraHookEngineAllocCustomContext followed by placement new.
+         * The object is reachable from callbacks via Extension->Context and the
+         * thunks below; destroy it with DestroyContext.
+         *
+         * @param[in] Engine Valid engine handle.
+         * @param[out] Context Receives the constructed object.
+         * @param[in] Args Constructor arguments.
+         * @retval HYDRAHOOK_ERROR_NONE Success.
+         * @retval HYDRAHOOK_ERROR_INVALID_PARAMETER Context is NULL.
+         * @retval HYDRAHOOK_ERROR_CONTEXT_ALLOCATION_FAILED Allocation failed.
+         */
+        template <typename T, typename... Args>
+        HYDRAHOOK_ERROR CreateContext(PHYDRAHOOK_ENGINE Engine, T** Context, Args&&... args)
+        {
+            static_assert(alignof(T) <= MEMORY_ALLOCATION_ALIGNMENT,
+                "Custom context type is over-aligned for the engine allocator");
+
+            if (!Context)
+            {
+                return HYDRAHOOK_ERROR_INVALID_PARAMETER;
+            }
+
+            *Context = nullptr;
+
+            PVOID memory = nullptr;
+            const auto error = HydraHookEngineAllocCustomContext(Engine, &memory, sizeof(T));
+            if (error != HYDRAHOOK_ERROR_NONE)
+            {
+                return error;
+            }
+
+            if (!memory)
+            {
+                return HYDRAHOOK_ERROR_CONTEXT_ALLOCATION_FAILED;
+            }
+
+            try
+            {
+                *Context = new(memory) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                (void)HydraHookEngineFreeCustomContext(Engine);
+                throw;
+            }
+
+            return HYDRAHOOK_ERROR_NONE;
+        }
+
+        /**
+         * @brief Returns the engine's custom context as @p T, or nullptr if none is allocated.
+         */
+        template <typename T>
+        T* GetContext(PHYDRAHOOK_ENGINE Engine) noexcept
+        {
+            return static_cast<T*>(HydraHookEngineGetCustomContext(Engine));
+        }
+
+        /**
+         * @brief Destroys the @p T created by CreateContext and frees the custom context.
+         *
+         * Call after unhooking (e.g. in EvtHydraHookGamePostUnhook) so no callback
+         * still uses the object.
+         */
+        template <typename T>
+        HYDRAHOOK_ERROR DestroyContext(PHYDRAHOOK_ENGINE Engine)
+        {
+            if (T* context = GetContext<T>(Engine))
+            {
+                context->~T();
+            }
+
+            return HydraHookEngineFreeCustomContext(Engine);
+        }
+
+        /**
+         * @brief Returns the calling thread's context slot as @p T (see HydraHookEngineGetThreadContext).
+         *
+         * Slots start zeroed and are never constructed or destroyed, so @p T
+         * must be trivial. Declare the slot size with
+         * HydraHookEngineAllocThreadContext(Engine, sizeof(T)) first.
+         */
+        template <typename T>
+        T* GetThreadContext(PHYDRAHOOK_ENGINE Engine) noexcept
+        {
+            static_assert(std::is_trivial_v<T>, "Thread context slots are zero-initialized raw memory");
+            static_assert(alignof(T) <= 64, "Thread context slots are cache-line aligned");
+
+            return static_cast<T*>(HydraHookEngineGetThreadContext(Engine));
+        }
+
+        /**
+         * @brief Compile-time thunk calling @p Method on the custom context.
+         *
+         * Converts to any callback pointer whose last parameter is a
+         * PHYDRAHOOK_EVT_PRE_EXTENSION or PHYDRAHOOK_EVT_POST_EXTENSION (D3D11,
+         * D3D12, Core Audio). The method takes the callback's arguments, with or
+         * without the trailing extension. The call is skipped while no context
+         * is allocated. The context must be the method's class, as created by
+         * CreateContext.
+         */
+        template <auto Method>
+        struct MemberThunk
+        {
+            using Class = typename Detail::MemberTraits<decltype(Method)>::Class;
+
+            template <typename R, typename... A>
+            using Callback = R(*)(A...);
+
+            template <typename R, typename... A>
+            static R Invoke(A... args)
+            {
+                static_assert(sizeof...(A) > 0 && Detail::IsExtension<Detail::LastOf<A...>>::value,
+                    "Callback has no extension; use StaticMember for D3D9/D3D10 callbacks");
+
+                const auto extension = Detail::ExtensionOf(args...);
+                if (!extension || !extension->Context)
+                {
+                    return Detail::Default<R>();
+                }
+
+                return Detail::Dispatch<R>(Method, static_cast<Class*>(extension->Context), args...);
+            }
+
+            template <typename R, typename... A>
+            constexpr operator Callback<R, A...>() const noexcept
+            {
+                return &Invoke<R, A...>;
+            }
+        };
+
+        /**
+         * @brief Compile-time thunk calling @p Method on Instance<Class>::Get().
+         *
+         * For callbacks without an extension (D3D9, D3D10, game hooked/unhooked).
+         * The call is skipped while no instance is set.
+         */
+        template <auto Method>
+        struct StaticMemberThunk
+        {
+            using Class = typename Detail::MemberTraits<decltype(Method)>::Class;
+
+            template <typename R, typename... A>
+            using Callback = R(*)(A...);
+
+            template <typename R, typename... A>
+            static R Invoke(A... args)
+            {
+                const auto self = Instance<std::remove_const_t<Class>>::Get();
+                if (!self)
+                {
+                    return Detail::Default<R>();
+                }
+
+                return Detail::Dispatch<R>(Method, static_cast<Class*>(self), args...);
+            }
+
+            template <typename R, typename... A>
+            constexpr operator Callback<R, A...>() const noexcept
+            {
+                return &Invoke<R, A...>;
+            }
+        };
+
+        /**
+         * @brief Member function thunk for callbacks with an extension.
+         *
+         * @code
+         * d3d11.EvtHydraHookD3D11PrePresent = HydraHook::Cpp::Member<&Overlay::OnPresent>;
+         * @endcode
+         */
+        template <auto Method>
+        inline constexpr MemberThunk<Method> Member{};
+
+        /**
+         * @brief Member function thunk dispatching to Instance<Class>::Get().
+         *
+         * @code
+         * HydraHook::Cpp::Instance<Overlay>::Set(&overlay);
+         * d3d9.EvtHydraHookD3D9PrePresent = HydraHook::Cpp::StaticMember<&Overlay::OnPresent>;
+         * @endcode
+         */
+        template <auto Method>
+        inline constexpr StaticMemberThunk<Method> StaticMember{};
+
+#if HYDRAHOOK_CPLUSPLUS >= 202002L
+
+        /**
+         * @brief Compile-time thunk calling a captureless lambda with the custom context.
+         *
+         * The lambda receives @p T& followed by the callback's arguments, with or
+         * without the trailing extension. Captureless lambdas are stateless, so
+         * the thunk default-constructs one per call at no cost.
+         */
+        template <typename T, typename F>
+        struct LambdaThunk
+        {
+            static_assert(std::is_empty_v<F> && std::is_default_constructible_v<F>,
+                "Only captureless lambdas can be bound; keep state in the context");
+
+            template <typename R, typename... A>
+            using Callback = R(*)(A...);
+
+            template <typename R, typename... A>
+            static R Invoke(A... args)
+            {
+                static_assert(sizeof...(A) > 0 && Detail::IsExtension<Detail::LastOf<A...>>::value,
+                    "Callback has no extension; use StaticLambda for D3D9/D3D10 callbacks");
+
+                const auto extension = Detail::ExtensionOf(args...);
+                if (!extension || !extension->Context)
+                {
+                    return Detail::Default<R>();
+                }
+
+                return Detail::Dispatch<R>(F{}, *static_cast<T*>(extension->Context), args...);
+            }
+
+            template <typename R, typename... A>
+            constexpr operator Callback<R, A...>() const noexcept
+            {
+                return &Invoke<R, A...>;
+            }
+        };
+
+        /**
+         * @brief Compile-time thunk calling a captureless lambda with Instance<T>::Get().
+         */
+        template <typename T, typename F>
+        struct StaticLambdaThunk
+        {
+            static_assert(std::is_empty_v<F> && std::is_default_constructible_v<F>,
+                "Only captureless lambdas can be bound; keep state in the instance");
+
+            template <typename R, typename... A>
+            using Callback = R(*)(A...);
+
+            template <typename R, typename... A>
+            static R Invoke(A... args)
+            {
+                const auto self = Instance<T>::Get();
+                if (!self)
+                {
+                    return Detail::Default<R>();
+                }
+
+                return Detail::Dispatch<R>(F{}, *self, args...);
+            }
+
+            template <typename R, typename... A>
+            constexpr operator Callback<R, A...>() const noexcept
+            {
+                return &Invoke<R, A...>;
+            }
+        };
+
+        /**
+         * @brief Binds a captureless lambda to the custom context of type @p T.
+         *
+         * @code
+         * d3d11.EvtHydraHookD3D11PrePresent = HydraHook::Cpp::Lambda<Overlay>(
+         *     [](Overlay& overlay, IDXGISwapChain* pSwapChain, UINT, UINT) { ... });
+         * @endcode
+         */
+        template <typename T, typename F>
+        constexpr LambdaThunk<T, F> Lambda(F) noexcept
+        {
+            return {};
+        }
+
+        /**
+         * @brief Binds a captureless lambda to Instance<T>::Get().
+         */
+        template <typename T, typename F>
+        constexpr StaticLambdaThunk<T, F> StaticLambda(F) noexcept
+        {
+            return {};
+        }
+
+#endif
+    }
+}
+
+#undef HYDRAHOOK_CPLUSPLUS
+
+#endif // HydraHookCpp_h__
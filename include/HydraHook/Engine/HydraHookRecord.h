@@ -0,0 +1,129 @@
+/**
+ * @file HydraHookRecord.h
+ * @brief On-disk format of hook call recordings.
+ *
+ * With EngineConfig.Recorder.IsEnabled, the engine appends one fixed-size
+ * HYDRAHOOK_RECORD per hooked call (site, thread, QPC timestamps and key
+ * arguments) to a binary file, so a session's exact call pattern can be
+ * analyzed or re-driven offline. The file is a HYDRAHOOK_RECORD_FILE_HEADER
+ * followed by records in the order they were flushed (roughly, but not
+ * strictly, chronological across threads; sort by Start to replay).
+ * All fields are little-endian.
+ *
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef HydraHookRecord_h__
+#define HydraHookRecord_h__
+
+#include <stdint.h>
+
+/** @brief File magic, "HHRC" in little-endian byte order. */
+#define HYDRAHOOK_RECORD_MAGIC      0x43524848
+
+/** @brief Current format version; bumped on incompatible changes. */
+#define HYDRAHOOK_RECORD_VERSION    1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Hook site that produced a record; determines the meaning of Args.
+     *
+     * Values are stable across versions; new sites are only appended.
+     */
+    typedef enum _HYDRAHOOK_RECORD_SITE
+    {
+        HydraHookRecordSiteDropped = 0,                 /**< Args[0] = records lost because the ring was full. */
+
+        HydraHookRecordSiteD3D9Present = 1,             /**< No arguments. */
+        HydraHookRecordSiteD3D9Reset = 2,               /**< Args = BackBufferWidth, BackBufferHeight, Windowed. */
+        HydraHookRecordSiteD3D9EndScene = 3,            /**< No arguments. */
+        HydraHookRecordSiteD3D9PresentEx = 4,           /**< Args[0] = dwFlags. */
+        HydraHookRecordSiteD3D9ResetEx = 5,             /**< Args = BackBufferWidth, BackBufferHeight, Windowed. */
+
+        HydraHookRecordSiteD3D10Present = 16,           /**< Args = SyncInterval, Flags. */
+        HydraHookRecordSiteD3D10ResizeTarget = 17,      /**< Args = Width, Height, RefreshRate.Numerator. */
+        HydraHookRecordSiteD3D10ResizeBuffers = 18,     /**< Args = BufferCount, Width, Height. */
+
+        HydraHookRecordSiteD3D11Present = 32,           /**< Args = SyncInterval, Flags. */
+        HydraHookRecordSiteD3D11ResizeTarget = 33,      /**< Args = Width, Height, RefreshRate.Numerator. */
+        HydraHookRecordSiteD3D11ResizeBuffers = 34,     /**< Args = BufferCount, Width, Height. */
+
+        HydraHookRecordSiteD3D12Present = 48,           /**< Args = SyncInterval, Flags. */
+        HydraHookRecordSiteD3D12ResizeTarget = 49,      /**< Args = Width, Height, RefreshRate.Numerator. */
+        HydraHookRecordSiteD3D12ResizeBuffers = 50,     /**< Args = BufferCount, Width, Height. */
+
+        HydraHookRecordSiteDXGIPresent1 = 64,           /**< Args = SyncInterval, PresentFlags, HYDRAHOOK_D3D_VERSION. */
+        HydraHookRecordSiteDXGIResizeBuffers1 = 65,     /**< Args = BufferCount, Width, Height. */
+
+        HydraHookRecordSiteARCGetBuffer = 80,           /**< Args[0] = NumFramesRequested. */
+        HydraHookRecordSiteARCReleaseBuffer = 81,       /**< Args = NumFramesWritten, dwFlags. */
+
+    } HYDRAHOOK_RECORD_SITE;
+
+    /**
+     * @brief Leading header of a recording file (32 bytes).
+     */
+    typedef struct _HYDRAHOOK_RECORD_FILE_HEADER
+    {
+        uint32_t Magic;             /**< HYDRAHOOK_RECORD_MAGIC. */
+        uint16_t Version;           /**< HYDRAHOOK_RECORD_VERSION. */
+        uint16_t RecordSize;        /**< sizeof(HYDRAHOOK_RECORD); readers skip unknown trailing fields. */
+        uint32_t ProcessId;         /**< Recorded process. */
+        uint32_t Reserved;          /**< Zero. */
+        int64_t QpcFrequency;       /**< QueryPerformanceFrequency at recording start. */
+        int64_t QpcBase;            /**< QueryPerformanceCounter at recording start; Start values are relative to it. */
+
+    } HYDRAHOOK_RECORD_FILE_HEADER, *PHYDRAHOOK_RECORD_FILE_HEADER;
+
+    /**
+     * @brief One hooked call (32 bytes).
+     *
+     * Start and Duration cover the whole hook: engine dispatch, host
+     * callbacks and the original function.
+     */
+    typedef struct _HYDRAHOOK_RECORD
+    {
+        uint64_t Start;             /**< QPC ticks since QpcBase at hook entry. */
+        uint32_t Duration;          /**< QPC ticks spent in the hook (saturates at UINT32_MAX). */
+        uint32_t ThreadId;          /**< Calling thread. */
+        uint16_t Site;              /**< HYDRAHOOK_RECORD_SITE. */
+        uint16_t Reserved;          /**< Zero. */
+        uint32_t Args[3];           /**< Site-specific arguments, see HYDRAHOOK_RECORD_SITE. */
+
+    } HYDRAHOOK_RECORD, *PHYDRAHOOK_RECORD;
+
+#ifdef __cplusplus
+    static_assert(sizeof(HYDRAHOOK_RECORD_FILE_HEADER) == 32, "Record file header layout changed");
+    static_assert(sizeof(HYDRAHOOK_RECORD) == 32, "Record layout changed");
+}
+#endif
+
+#endif // HydraHookRecord_h__
@@ -27,6 +27,7 @@ SOFTWARE.
 
 #include <HydraHook/Engine/HydraHookDirect3D11.h>
 #include <HydraHook/Engine/HydraHookCore.h>
+#include <HydraHook/Engine/HydraHookCpp.h>
 #include <cassert>
 #include <cmath>
 #include <cstdio>
@@ -57,10 +58,11 @@ typedef struct _DX11_TEXT_CTX
 	LARGE_INTEGER fpsLastFrameTime{};
 	double fpsSmoothed = 60.0;
 	bool fpsFirstFrame = true;
+
+	void PrePresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags);
 } DX11_TEXT_CTX, *PDX11_TEXT_CTX;
 
 EVT_HYDRAHOOK_GAME_HOOKED EvtHydraHookGameHooked;
-EVT_HYDRAHOOK_D3D11_PRE_PRESENT EvtHydraHookD3D11PrePresent;
 EVT_HYDRAHOOK_GAME_UNHOOKED EvtHydraHookGamePostUnhooked;
 
 static std::wstring GetFontPath()
@@ -162,24 +164,18 @@ void EvtHydraHookGameHooked(
 	PDX11_TEXT_CTX pCtx = nullptr;
 
 	//
-	// Allocate context memory
+	// Allocate and construct context (it has non-trivial members)
 	// 
-	if (HydraHookEngineAllocCustomContext(
-		EngineHandle,
-		(PVOID*)&pCtx,
-		sizeof(DX11_TEXT_CTX)
-	) != HYDRAHOOK_ERROR_NONE || !pCtx)
+	if (HydraHook::Cpp::CreateContext(EngineHandle, &pCtx) != HYDRAHOOK_ERROR_NONE)
 	{
 		HydraHookEngineLogError("Failed to allocate custom context for DirectXTK sample");
 		return;
 	}
 
-	// Placement new to construct the struct (it has non-trivial members)
-	new(pCtx) DX11_TEXT_CTX();
-
 	HYDRAHOOK_D3D11_EVENT_CALLBACKS d3d11;
 	HYDRAHOOK_D3D11_EVENT_CALLBACKS_INIT(&d3d11);
-	d3d11.EvtHydraHookD3D11PrePresent = EvtHydraHookD3D11PrePresent;
+	// Thunk generated at compile time, calls pCtx->PrePresent
+	d3d11.EvtHydraHookD3D11PrePresent = HydraHook::Cpp::Member<&DX11_TEXT_CTX::PrePresent>;
 
 	// Begin invoking render hook callbacks
 	HydraHookEngineSetD3D11EventCallbacks(EngineHandle, &d3d11);
@@ -190,25 +186,21 @@ void EvtHydraHookGameHooked(
 // 
 void EvtHydraHookGamePostUnhooked(PHYDRAHOOK_ENGINE EngineHandle)
 {
-	auto pCtx = PDX11_TEXT_CTX(HydraHookEngineGetCustomContext(EngineHandle));
-	if (pCtx)
-		pCtx->~DX11_TEXT_CTX();
+	(void)HydraHook::Cpp::DestroyContext<DX11_TEXT_CTX>(EngineHandle);
 }
 
 //
 // Present is about to get called
 // 
-void EvtHydraHookD3D11PrePresent(
+void DX11_TEXT_CTX::PrePresent(
 	IDXGISwapChain* pSwapChain,
 	UINT SyncInterval,
-	UINT Flags,
-	PHYDRAHOOK_EVT_PRE_EXTENSION Extension
+	UINT Flags
 )
 {
 	UNREFERENCED_PARAMETER(SyncInterval);
 	UNREFERENCED_PARAMETER(Flags);
 
-	const auto pCtx = PDX11_TEXT_CTX(Extension->Context);
 	ID3D11Device* pDeviceTmp = nullptr;
 
 	if (FAILED(D3D11_DEVICE_FROM_SWAPCHAIN(pSwapChain, &pDeviceTmp)))
@@ -223,17 +215,17 @@ void EvtHydraHookD3D11PrePresent(
 	 * does when switching cores) so compare to ones grabbed earlier and
 	 * re-request both if necessary.
 	 */
-	bool devChanged = (pCtx->dev != pDeviceTmp);
+	bool devChanged = (dev != pDeviceTmp);
 	if (devChanged)
 	{
-		pCtx->spriteBatch.reset();
-		pCtx->spriteFont.reset();
-		pCtx->commonStates.reset();
+		spriteBatch.reset();
+		spriteFont.reset();
+		commonStates.reset();
 
 		D3D11_DEVICE_IMMEDIATE_CONTEXT_FROM_SWAPCHAIN(
 			pSwapChain,
-			&pCtx->dev,
-			&pCtx->ctx
+			&dev,
+			&ctx
 		);
 
 		const std::wstring fontPath = GetFontPath();
@@ -247,9 +239,9 @@ void EvtHydraHookD3D11PrePresent(
 
 		try
 		{
-			pCtx->commonStates = std::make_unique<CommonStates>(pCtx->dev);
-			pCtx->spriteBatch = std::make_unique<SpriteBatch>(pCtx->ctx);
-			pCtx->spriteFont = std::make_unique<SpriteFont>(pCtx->dev, fontPath.c_str());
+			commonStates = std::make_unique<CommonStates>(dev);
+			spriteBatch = std::make_unique<SpriteBatch>(ctx);
+			spriteFont = std::make_unique<SpriteFont>(dev, fontPath.c_str());
 		}
 		catch (const std::exception& e)
 		{
@@ -276,45 +268,45 @@ void EvtHydraHookD3D11PrePresent(
 	}
 
 	ID3D11RenderTargetView* pRTV = nullptr;
-	HRESULT hr = pCtx->dev->CreateRenderTargetView(pBackBuffer, nullptr, &pRTV);
+	HRESULT hr = dev->CreateRenderTargetView(pBackBuffer, nullptr, &pRTV);
 	pBackBuffer->Release();
 	if (FAILED(hr) || !pRTV)
 		return;
 
-	pCtx->ctx->OMSetRenderTargets(1, &pRTV, nullptr);
+	ctx->OMSetRenderTargets(1, &pRTV, nullptr);
 
 	D3D11_VIEWPORT vp{};
 	vp.Width = (float)bbDesc.Width;
 	vp.Height = (float)bbDesc.Height;
 	vp.MinDepth = 0.f;
 	vp.MaxDepth = 1.f;
-	pCtx->ctx->RSSetViewports(1, &vp);
+	ctx->RSSetViewports(1, &vp);
 
 	const float viewportWidth = static_cast<float>(bbDesc.Width);
 
-	if (pCtx->fpsFirstFrame)
+	if (fpsFirstFrame)
 	{
-		pCtx->marqueeStartTime = qpcNow;
-		pCtx->fpsLastFrameTime = qpcNow;
-		pCtx->fpsFirstFrame = false;
+		marqueeStartTime = qpcNow;
+		fpsLastFrameTime = qpcNow;
+		fpsFirstFrame = false;
 	}
 
 	try
 	{
-		pCtx->spriteBatch->Begin(SpriteSortMode_Deferred, pCtx->commonStates->AlphaBlend());
+		spriteBatch->Begin(SpriteSortMode_Deferred, commonStates->AlphaBlend());
 
 		// Marquee: time-based scroll, FPS-independent
 		{
 			const wchar_t* marqueeText = L"Injected via HydraHook by Nefarius";
-			XMVECTOR textSize = pCtx->spriteFont->MeasureString(marqueeText);
+			XMVECTOR textSize = spriteFont->MeasureString(marqueeText);
 			const float textWidth = XMVectorGetX(textSize);
-			const double elapsedSec = static_cast<double>(qpcNow.QuadPart - pCtx->marqueeStartTime.QuadPart) / static_cast<double>(qpcFreq.QuadPart);
+			const double elapsedSec = static_cast<double>(qpcNow.QuadPart - marqueeStartTime.QuadPart) / static_cast<double>(qpcFreq.QuadPart);
 			const float cycleLength = viewportWidth + textWidth;
 			const float offset = static_cast<float>(std::fmod(elapsedSec * MARQUEE_SPEED_PX_PER_SEC, cycleLength));
 			const float marqueeX = viewportWidth - offset;
 
-			pCtx->spriteFont->DrawString(
-				pCtx->spriteBatch.get(),
+			spriteFont->DrawString(
+				spriteBatch.get(),
 				marqueeText,
 				XMFLOAT2(marqueeX, MARQUEE_Y),
 				Colors::DeepPink,
@@ -326,21 +318,21 @@ void EvtHydraHookD3D11PrePresent(
 
 		// FPS counter: top-right corner
 		{
-			const double deltaSec = static_cast<double>(qpcNow.QuadPart - pCtx->fpsLastFrameTime.QuadPart) / static_cast<double>(qpcFreq.QuadPart);
+			const double deltaSec = static_cast<double>(qpcNow.QuadPart - fpsLastFrameTime.QuadPart) / static_cast<double>(qpcFreq.QuadPart);
 			if (deltaSec > 0.0)
 			{
 				const double instantFps = 1.0 / deltaSec;
-				pCtx->fpsSmoothed = pCtx->fpsSmoothed * (1.0 - FPS_SMOOTH_ALPHA) + instantFps * FPS_SMOOTH_ALPHA;
+				fpsSmoothed = fpsSmoothed * (1.0 - FPS_SMOOTH_ALPHA) + instantFps * FPS_SMOOTH_ALPHA;
 			}
 
 			wchar_t fpsBuf[32];
-			swprintf_s(fpsBuf, static_cast<size_t>(sizeof(fpsBuf) / sizeof(wchar_t)), L"FPS: %.1f", pCtx->fpsSmoothed);
-			XMVECTOR fpsTextSize = pCtx->spriteFont->MeasureString(fpsBuf);
+			swprintf_s(fpsBuf, static_cast<size_t>(sizeof(fpsBuf) / sizeof(wchar_t)), L"FPS: %.1f", fpsSmoothed);
+			XMVECTOR fpsTextSize = spriteFont->MeasureString(fpsBuf);
 			const float fpsTextWidth = XMVectorGetX(fpsTextSize);
 			const float fpsX = viewportWidth - FPS_MARGIN - fpsTextWidth;
 
-			pCtx->spriteFont->DrawString(
-				pCtx->spriteBatch.get(),
+			spriteFont->DrawString(
+				spriteBatch.get(),
 				fpsBuf,
 				XMFLOAT2(fpsX, FPS_MARGIN),
 				Colors::White,
@@ -350,8 +342,8 @@ void EvtHydraHookD3D11PrePresent(
 			);
 		}
 
-		pCtx->fpsLastFrameTime = qpcNow;
-		pCtx->spriteBatch->End();
+		fpsLastFrameTime = qpcNow;
+		spriteBatch->End();
 	}
 	catch (const std::exception& e)
 	{
@@ -0,0 +1,483 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "FontCache.h"
+#include "dllmain.h"
+
+// 
+// STL
+// 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 
+// ImGui includes
+// 
+#include <imgui.h>
+
+#define FONT_CACHE_MAGIC 0x43464848 /* "HHFC" */
+#define FONT_CACHE_VERSION 1
+
+/**
+ * @brief Read-only file view; the whole file is mapped with one MapViewOfFile call.
+ */
+struct MappedFile
+{
+	HANDLE File = INVALID_HANDLE_VALUE;
+	HANDLE Mapping = nullptr;
+	const uint8_t* View = nullptr;
+	size_t Size = 0;
+
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile() { Close(); }
+
+	bool Open(const std::string& path)
+	{
+		File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		                   FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (File == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(File, &size) || size.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+
+		Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (Mapping)
+			View = static_cast<const uint8_t*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+
+		if (!View)
+		{
+			Close();
+			return false;
+		}
+
+		Size = static_cast<size_t>(size.QuadPart);
+		return true;
+	}
+
+	void Close()
+	{
+		if (View) { UnmapViewOfFile(View); View = nullptr; }
+		if (Mapping) { CloseHandle(Mapping); Mapping = nullptr; }
+		if (File != INVALID_HANDLE_VALUE) { CloseHandle(File); File = INVALID_HANDLE_VALUE; }
+		Size = 0;
+	}
+};
+
+/**
+ * @brief Result of the font worker, handed to the render thread by FontCache_Apply.
+ */
+struct FontCachePending
+{
+	MappedFile Cache;			/**< Cache hit: the mapped cache file. */
+	std::vector<uint8_t> Built;	/**< Cache miss: the atlas the worker built, in cache file layout. */
+	void* FontData = nullptr;	/**< ImGui 1.92+: font file contents (IM_ALLOC, owned by the atlas once applied). */
+	int FontDataSize = 0;
+
+	~FontCachePending()
+	{
+		if (FontData)
+			IM_FREE(FontData);
+	}
+};
+
+static std::string g_fontPath;
+static float g_fontSize = 0.0f;
+static const ImWchar* g_glyphRanges = nullptr;
+static std::thread* g_fontThread = nullptr;
+static std::atomic<bool> g_fontReady{ false };
+static FontCachePending* g_fontPending = nullptr;
+
+#if IMGUI_VERSION_NUM < 19200
+
+/*
+ * Cache file layout: FontCacheHeader, GlyphCount FontCacheGlyph entries,
+ * TexWidth * TexHeight alpha8 pixels.
+ */
+struct FontCacheHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t Key;
+	int32_t TexWidth;
+	int32_t TexHeight;
+	uint32_t GlyphCount;
+	float FontSize;
+	float Ascent;
+	float Descent;
+	ImVec2 TexUvWhitePixel;
+	ImVec4 TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct FontCacheGlyph
+{
+	uint32_t Codepoint;
+	float AdvanceX;
+	float X0, Y0, X1, Y1;
+	float U0, V0, U1, V1;
+};
+
+static uint64_t FontCache_Hash(uint64_t hash, const void* data, size_t size)
+{
+	// FNV-1a
+	const auto bytes = static_cast<const uint8_t*>(data);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001B3ULL;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Cache key: font file contents, pixel size, glyph ranges and the ImGui version.
+ */
+static uint64_t FontCache_Key(const MappedFile& font)
+{
+	uint64_t key = 0xCBF29CE484222325ULL;
+	const int version = IMGUI_VERSION_NUM;
+
+	key = FontCache_Hash(key, font.View, font.Size);
+	key = FontCache_Hash(key, &g_fontSize, sizeof(g_fontSize));
+	key = FontCache_Hash(key, &version, sizeof(version));
+
+	for (const ImWchar* range = g_glyphRanges; range && *range; range++)
+		key = FontCache_Hash(key, range, sizeof(*range));
+
+	return key;
+}
+
+static std::string FontCache_Path(uint64_t key)
+{
+	char temp[MAX_PATH];
+	if (!GetTempPathA(MAX_PATH, temp))
+		return {};
+
+	char name[64];
+	sprintf_s(name, "HydraHook-ImGui-%016llx.fontcache", static_cast<unsigned long long>(key));
+
+	return std::string(temp) + name;
+}
+
+static bool FontCache_Validate(const MappedFile& cache, uint64_t key)
+{
+	if (cache.Size < sizeof(FontCacheHeader))
+		return false;
+
+	FontCacheHeader header;
+	memcpy(&header, cache.View, sizeof(header));
+
+	return header.Magic == FONT_CACHE_MAGIC
+		&& header.Version == FONT_CACHE_VERSION
+		&& header.Key == key
+		&& header.TexWidth > 0 && header.TexHeight > 0
+		&& cache.Size == sizeof(FontCacheHeader)
+		+ static_cast<size_t>(header.GlyphCount) * sizeof(FontCacheGlyph)
+		+ static_cast<size_t>(header.TexWidth) * static_cast<size_t>(header.TexHeight);
+}
+
+/**
+ * @brief Rasterizes the font into a private atlas and serializes it in cache file layout.
+ */
+static bool FontCache_Build(const MappedFile& font, uint64_t key, std::vector<uint8_t>& out)
+{
+	ImFontAtlas atlas;
+
+	ImFontConfig config;
+	config.FontDataOwnedByAtlas = false; // the mapping outlives the atlas
+
+	const ImFont* built = atlas.AddFontFromMemoryTTF(const_cast<uint8_t*>(font.View), static_cast<int>(font.Size),
+	                                                 g_fontSize, &config, g_glyphRanges);
+
+	if (!built || !atlas.Build())
+		return false;
+
+	unsigned char* pixels;
+	int width, height;
+	atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+
+	FontCacheHeader header = {};
+	header.Magic = FONT_CACHE_MAGIC;
+	header.Version = FONT_CACHE_VERSION;
+	header.Key = key;
+	header.TexWidth = width;
+	header.TexHeight = height;
+	header.GlyphCount = static_cast<uint32_t>(built->Glyphs.Size);
+	header.FontSize = built->FontSize;
+	header.Ascent = built->Ascent;
+	header.Descent = built->Descent;
+	header.TexUvWhitePixel = atlas.TexUvWhitePixel;
+	memcpy(header.TexUvLines, atlas.TexUvLines, sizeof(header.TexUvLines));
+
+	out.resize(sizeof(header) + header.GlyphCount * sizeof(FontCacheGlyph) + static_cast<size_t>(width) * height);
+	memcpy(out.data(), &header, sizeof(header));
+
+	auto glyphs = reinterpret_cast<FontCacheGlyph*>(out.data() + sizeof(header));
+
+	for (const ImFontGlyph& glyph : built->Glyphs)
+	{
+		*glyphs++ = {
+			glyph.Codepoint, glyph.AdvanceX,
+			glyph.X0, glyph.Y0, glyph.X1, glyph.Y1,
+			glyph.U0, glyph.V0, glyph.U1, glyph.V1
+		};
+	}
+
+	memcpy(glyphs, pixels, static_cast<size_t>(width) * height);
+
+	return true;
+}
+
+/**
+ * @brief Writes the cache next to a temporary name first so readers never see a partial file.
+ */
+static void FontCache_Write(const std::string& path, const std::vector<uint8_t>& data)
+{
+	const auto temporary = path + ".tmp";
+
+	const HANDLE file = CreateFileA(temporary.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+	                                FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	DWORD written = 0;
+	const BOOL ok = WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr);
+	CloseHandle(file);
+
+	if (!ok || written != data.size()
+		|| !MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+	{
+		DeleteFileA(temporary.c_str());
+		HydraHookEngineLogWarning("Couldn't write font cache %s", path.c_str());
+	}
+}
+
+/**
+ * @brief Replaces the fonts of the given atlas with the cached font; no rasterization happens.
+ */
+static void FontCache_Restore(ImFontAtlas* atlas, const uint8_t* data)
+{
+	FontCacheHeader header;
+	memcpy(&header, data, sizeof(header));
+
+	const auto glyphs = reinterpret_cast<const FontCacheGlyph*>(data + sizeof(header));
+	const auto pixels = reinterpret_cast<const uint8_t*>(glyphs + header.GlyphCount);
+	const auto pixelCount = static_cast<size_t>(header.TexWidth) * header.TexHeight;
+
+	atlas->Clear();
+
+	ImFont* font = IM_NEW(ImFont)();
+	font->FontSize = header.FontSize;
+	font->Ascent = header.Ascent;
+	font->Descent = header.Descent;
+	font->ContainerAtlas = atlas;
+	atlas->Fonts.push_back(font);
+
+	//
+	// Glyph lookup (ellipsis, fallback) reads the font's config; it carries no font data
+	// 
+	ImFontConfig config;
+	config.FontDataOwnedByAtlas = false;
+	config.SizePixels = header.FontSize;
+	config.DstFont = font;
+	strcpy_s(config.Name, "Font cache");
+	atlas->ConfigData.push_back(config);
+
+	font->ConfigData = &atlas->ConfigData.back();
+	font->ConfigDataCount = 1;
+
+	for (uint32_t i = 0; i < header.GlyphCount; i++)
+	{
+		const auto& glyph = glyphs[i];
+
+		font->AddGlyph(nullptr, static_cast<ImWchar>(glyph.Codepoint),
+		               glyph.X0, glyph.Y0, glyph.X1, glyph.Y1,
+		               glyph.U0, glyph.V0, glyph.U1, glyph.V1,
+		               glyph.AdvanceX);
+	}
+
+	font->BuildLookupTable();
+
+	atlas->TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(pixelCount));
+	memcpy(atlas->TexPixelsAlpha8, pixels, pixelCount);
+	atlas->TexWidth = header.TexWidth;
+	atlas->TexHeight = header.TexHeight;
+	atlas->TexUvScale = ImVec2(1.0f / header.TexWidth, 1.0f / header.TexHeight);
+	atlas->TexUvWhitePixel = header.TexUvWhitePixel;
+	memcpy(atlas->TexUvLines, header.TexUvLines, sizeof(header.TexUvLines));
+	atlas->TexReady = true;
+}
+
+#endif
+
+/**
+ * @brief Loads the cache or builds the atlas; never touches the ImGui context.
+ */
+static void FontCache_WorkerThreadProc()
+{
+	MappedFile font;
+	if (!font.Open(g_fontPath))
+	{
+		HydraHookEngineLogError("Couldn't open font %s, keeping the default font", g_fontPath.c_str());
+		return;
+	}
+
+	auto pending = std::make_unique<FontCachePending>();
+
+#if IMGUI_VERSION_NUM >= 19200
+	//
+	// ImGui 1.92+ rasterizes glyphs on demand into a dynamic atlas, so there is no
+	// prebuilt atlas to cache; only reading the font file moves off the render thread
+	// 
+	pending->FontData = IM_ALLOC(font.Size);
+	pending->FontDataSize = static_cast<int>(font.Size);
+	memcpy(pending->FontData, font.View, font.Size);
+#else
+	const uint64_t key = FontCache_Key(font);
+	const auto cachePath = FontCache_Path(key);
+
+	if (!cachePath.empty() && pending->Cache.Open(cachePath) && FontCache_Validate(pending->Cache, key))
+	{
+		HydraHookEngineLogInfo("Font cache hit (%s)", cachePath.c_str());
+	}
+	else
+	{
+		pending->Cache.Close();
+
+		if (!FontCache_Build(font, key, pending->Built))
+		{
+			HydraHookEngineLogError("Couldn't build font atlas for %s, keeping the default font", g_fontPath.c_str());
+			return;
+		}
+
+		if (!cachePath.empty())
+			FontCache_Write(cachePath, pending->Built);
+
+		HydraHookEngineLogInfo("Font cache miss, atlas built on worker thread");
+	}
+#endif
+
+	g_fontPending = pending.release();
+	g_fontReady.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Starts loading the overlay font in the background.
+ *
+ * The overlay keeps using ImGui's default font until FontCache_Apply installs the
+ * loaded one, so the first Present never waits for rasterization.
+ *
+ * @param fontPath TTF/TTC path; environment variables are expanded.
+ * @param sizePixels Font size in pixels.
+ * @param glyphRanges Zero-terminated glyph ranges (must stay valid, e.g. a GetGlyphRanges* result).
+ */
+void FontCache_Start(const char* fontPath, float sizePixels, const ImWchar* glyphRanges)
+{
+	if (g_fontThread)
+		return;
+
+	char expanded[MAX_PATH];
+	const DWORD length = ExpandEnvironmentStringsA(fontPath, expanded, MAX_PATH);
+
+	g_fontPath = length && length <= MAX_PATH ? expanded : fontPath;
+	g_fontSize = sizePixels;
+	g_glyphRanges = glyphRanges;
+	g_fontReady = false;
+
+	g_fontThread = new std::thread(FontCache_WorkerThreadProc);
+}
+
+/**
+ * @brief Whether a loaded font waits for FontCache_Apply.
+ */
+bool FontCache_IsReady()
+{
+	return g_fontReady.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Installs the loaded font as the default font of the current ImGui context.
+ *
+ * Call on the render thread between frames, while no other thread uses the context.
+ *
+ * @return true if the atlas texture changed and the backend's device objects must be recreated.
+ */
+bool FontCache_Apply()
+{
+	if (!g_fontReady.exchange(false, std::memory_order_acquire))
+		return false;
+
+	const std::unique_ptr<FontCachePending> pending(g_fontPending);
+	g_fontPending = nullptr;
+
+	ImGuiIO& io = ImGui::GetIO();
+
+#if IMGUI_VERSION_NUM >= 19200
+	ImFontConfig config;
+	io.FontDefault = io.Fonts->AddFontFromMemoryTTF(pending->FontData, pending->FontDataSize, g_fontSize, &config,
+	                                                g_glyphRanges);
+	pending->FontData = nullptr; // owned by the atlas now
+
+	return false;
+#else
+	FontCache_Restore(io.Fonts, pending->Cache.View ? pending->Cache.View : pending->Built.data());
+	io.FontDefault = io.Fonts->Fonts[0];
+
+	return true;
+#endif
+}
+
+/**
+ * @brief Waits for the font worker and drops a font that was never applied.
+ */
+void FontCache_Shutdown()
+{
+	if (g_fontThread)
+	{
+		if (g_fontThread->joinable())
+			g_fontThread->join();
+		delete g_fontThread;
+		g_fontThread = nullptr;
+	}
+
+	g_fontReady = false;
+	delete g_fontPending;
+	g_fontPending = nullptr;
+}
@@ -0,0 +1,41 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <imgui.h>
+
+/**
+ * @brief Font used by the overlay (environment variables are expanded).
+ *
+ * For CJK text point this at e.g. %WINDIR%\Fonts\msyh.ttc and pass
+ * GetGlyphRangesChineseFull() to FontCache_Start; the cache pays off most there.
+ */
+#define OVERLAY_FONT_PATH "%WINDIR%\\Fonts\\segoeui.ttf"
+#define OVERLAY_FONT_SIZE 18.0f
+
+void FontCache_Start(const char* fontPath, float sizePixels, const ImWchar* glyphRanges);
+bool FontCache_IsReady();
+bool FontCache_Apply();
+void FontCache_Shutdown();
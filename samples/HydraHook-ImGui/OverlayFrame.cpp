@@ -0,0 +1,559 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "OverlayFrame.h"
+#include "FontCache.h"
+#include "dllmain.h"
+
+// 
+// STL
+// 
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+// 
+// ImGui includes
+// 
+#include <imgui.h>
+#include <imgui_impl_win32.h>
+
+/**
+ * @brief Length of one benchmark window in seconds.
+ */
+#define OVERLAY_BENCHMARK_WINDOW_SECONDS 5
+
+/**
+ * @brief Capacity of the window message queue feeding the worker (power of two).
+ */
+#define OVERLAY_INPUT_QUEUE_SIZE 256
+
+/**
+ * @brief Set in g_ready when the worker published a buffer the render thread hasn't taken yet.
+ */
+#define OVERLAY_BUFFER_FRESH 0x4
+#define OVERLAY_BUFFER_INDEX 0x3
+
+/**
+ * @brief Persistent copy of ImDrawData that can be replayed through any backend.
+ *
+ * The draw lists are allocated once and their buffers only ever grow, so a
+ * capture in steady state is three memcpy calls per list and no allocation.
+ */
+struct DrawDataSnapshot
+{
+	ImDrawData Data;
+	ImVector<ImDrawList*> Lists;
+	bool Valid = false;
+
+	template <typename T>
+	static void CopyVector(ImVector<T>& destination, const ImVector<T>& source)
+	{
+		// ImVector::operator= frees before copying, resize() keeps the capacity
+		destination.resize(source.Size);
+		if (source.Size)
+			memcpy(destination.Data, source.Data, source.size_in_bytes());
+	}
+
+	void Capture(const ImDrawData* source)
+	{
+		while (Lists.Size < source->CmdListsCount)
+			Lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+
+		Data.CmdLists.resize(0);
+
+		for (int i = 0; i < source->CmdListsCount; i++)
+		{
+			const ImDrawList* from = source->CmdLists[i];
+			ImDrawList* to = Lists[i];
+
+			CopyVector(to->CmdBuffer, from->CmdBuffer);
+			CopyVector(to->IdxBuffer, from->IdxBuffer);
+			CopyVector(to->VtxBuffer, from->VtxBuffer);
+			to->Flags = from->Flags;
+
+			Data.CmdLists.push_back(to);
+		}
+
+		Data.Valid = source->Valid;
+		Data.CmdListsCount = source->CmdListsCount;
+		Data.TotalIdxCount = source->TotalIdxCount;
+		Data.TotalVtxCount = source->TotalVtxCount;
+		Data.DisplayPos = source->DisplayPos;
+		Data.DisplaySize = source->DisplaySize;
+		Data.FramebufferScale = source->FramebufferScale;
+		Data.OwnerViewport = source->OwnerViewport;
+#if IMGUI_VERSION_NUM >= 19200
+		// Texture updates are consumed by the backend when the live frame is submitted,
+		// the worker hands them over explicitly (see OverlayFrame_Publish)
+		Data.Textures = nullptr;
+#endif
+
+		Valid = true;
+	}
+
+	void Clear()
+	{
+		for (ImDrawList* list : Lists)
+			IM_DELETE(list);
+
+		Lists.clear();
+		Data.Clear();
+		Valid = false;
+	}
+};
+
+static DrawDataSnapshot g_snapshot;
+static OverlayUpdateMode g_mode = OverlayUpdateThrottled;
+static ImDrawData g_emptyDrawData;
+static std::atomic<bool> g_invalidated{ true };
+static POINT g_lastCursor = {};
+static LONGLONG g_frequency = 0;
+static LONGLONG g_lastBuild = 0;
+static LONGLONG g_frameStart = 0;
+
+/* Benchmark window */
+static LONGLONG g_benchWindowStart = 0;
+static LONGLONG g_benchTicks = 0;
+static UINT g_benchFrames = 0;
+static UINT g_benchRebuilds = 0;
+
+/* Worker mode: triple buffer, the worker owns g_back, the render thread g_front */
+static DrawDataSnapshot g_buffers[3];
+static std::atomic<int> g_ready{ 0 };
+static int g_back = 1;
+static int g_front = 2;
+static std::atomic<bool> g_textureHandoff{ false };
+static std::atomic<UINT> g_workerBuilds{ 0 };
+static std::atomic<bool> g_workerRunning{ false };
+static std::thread* g_workerThread = nullptr;
+static HANDLE g_workerWake = nullptr;
+
+/*
+ * Window messages for the worker; single consumer (worker), but DefWindowProc is hooked
+ * process-wide, so any thread may produce: producers serialize on g_inputLock.
+ * g_inputQueued (guarded by g_inputLock) is set before the worker starts and cleared only
+ * after it was joined, so messages are never handled directly while the worker may run.
+ */
+struct OverlayInputMessage
+{
+	HWND hWnd;
+	UINT Msg;
+	WPARAM wParam;
+	LPARAM lParam;
+};
+
+static OverlayInputMessage g_inputQueue[OVERLAY_INPUT_QUEUE_SIZE];
+static std::atomic<UINT> g_inputHead{ 0 };
+static std::atomic<UINT> g_inputTail{ 0 };
+static SRWLOCK g_inputLock = SRWLOCK_INIT;
+static bool g_inputQueued = false;
+/* Set while this thread handles a message directly under g_inputLock (the handler may re-enter) */
+static thread_local bool t_inputHandling = false;
+
+static const char* OverlayUpdateModeName(OverlayUpdateMode mode)
+{
+	switch (mode)
+	{
+	case OverlayUpdateThrottled: return "throttled";
+	case OverlayUpdateWorker:    return "worker";
+	default:                     return "every_frame";
+	}
+}
+
+static bool OverlayFrame_IsInputMessage(UINT Msg)
+{
+	return (Msg >= WM_MOUSEFIRST && Msg <= WM_MOUSELAST) || (Msg >= WM_KEYFIRST && Msg <= WM_KEYLAST);
+}
+
+/**
+ * @brief Feeds queued window messages to the Win32 backend; runs on the worker only.
+ */
+static void OverlayFrame_DrainInput()
+{
+	const UINT head = g_inputHead.load(std::memory_order_acquire);
+	UINT tail = g_inputTail.load(std::memory_order_relaxed);
+
+	for (; tail != head; tail++)
+	{
+		const auto& message = g_inputQueue[tail & (OVERLAY_INPUT_QUEUE_SIZE - 1)];
+		ImGui_ImplWin32_WndProcHandler(message.hWnd, message.Msg, message.wParam, message.lParam);
+	}
+
+	g_inputTail.store(tail, std::memory_order_release);
+}
+
+/**
+ * @brief Copies the built frame into the back buffer and swaps it with the ready slot.
+ *
+ * With ImGui 1.92+ texture updates (atlas creation, new glyphs) must be processed by
+ * the render thread's backend; a frame carrying them keeps the texture list and the
+ * worker pauses until the render thread submitted it, so both never touch a texture
+ * at the same time.
+ */
+static void OverlayFrame_Publish(ImDrawData* drawData)
+{
+	DrawDataSnapshot& back = g_buffers[g_back];
+	back.Capture(drawData);
+
+#if IMGUI_VERSION_NUM >= 19200
+	if (drawData->Textures)
+	{
+		for (ImTextureData* texture : *drawData->Textures)
+		{
+			if (texture->Status != ImTextureStatus_OK)
+			{
+				back.Data.Textures = drawData->Textures;
+				g_textureHandoff = true;
+				break;
+			}
+		}
+	}
+#endif
+
+	g_back = g_ready.exchange(g_back | OVERLAY_BUFFER_FRESH, std::memory_order_acq_rel) & OVERLAY_BUFFER_INDEX;
+}
+
+/**
+ * @brief Builds frames at OVERLAY_UPDATE_RATE_HZ, or right away when woken by input.
+ *
+ * Owns the ImGui context while running: input, Win32 NewFrame, NewFrame, RenderScene and Render.
+ */
+static void OverlayFrame_WorkerThreadProc()
+{
+	while (g_workerRunning)
+	{
+		WaitForSingleObject(g_workerWake, 1000 / OVERLAY_UPDATE_RATE_HZ);
+
+		if (!g_workerRunning)
+			break;
+
+		if (g_textureHandoff)
+			continue;
+
+		OverlayFrame_DrainInput();
+
+		ImGui_ImplWin32_NewFrame();
+		ImGui::NewFrame();
+
+		RenderScene();
+
+		OverlayFrame_Publish(ImGui::GetDrawData());
+		g_workerBuilds++;
+	}
+}
+
+static void OverlayFrame_StartWorker()
+{
+	if (g_workerThread)
+		return;
+
+	if (!g_workerWake)
+		g_workerWake = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+	AcquireSRWLockExclusive(&g_inputLock);
+	g_inputQueued = true;
+	ReleaseSRWLockExclusive(&g_inputLock);
+
+	g_workerRunning = true;
+	g_workerThread = new std::thread(OverlayFrame_WorkerThreadProc);
+}
+
+static void OverlayFrame_StopWorker()
+{
+	if (!g_workerThread)
+		return;
+
+	g_workerRunning = false;
+	SetEvent(g_workerWake);
+
+	if (g_workerThread->joinable())
+		g_workerThread->join();
+	delete g_workerThread;
+	g_workerThread = nullptr;
+
+	// Messages queued for the worker are dropped, the next frame polls fresh state
+	AcquireSRWLockExclusive(&g_inputLock);
+	g_inputQueued = false;
+	g_inputTail = g_inputHead.load();
+	ReleaseSRWLockExclusive(&g_inputLock);
+	g_textureHandoff = false;
+
+	for (auto& buffer : g_buffers)
+		buffer.Valid = false;
+}
+
+/**
+ * @brief Logs and resets the CPU time per frame collected in the current benchmark window.
+ */
+static void OverlayFrame_FlushBenchmark(LONGLONG now)
+{
+	if (g_mode == OverlayUpdateWorker)
+		g_benchRebuilds = g_workerBuilds.exchange(0);
+
+	if (g_benchFrames)
+	{
+		HydraHookEngineLogInfo(
+			"overlay-benchmark {\"mode\":\"%s\",\"frames\":%u,\"rebuilds\":%u,\"cpu_us_per_frame\":%.2f}",
+			OverlayUpdateModeName(g_mode),
+			g_benchFrames,
+			g_benchRebuilds,
+			static_cast<double>(g_benchTicks) * 1000000.0 / static_cast<double>(g_frequency) / g_benchFrames
+		);
+	}
+
+	g_benchWindowStart = now;
+	g_benchTicks = 0;
+	g_benchFrames = 0;
+	g_benchRebuilds = 0;
+}
+
+/**
+ * @brief Decides whether the ImGui frame has to be rebuilt or the snapshot can be replayed.
+ *
+ * Input is sampled by polling (cursor movement, held mouse buttons) in addition to
+ * explicit invalidation, since the window procedure hooks are optional.
+ */
+static bool OverlayFrame_RebuildDue(LONGLONG now)
+{
+	bool due = g_invalidated.exchange(false);
+
+	POINT cursor;
+	if (GetCursorPos(&cursor) && (cursor.x != g_lastCursor.x || cursor.y != g_lastCursor.y))
+	{
+		g_lastCursor = cursor;
+		due = true;
+	}
+
+	if ((GetAsyncKeyState(VK_LBUTTON) | GetAsyncKeyState(VK_RBUTTON) | GetAsyncKeyState(VK_MBUTTON)) & 0x8000)
+		due = true;
+
+	return due
+		|| g_mode == OverlayUpdateEveryFrame
+		|| !g_snapshot.Valid
+		|| now - g_lastBuild >= g_frequency / OVERLAY_UPDATE_RATE_HZ;
+}
+
+/**
+ * @brief Returns the draw data to submit this Present, rebuilding the ImGui frame only when due.
+ *
+ * On a rebuild the backend's NewFrame, the Win32 NewFrame, ImGui::NewFrame and RenderScene run
+ * and the live draw data is returned (and snapshotted in throttled mode); otherwise the snapshot
+ * of the last build is returned. F11 toggles between OverlayUpdateThrottled and
+ * OverlayUpdateEveryFrame. Must be paired with OverlayFrame_End after the draw data was submitted.
+ *
+ * @param BackendNewFrame The renderer backend's NewFrame (e.g. ImGui_ImplDX11_NewFrame).
+ * @return Draw data for the backend's RenderDrawData.
+ */
+ImDrawData* OverlayFrame_Begin(void (*BackendNewFrame)())
+{
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	g_frameStart = now.QuadPart;
+
+	if (!g_frequency)
+	{
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		g_frequency = frequency.QuadPart;
+		g_benchWindowStart = now.QuadPart;
+	}
+
+	static bool switchMode = false;
+	const auto previous = switchMode;
+	TOGGLE_STATE(VK_F11, switchMode);
+
+	if (switchMode != previous)
+	{
+		OverlayFrame_FlushBenchmark(now.QuadPart);
+
+		if (g_mode == OverlayUpdateWorker)
+			OverlayFrame_StopWorker();
+
+		g_mode = static_cast<OverlayUpdateMode>((g_mode + 1) % OverlayUpdateModeCount);
+		g_invalidated = true;
+
+		HydraHookEngineLogInfo("Overlay update mode: %s", OverlayUpdateModeName(g_mode));
+	}
+
+	//
+	// Swap in the background-loaded font while nothing else uses the atlas;
+	// the worker (if any) is restarted below
+	// 
+	if (FontCache_IsReady())
+	{
+		OverlayFrame_SuspendWorker();
+
+		if (FontCache_Apply())
+			InvalidateOverlayDeviceObjects();
+	}
+
+	if (g_mode == OverlayUpdateWorker)
+	{
+		// Device objects (and pre-1.92 the font texture) stay on the render thread; after
+		// OverlayFrame_SuspendWorker they are recreated here before the worker restarts
+		BackendNewFrame();
+		OverlayFrame_StartWorker();
+
+		if (g_ready.load(std::memory_order_relaxed) & OVERLAY_BUFFER_FRESH)
+			g_front = g_ready.exchange(g_front, std::memory_order_acq_rel) & OVERLAY_BUFFER_INDEX;
+
+		return g_buffers[g_front].Valid ? &g_buffers[g_front].Data : &g_emptyDrawData;
+	}
+
+	if (!OverlayFrame_RebuildDue(now.QuadPart))
+		return &g_snapshot.Data;
+
+	BackendNewFrame();
+	ImGui_ImplWin32_NewFrame();
+	ImGui::NewFrame();
+
+	RenderScene();
+
+	g_lastBuild = now.QuadPart;
+	g_benchRebuilds++;
+
+	ImDrawData* drawData = ImGui::GetDrawData();
+
+	if (g_mode == OverlayUpdateThrottled)
+		g_snapshot.Capture(drawData);
+
+	return drawData;
+}
+
+/**
+ * @brief Accounts the CPU time since OverlayFrame_Begin to the current benchmark window.
+ */
+void OverlayFrame_End()
+{
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+#if IMGUI_VERSION_NUM >= 19200
+	if (g_mode == OverlayUpdateWorker && g_buffers[g_front].Data.Textures)
+	{
+		// Backend processed the texture updates, let the worker continue
+		g_buffers[g_front].Data.Textures = nullptr;
+		g_textureHandoff = false;
+		SetEvent(g_workerWake);
+	}
+#endif
+
+	g_benchTicks += now.QuadPart - g_frameStart;
+	g_benchFrames++;
+
+	if (now.QuadPart - g_benchWindowStart >= g_frequency * OVERLAY_BENCHMARK_WINDOW_SECONDS)
+		OverlayFrame_FlushBenchmark(now.QuadPart);
+}
+
+/**
+ * @brief Forces a rebuild on the next Present (input, resize, device reset).
+ */
+void OverlayFrame_Invalidate()
+{
+	g_invalidated = true;
+
+	if (g_workerWake)
+		SetEvent(g_workerWake);
+}
+
+/**
+ * @brief Stops the worker; call before the backend's device objects are invalidated.
+ *
+ * The backend recreates them (the font texture included) while the worker is stopped,
+ * in the post reset/resize callback or its next NewFrame; OverlayFrame_Begin restarts
+ * the worker only after that NewFrame.
+ */
+void OverlayFrame_SuspendWorker()
+{
+	OverlayFrame_StopWorker();
+	g_snapshot.Valid = false;
+	g_invalidated = true;
+}
+
+/**
+ * @brief Forwards a window message to ImGui; call from the window procedure hooks.
+ *
+ * In OverlayUpdateWorker mode the message is queued for the worker (dropped when the
+ * queue is full) since only the worker may touch the ImGui context; otherwise it is
+ * handled directly. Both happen under g_inputLock, so the worker can't start while a
+ * message is being handled directly.
+ */
+void OverlayFrame_HandleInput(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
+{
+	if (t_inputHandling)
+	{
+		// Sent to this thread's window from within the handler below; the lock is held
+		ImGui_ImplWin32_WndProcHandler(hWnd, Msg, wParam, lParam);
+	}
+	else
+	{
+		AcquireSRWLockExclusive(&g_inputLock);
+
+		if (g_inputQueued)
+		{
+			const UINT head = g_inputHead.load(std::memory_order_relaxed);
+
+			if (head - g_inputTail.load(std::memory_order_acquire) < OVERLAY_INPUT_QUEUE_SIZE)
+			{
+				g_inputQueue[head & (OVERLAY_INPUT_QUEUE_SIZE - 1)] = { hWnd, Msg, wParam, lParam };
+				g_inputHead.store(head + 1, std::memory_order_release);
+			}
+		}
+		else
+		{
+			t_inputHandling = true;
+			ImGui_ImplWin32_WndProcHandler(hWnd, Msg, wParam, lParam);
+			t_inputHandling = false;
+		}
+
+		ReleaseSRWLockExclusive(&g_inputLock);
+	}
+
+	if (OverlayFrame_IsInputMessage(Msg))
+		OverlayFrame_Invalidate();
+}
+
+/**
+ * @brief Stops the worker and frees all snapshots; call before the ImGui backends shut down.
+ */
+void OverlayFrame_Shutdown()
+{
+	OverlayFrame_StopWorker();
+
+	if (g_workerWake)
+	{
+		CloseHandle(g_workerWake);
+		g_workerWake = nullptr;
+	}
+
+	g_snapshot.Clear();
+	for (auto& buffer : g_buffers)
+		buffer.Clear();
+
+	g_invalidated = true;
+}
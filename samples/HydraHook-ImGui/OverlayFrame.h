@@ -0,0 +1,52 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <imgui.h>
+
+/**
+ * @brief How often the overlay's ImGui frame is rebuilt.
+ */
+enum OverlayUpdateMode
+{
+	OverlayUpdateEveryFrame,	/**< NewFrame, RenderScene and Render on every Present. */
+	OverlayUpdateThrottled,		/**< Rebuild at OVERLAY_UPDATE_RATE_HZ or on input/state change, replay otherwise. */
+	OverlayUpdateWorker,		/**< Build on a worker thread; Present only submits the latest published frame. */
+	OverlayUpdateModeCount
+};
+
+/**
+ * @brief Rebuild rate of OverlayUpdateThrottled.
+ */
+#define OVERLAY_UPDATE_RATE_HZ 30
+
+ImDrawData* OverlayFrame_Begin(void (*BackendNewFrame)());
+void OverlayFrame_End();
+void OverlayFrame_Invalidate();
+void OverlayFrame_SuspendWorker();
+void OverlayFrame_HandleInput(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
+void OverlayFrame_Shutdown();
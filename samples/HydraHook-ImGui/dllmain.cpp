@@ -23,6 +23,8 @@ SOFTWARE.
 */
 
 #include "dllmain.h"
+#include "OverlayFrame.h"
+#include "FontCache.h"
 
 // 
 // Detours
@@ -87,7 +89,7 @@ void EvtHydraHookGameHooked(
 
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
-	ImGuiIO& io = ImGui::GetIO(); (void)io;
+	ImGuiIO& io = ImGui::GetIO();
 	//io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;  // Enable Keyboard Controls
 	//io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;   // Enable Gamepad Controls
 
@@ -95,6 +97,9 @@ void EvtHydraHookGameHooked(
 	ImGui::StyleColorsDark();
 	//ImGui::StyleColorsClassic();
 
+	// Load (or build) the overlay font off the render thread
+	FontCache_Start(OVERLAY_FONT_PATH, OVERLAY_FONT_SIZE, io.Fonts->GetGlyphRangesDefault());
+
 	HYDRAHOOK_D3D9_EVENT_CALLBACKS d3d9;
 	HYDRAHOOK_D3D9_EVENT_CALLBACKS_INIT(&d3d9);
 	d3d9.EvtHydraHookD3D9PrePresent = EvtHydraHookD3D9Present;
@@ -161,6 +166,10 @@ void EvtHydraHookGameUnhooked(
 
 	HydraHookEngineLogInfo("Unhooking ImGui overlay");
 
+	// Stop the frame and font workers before the backends they rely on go away
+	OverlayFrame_Shutdown();
+	FontCache_Shutdown();
+
 	// Shutdown ImGui backend based on detected game version (order: backend first, then Win32, then context)
 	switch (g_GameVersion)
 	{
@@ -269,14 +278,12 @@ void EvtHydraHookD3D9Present(
 	if (!show_overlay)
 		return;
 
-	// Start the Dear ImGui frame
-	ImGui_ImplDX9_NewFrame();
-	ImGui_ImplWin32_NewFrame();
-	ImGui::NewFrame();
+	// Start the Dear ImGui frame (or replay the last one)
+	ImDrawData* drawData = OverlayFrame_Begin(ImGui_ImplDX9_NewFrame);
 
-	RenderScene();
+	ImGui_ImplDX9_RenderDrawData(drawData);
 
-	ImGui_ImplDX9_RenderDrawData(ImGui::GetDrawData());
+	OverlayFrame_End();
 }
 
 void EvtHydraHookD3D9PreReset(
@@ -284,6 +291,7 @@ void EvtHydraHookD3D9PreReset(
 	D3DPRESENT_PARAMETERS   *pPresentationParameters
 )
 {
+	OverlayFrame_SuspendWorker();
 	ImGui_ImplDX9_InvalidateDeviceObjects();
 }
 
@@ -293,6 +301,7 @@ void EvtHydraHookD3D9PostReset(
 )
 {
 	ImGui_ImplDX9_CreateDeviceObjects();
+	OverlayFrame_Invalidate();
 }
 
 void EvtHydraHookD3D9PresentEx(
@@ -340,14 +349,12 @@ void EvtHydraHookD3D9PresentEx(
 	if (!show_overlay)
 		return;
 
-	// Start the Dear ImGui frame
-	ImGui_ImplDX9_NewFrame();
-	ImGui_ImplWin32_NewFrame();
-	ImGui::NewFrame();
+	// Start the Dear ImGui frame (or replay the last one)
+	ImDrawData* drawData = OverlayFrame_Begin(ImGui_ImplDX9_NewFrame);
 
-	RenderScene();
+	ImGui_ImplDX9_RenderDrawData(drawData);
 
-	ImGui_ImplDX9_RenderDrawData(ImGui::GetDrawData());
+	OverlayFrame_End();
 }
 
 void EvtHydraHookD3D9PreResetEx(
@@ -356,6 +363,7 @@ void EvtHydraHookD3D9PreResetEx(
 	D3DDISPLAYMODEEX        *pFullscreenDisplayMode
 )
 {
+	OverlayFrame_SuspendWorker();
 	ImGui_ImplDX9_InvalidateDeviceObjects();
 }
 
@@ -366,6 +374,7 @@ void EvtHydraHookD3D9PostResetEx(
 )
 {
 	ImGui_ImplDX9_CreateDeviceObjects();
+	OverlayFrame_Invalidate();
 }
 
 #pragma endregion
@@ -420,14 +429,12 @@ void EvtHydraHookD3D10Present(
 		return;
 
 
-	// Start the Dear ImGui frame
-	ImGui_ImplDX10_NewFrame();
-	ImGui_ImplWin32_NewFrame();
-	ImGui::NewFrame();
+	// Start the Dear ImGui frame (or replay the last one)
+	ImDrawData* drawData = OverlayFrame_Begin(ImGui_ImplDX10_NewFrame);
 
-	RenderScene();
+	ImGui_ImplDX10_RenderDrawData(drawData);
 
-	ImGui_ImplDX10_RenderDrawData(ImGui::GetDrawData());
+	OverlayFrame_End();
 }
 
 void EvtHydraHookD3D10PreResizeBuffers(
@@ -439,6 +446,7 @@ void EvtHydraHookD3D10PreResizeBuffers(
 	UINT            SwapChainFlags
 )
 {
+	OverlayFrame_SuspendWorker();
 	ImGui_ImplDX10_InvalidateDeviceObjects();
 }
 
@@ -452,6 +460,7 @@ void EvtHydraHookD3D10PostResizeBuffers(
 )
 {
 	ImGui_ImplDX10_CreateDeviceObjects();
+	OverlayFrame_Invalidate();
 }
 
 #pragma endregion
@@ -513,16 +522,14 @@ void EvtHydraHookD3D11Present(
 	if (!show_overlay)
 		return;
 
-	// Start the Dear ImGui frame
-	ImGui_ImplDX11_NewFrame();
-	ImGui_ImplWin32_NewFrame();
-	ImGui::NewFrame();
+	// Start the Dear ImGui frame (or replay the last one)
+	ImDrawData* drawData = OverlayFrame_Begin(ImGui_ImplDX11_NewFrame);
 
 	pContext->OMSetRenderTargets(1, &g_d3d11_mainRenderTargetView, NULL);
 
-	RenderScene();
+	ImGui_ImplDX11_RenderDrawData(drawData);
 
-	ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+	OverlayFrame_End();
 }
 
 //
@@ -566,6 +573,8 @@ void EvtHydraHookD3D11PostResizeBuffers(
 	pSwapChain->GetBuffer(0, IID_PPV_ARGS(&pBackBuffer));
 	pDevice->CreateRenderTargetView(pBackBuffer, NULL, &g_d3d11_mainRenderTargetView);
 	pBackBuffer->Release();
+
+	OverlayFrame_Invalidate();
 }
 
 #pragma endregion
@@ -886,9 +895,8 @@ void EvtHydraHookD3D12Present(
 	if (backBufferIdx >= g_d3d12_numBackBuffers)
 		backBufferIdx = 0;
 
-	ImGui_ImplDX12_NewFrame();
-	ImGui_ImplWin32_NewFrame();
-	ImGui::NewFrame();
+	// Start the Dear ImGui frame (or replay the last one)
+	ImDrawData* drawData = OverlayFrame_Begin(ImGui_ImplDX12_NewFrame);
 
 	g_d3d12_pCommandAllocator->Reset();
 	g_d3d12_pCommandList->Reset(g_d3d12_pCommandAllocator, nullptr);
@@ -905,9 +913,7 @@ void EvtHydraHookD3D12Present(
 	g_d3d12_pCommandList->OMSetRenderTargets(1, &g_d3d12_mainRenderTargetDescriptor[backBufferIdx], FALSE, nullptr);
 	g_d3d12_pCommandList->SetDescriptorHeaps(1, &g_d3d12_pSrvDescHeap);
 
-	RenderScene();
-
-	ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_d3d12_pCommandList);
+	ImGui_ImplDX12_RenderDrawData(drawData, g_d3d12_pCommandList);
 
 	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
 	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
@@ -917,6 +923,8 @@ void EvtHydraHookD3D12Present(
 	g_d3d12_pCommandQueue->ExecuteCommandLists(1, (ID3D12CommandList* const*)&g_d3d12_pCommandList);
 	g_d3d12_pCommandQueue->Signal(g_d3d12_pFence, ++g_d3d12_fenceLastSignaledValue);
 	D3D12_WaitForGpu();
+
+	OverlayFrame_End();
 }
 
 /**
@@ -950,6 +958,7 @@ void EvtHydraHookD3D12PreResizeBuffers(
 	(void)SwapChainFlags;
 	(void)Extension;
 
+	OverlayFrame_SuspendWorker();
 	ImGui_ImplDX12_InvalidateDeviceObjects();
 	D3D12_WaitForGpu();
 	D3D12_CleanupOverlayResources();
@@ -987,12 +996,45 @@ void EvtHydraHookD3D12PostResizeBuffers(
 		return;
 	}
 	ImGui_ImplDX12_CreateDeviceObjects();
+	OverlayFrame_Invalidate();
 }
 
 #endif
 
 #pragma endregion
 
+/**
+ * @brief Releases the active backend's device objects (including the font texture).
+ *
+ * The backends recreate them on their next NewFrame, picking up a replaced font atlas.
+ */
+void InvalidateOverlayDeviceObjects()
+{
+	OverlayFrame_SuspendWorker();
+
+	switch (g_GameVersion)
+	{
+	case HydraHookDirect3DVersion9:
+		ImGui_ImplDX9_InvalidateDeviceObjects();
+		break;
+	case HydraHookDirect3DVersion10:
+		ImGui_ImplDX10_InvalidateDeviceObjects();
+		break;
+	case HydraHookDirect3DVersion11:
+		ImGui_ImplDX11_InvalidateDeviceObjects();
+		break;
+#ifdef _WIN64
+	case HydraHookDirect3DVersion12:
+		// Present waits for the GPU every frame, so the old font texture is idle
+		ImGui_ImplDX12_InvalidateDeviceObjects();
+		g_d3d12_srvDescriptorCount = 0;
+		break;
+#endif
+	default:
+		break;
+	}
+}
+
 #pragma region WNDPROC Hooking
 
 /**
@@ -1070,7 +1112,7 @@ LRESULT WINAPI DetourDefWindowProc(
 	static std::once_flag flag;
 	std::call_once(flag, []() { HydraHookEngineLogInfo("++ DetourDefWindowProc called"); });
 
-	ImGui_ImplWin32_WndProcHandler(hWnd, Msg, wParam, lParam);
+	OverlayFrame_HandleInput(hWnd, Msg, wParam, lParam);
 
 	return OriginalDefWindowProc(hWnd, Msg, wParam, lParam);
 }
@@ -1085,7 +1127,7 @@ LRESULT WINAPI DetourWindowProc(
 	static std::once_flag flag;
 	std::call_once(flag, []() { HydraHookEngineLogInfo("++ DetourWindowProc called"); });
 
-	ImGui_ImplWin32_WndProcHandler(hWnd, Msg, wParam, lParam);
+	OverlayFrame_HandleInput(hWnd, Msg, wParam, lParam);
 
 	return OriginalWindowProc(hWnd, Msg, wParam, lParam);
 }
@@ -59,6 +59,7 @@ LRESULT WINAPI DetourWindowProc(
 
 void HookWindowProc(HWND hWnd);
 void RenderScene();
+void InvalidateOverlayDeviceObjects();
 
 bool ImGui_ImplWin32_UpdateMouseCursor();
 IMGUI_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -102,22 +103,24 @@ VOID
 FORCEINLINE
 TOGGLE_STATE(int key, bool& toggle)
 {
-	static auto pressedPast = false, pressedNow = false;
+	// Per key, so several toggles can be polled in the same frame
+	static bool pressedPast[256] = {}, pressedNow[256] = {};
+	const auto slot = key & 0xFF;
 
 	if (GetAsyncKeyState(key) & 0x8000)
 	{
-		pressedNow = true;
+		pressedNow[slot] = true;
 	}
 	else
 	{
-		pressedPast = false;
-		pressedNow = false;
+		pressedPast[slot] = false;
+		pressedNow[slot] = false;
 	}
 
-	if (!pressedPast && pressedNow)
+	if (!pressedPast[slot] && pressedNow[slot])
 	{
 		toggle = !toggle;
 
-		pressedPast = true;
+		pressedPast[slot] = true;
 	}
 }
@@ -0,0 +1,1246 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "Benchmark.h"
+#include "ColorBlobs.h"
+#include "Downscale.h"
+#include "FrameBus.h"
+#include "FrameHash.h"
+#include "FramePool.h"
+#include "FrameStats.h"
+#include "FrameStream.h"
+#include "Hamming.h"
+#include "Inference.h"
+#include "MotionField.h"
+#include "TemplateMatch.h"
+#include "Tracker.h"
+#include <HydraHook/Engine/HydraHookCore.h>
+
+#include <opencv2/core.hpp>
+#include <opencv2/core/utility.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr int BENCHMARK_ITERATIONS = 20;
+
+/**
+ * @brief Milliseconds elapsed since a QueryPerformanceCounter start value.
+ */
+static double Benchmark_ElapsedMs(LARGE_INTEGER start)
+{
+	static LARGE_INTEGER frequency = {};
+	if (!frequency.QuadPart)
+		QueryPerformanceFrequency(&frequency);
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return (double)(now.QuadPart - start.QuadPart) * 1000.0 / (double)frequency.QuadPart;
+}
+
+/**
+ * @brief Synthetic R8G8B8A8 frame with a padded row pitch like a mapped readback buffer.
+ */
+static cv::Mat Benchmark_MakeRgbaFrame(int width, int height)
+{
+	const int pitchPixels = (width + 63) & ~63;
+	cv::Mat padded(height, pitchPixels, CV_8UC4);
+	cv::randu(padded, cv::Scalar::all(0), cv::Scalar::all(256));
+	cv::GaussianBlur(padded, padded, cv::Size(5, 5), 0);
+	return padded;
+}
+
+/**
+ * @brief The pre-downscale capture path: full-size BGR conversion, then cvtColor and resize.
+ */
+static void Benchmark_SeparatePasses(const cv::Mat& rgba, int width, int height, cv::Size dstSize, DownscaleFilter filter, cv::Mat& bgr, cv::Mat& gray, cv::Mat& dst)
+{
+	bgr.create(height, width, CV_8UC3);
+	for (int y = 0; y < height; y++)
+	{
+		const uint8_t* src = rgba.ptr<uint8_t>(y);
+		uint8_t* out = bgr.ptr<uint8_t>(y);
+		for (int x = 0; x < width; x++)
+		{
+			out[x * 3 + 0] = src[x * 4 + 2];
+			out[x * 3 + 1] = src[x * 4 + 1];
+			out[x * 3 + 2] = src[x * 4 + 0];
+		}
+	}
+	cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);
+	if (dstSize == gray.size())
+		dst = gray;
+	else
+		cv::resize(gray, dst, dstSize, 0, 0, filter == DownscaleFilterBilinear ? cv::INTER_LINEAR : cv::INTER_AREA);
+}
+
+/**
+ * @brief Fused readback conversion + downscale against the separate passes it replaced.
+ */
+static void Benchmark_Downscale()
+{
+	struct Case { int width, height, dstWidth, dstHeight; DownscaleFilter filter; };
+	static const Case cases[] =
+	{
+		{ 1920, 1080, 1920, 1080, DownscaleFilterArea },
+		{ 1920, 1080,  960,  540, DownscaleFilterArea },
+		{ 1920, 1080,  640,  360, DownscaleFilterArea },
+		{ 2560, 1440,  960,  540, DownscaleFilterArea },
+		{ 2560, 1440,  960,  540, DownscaleFilterBilinear },
+		{ 3840, 2160,  960,  540, DownscaleFilterArea },
+		{ 3840, 2160,  960,  540, DownscaleFilterBilinear },
+	};
+
+	for (const Case& c : cases)
+	{
+		const cv::Mat rgba = Benchmark_MakeRgbaFrame(c.width, c.height);
+		const cv::Size dstSize(c.dstWidth, c.dstHeight);
+		cv::Mat fused, bgr, gray, separate;
+
+		/* warm-up, also sizes every buffer */
+		Downscale_RgbaToGray(rgba.data, rgba.step, c.width, c.height, dstSize, c.filter, fused, nullptr);
+		Benchmark_SeparatePasses(rgba, c.width, c.height, dstSize, c.filter, bgr, gray, separate);
+
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+			Downscale_RgbaToGray(rgba.data, rgba.step, c.width, c.height, dstSize, c.filter, fused, nullptr);
+		const double fusedMs = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+			Benchmark_SeparatePasses(rgba, c.width, c.height, dstSize, c.filter, bgr, gray, separate);
+		const double separateMs = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+		cv::Mat diff;
+		cv::absdiff(fused, separate, diff);
+		double maxDiff = 0.0;
+		cv::minMaxLoc(diff, nullptr, &maxDiff);
+
+		HydraHookEngineLogInfo(
+			"opencv-benchmark {\"stage\":\"downscale\",\"filter\":\"%s\",\"src\":\"%dx%d\",\"dst\":\"%dx%d\",\"fused_ms\":%.3f,\"separate_ms\":%.3f,\"max_abs_diff\":%.0f}",
+			Downscale_GetFilterName(cv::Size(c.width, c.height), dstSize, c.filter),
+			c.width, c.height, c.dstWidth, c.dstHeight, fusedMs, separateMs, maxDiff);
+	}
+}
+
+/**
+ * @brief Smooth random gray frame, roughly the spatial statistics of a downscaled game frame.
+ */
+static cv::Mat Benchmark_MakeGrayFrame(cv::RNG& rng, cv::Size size)
+{
+	cv::Mat coarse(size.height / 24 + 2, size.width / 24 + 2, CV_8UC1);
+	rng.fill(coarse, cv::RNG::UNIFORM, 0, 256);
+	cv::Mat gray;
+	cv::resize(coarse, gray, size, 0, 0, cv::INTER_CUBIC);
+	return gray;
+}
+
+/**
+ * @brief Fingerprint throughput, BK-tree vs. linear scan queries, and recall on perturbed frames.
+ */
+static void Benchmark_FrameHash()
+{
+	const cv::Size analysisSize(960, 540);
+	const int radius = 6;
+	cv::RNG rng(0x4879647261ull);
+
+	/* fingerprint throughput */
+	{
+		const cv::Mat gray = Benchmark_MakeGrayFrame(rng, analysisSize);
+		FrameHash_Compute(gray);
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		volatile uint64_t sink = 0;
+		for (int i = 0; i < BENCHMARK_ITERATIONS * 10; i++)
+			sink ^= FrameHash_Compute(gray).pHash;
+		const double ms = Benchmark_ElapsedMs(start) / (BENCHMARK_ITERATIONS * 10);
+		HydraHookEngineLogInfo(
+			"opencv-benchmark {\"stage\":\"framehash\",\"test\":\"fingerprint\",\"src\":\"%dx%d\",\"ms_per_frame\":%.4f,\"frames_per_s\":%.0f}",
+			analysisSize.width, analysisSize.height, ms, 1000.0 / ms);
+	}
+
+	/* index queries against a linear scan over the same hashes */
+	for (const int count : { 10000, 100000, 1000000 })
+	{
+		std::vector<uint64_t> hashes((size_t)count);
+		for (auto& h : hashes)
+			h = ((uint64_t)(unsigned)rng << 32) | (unsigned)rng;
+
+		FrameHashIndex index;
+		index.Reserve(hashes.size());
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		for (const uint64_t h : hashes)
+			index.Insert(h);
+		const double insertMs = Benchmark_ElapsedMs(start);
+
+		/* half the probes are near a stored hash, half random */
+		const int queries = 2000;
+		std::vector<uint64_t> probes((size_t)queries);
+		for (int i = 0; i < queries; i++)
+		{
+			uint64_t h = ((uint64_t)(unsigned)rng << 32) | (unsigned)rng;
+			if (i & 1)
+			{
+				h = hashes[(size_t)rng.uniform(0, count)];
+				for (int b = rng.uniform(0, radius + 1); b > 0; b--)
+					h ^= 1ull << rng.uniform(0, 64);
+			}
+			probes[(size_t)i] = h;
+		}
+
+		std::vector<int> treeResults((size_t)queries), scanResults((size_t)queries);
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < queries; i++)
+			treeResults[(size_t)i] = index.FindNearest(probes[(size_t)i], radius);
+		const double treeMs = Benchmark_ElapsedMs(start);
+
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < queries; i++)
+		{
+			int best = -1;
+			for (const uint64_t h : hashes)
+			{
+				const int d = FrameHash_Distance(probes[(size_t)i], h);
+				if (d <= radius && (best == -1 || d < best))
+					best = d;
+			}
+			scanResults[(size_t)i] = best;
+		}
+		const double scanMs = Benchmark_ElapsedMs(start);
+
+		int mismatches = 0;
+		for (int i = 0; i < queries; i++)
+			mismatches += treeResults[(size_t)i] != scanResults[(size_t)i];
+
+		HydraHookEngineLogInfo(
+			"opencv-benchmark {\"stage\":\"framehash\",\"test\":\"index\",\"stored\":%zu,\"radius\":%d,\"insert_ms\":%.2f,\"bktree_queries_per_s\":%.0f,\"linear_queries_per_s\":%.0f,\"mismatches\":%d}",
+			index.Size(), radius, insertMs, queries * 1000.0 / treeMs, queries * 1000.0 / scanMs, mismatches);
+	}
+
+	/* recall on perturbed copies, false positives between unrelated frames */
+	{
+		const int frames = 200;
+		std::vector<FrameFingerprint> bases;
+		int recalled[2] = {}, falsePositives[2] = {}, variants = 0, pairs = 0;
+
+		for (int f = 0; f < frames; f++)
+		{
+			const cv::Mat base = Benchmark_MakeGrayFrame(rng, analysisSize);
+			const FrameFingerprint baseFp = FrameHash_Compute(base);
+
+			cv::Mat noisy = base.clone(), noise(base.size(), CV_16SC1);
+			rng.fill(noise, cv::RNG::NORMAL, 0, 4);
+			cv::add(noisy, noise, noisy, cv::noArray(), CV_8U);
+
+			cv::Mat brighter = base + cv::Scalar::all(12);
+
+			cv::Mat shifted;
+			const cv::Mat shift = (cv::Mat_<double>(2, 3) << 1, 0, 3, 0, 1, 2);
+			cv::warpAffine(base, shifted, shift, base.size(), cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+
+			cv::Mat zoomed;
+			cv::resize(base(cv::Rect(24, 14, analysisSize.width - 48, analysisSize.height - 28)), zoomed, analysisSize);
+
+			for (const cv::Mat* variant : { &noisy, &brighter, &shifted, &zoomed })
+			{
+				const FrameFingerprint fp = FrameHash_Compute(*variant);
+				recalled[0] += FrameHash_Distance(fp.dHash, baseFp.dHash) <= radius;
+				recalled[1] += FrameHash_Distance(fp.pHash, baseFp.pHash) <= radius;
+				variants++;
+			}
+
+			for (const FrameFingerprint& other : bases)
+			{
+				falsePositives[0] += FrameHash_Distance(other.dHash, baseFp.dHash) <= radius;
+				falsePositives[1] += FrameHash_Distance(other.pHash, baseFp.pHash) <= radius;
+				pairs++;
+			}
+			bases.push_back(baseFp);
+		}
+
+		static const char* const names[] = { "dhash", "phash" };
+		for (int k = 0; k < 2; k++)
+		{
+			HydraHookEngineLogInfo(
+				"opencv-benchmark {\"stage\":\"framehash\",\"test\":\"recall\",\"hash\":\"%s\",\"radius\":%d,\"recall\":%.3f,\"false_positive_rate\":%.4f}",
+				names[k], radius, (double)recalled[k] / variants, (double)falsePositives[k] / pairs);
+		}
+	}
+}
+
+/**
+ * @brief Smooth background with UI-like clutter (panels, text, icons) so templates have distinct detail.
+ */
+static cv::Mat Benchmark_MakeUiFrame(cv::RNG& rng, cv::Size size)
+{
+	cv::Mat frame = Benchmark_MakeGrayFrame(rng, size);
+	for (int i = 0; i < 400; i++)
+	{
+		const cv::Point p(rng.uniform(0, size.width), rng.uniform(0, size.height));
+		const cv::Scalar color(rng.uniform(0, 256));
+		switch (rng.uniform(0, 3))
+		{
+		case 0:
+			cv::rectangle(frame, cv::Rect(p, cv::Size(rng.uniform(8, 120), rng.uniform(8, 60))), color, rng.uniform(-1, 4));
+			break;
+		case 1:
+			cv::circle(frame, p, rng.uniform(4, 40), color, rng.uniform(-1, 4));
+			break;
+		default:
+			cv::putText(frame, cv::format("%c%d", 'A' + rng.uniform(0, 26), rng.uniform(0, 1000)), p,
+				cv::FONT_HERSHEY_SIMPLEX, rng.uniform(0.4, 1.5), color, rng.uniform(1, 3));
+			break;
+		}
+	}
+	return frame;
+}
+
+/**
+ * @brief Dozens of templates on a 1440p frame: full-frame vs. tracked search, pooled vs. single thread.
+ */
+static void Benchmark_TemplateMatch()
+{
+	const cv::Size frameSize(2560, 1440);
+	const int templateCount = 36;
+	cv::RNG rng(0x54504Cull);
+	const cv::Mat frame = Benchmark_MakeUiFrame(rng, frameSize);
+
+	TemplateMatcher matcher;
+	std::vector<cv::Point> truth;
+	while ((int)matcher.Size() < templateCount)
+	{
+		const cv::Size size(rng.uniform(24, 97), rng.uniform(24, 97));
+		const cv::Point pos(rng.uniform(0, frameSize.width - size.width), rng.uniform(0, frameSize.height - size.height));
+		if (matcher.Add(cv::format("t%02d", (int)matcher.Size()), frame(cv::Rect(pos, size))))
+			truth.push_back(pos);
+	}
+
+	const int poolThreads = cv::getNumThreads();
+	std::vector<TemplateMatchResult> results;
+	for (const int threads : { poolThreads, 1 })
+	{
+		cv::setNumThreads(threads);
+		for (const bool tracked : { false, true })
+		{
+			matcher.ResetTracking();
+			matcher.Match(frame, 1.0f, results);
+
+			LARGE_INTEGER start;
+			QueryPerformanceCounter(&start);
+			for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+			{
+				if (!tracked)
+					matcher.ResetTracking();
+				matcher.Match(frame, 1.0f, results);
+			}
+			const double ms = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+			int located = 0;
+			for (size_t i = 0; i < results.size(); i++)
+			{
+				const cv::Point found((int)results[i].box.x, (int)results[i].box.y);
+				located += results[i].found && std::abs(found.x - truth[i].x) <= 1 && std::abs(found.y - truth[i].y) <= 1;
+			}
+
+			HydraHookEngineLogInfo(
+				"opencv-benchmark {\"stage\":\"templatematch\",\"src\":\"%dx%d\",\"templates\":%d,\"search\":\"%s\",\"threads\":%d,\"ms_per_frame\":%.3f,\"located\":%d}",
+				frameSize.width, frameSize.height, templateCount, tracked ? "tracked" : "full", threads, ms, located);
+		}
+	}
+	cv::setNumThreads(poolThreads);
+}
+
+/**
+ * @brief Per-object tracker update cost by box size and object count, on a panning synthetic scene.
+ */
+static void Benchmark_Tracker()
+{
+	const cv::Size analysisSize(960, 540);
+	const int frames = 60;
+	const cv::Point2f pan(1.5f, -1.0f);
+	cv::RNG rng(0x4D4F5353ull);
+
+	/* oversized scene so the panned window never leaves it */
+	const cv::Mat scene = Benchmark_MakeUiFrame(rng, cv::Size(analysisSize.width + 200, analysisSize.height + 200));
+	std::vector<cv::Mat> sequence((size_t)frames);
+	for (int f = 0; f < frames; f++)
+	{
+		const cv::Mat m = (cv::Mat_<double>(2, 3) << 1, 0, pan.x * f - 100, 0, 1, pan.y * f - 100);
+		cv::warpAffine(scene, sequence[(size_t)f], m, analysisSize, cv::INTER_LINEAR, cv::BORDER_REFLECT);
+	}
+
+	for (const int boxSize : { 32, 64, 128 })
+	{
+		for (const int objects : { 1, 8, 32 })
+		{
+			CorrelationTracker tracker;
+			std::vector<cv::Point2f> starts;
+			while ((int)tracker.Size() < objects)
+			{
+				const cv::Point2f tl((float)rng.uniform(20, analysisSize.width - boxSize - 120), (float)rng.uniform(100, analysisSize.height - boxSize - 20));
+				if (tracker.Add(sequence[0], cv::Rect2f(tl, cv::Size2f((float)boxSize, (float)boxSize))) >= 0)
+					starts.push_back(tl);
+			}
+
+			std::vector<TrackedObject> out;
+			LARGE_INTEGER start;
+			QueryPerformanceCounter(&start);
+			for (int f = 1; f < frames; f++)
+				tracker.Update(sequence[(size_t)f], out);
+			const double ms = Benchmark_ElapsedMs(start) / (frames - 1);
+
+			/* every object moved with the pan */
+			double error = 0.0;
+			int occluded = 0;
+			for (size_t i = 0; i < out.size() && i < starts.size(); i++)
+			{
+				const cv::Point2f expected = starts[i] + pan * (float)(frames - 1);
+				error += std::hypot(out[i].box.x - expected.x, out[i].box.y - expected.y);
+				occluded += out[i].occluded;
+			}
+
+			HydraHookEngineLogInfo(
+				"opencv-benchmark {\"stage\":\"tracker\",\"box\":%d,\"objects\":%d,\"ms_per_frame\":%.3f,\"us_per_object\":%.1f,\"mean_error_px\":%.2f,\"occluded\":%d}",
+				boxSize, objects, ms, ms * 1000.0 / objects, out.empty() ? 0.0 : error / out.size(), occluded);
+		}
+	}
+}
+
+/**
+ * @brief Random ORB-like descriptors; every other query is a noisy copy of a train row.
+ */
+static void Benchmark_MakeDescriptors(cv::RNG& rng, int trainCount, int queryCount, cv::Mat& train, cv::Mat& query)
+{
+	train.create(trainCount, HAMMING_DESCRIPTOR_BYTES, CV_8UC1);
+	query.create(queryCount, HAMMING_DESCRIPTOR_BYTES, CV_8UC1);
+	rng.fill(train, cv::RNG::UNIFORM, 0, 256);
+	rng.fill(query, cv::RNG::UNIFORM, 0, 256);
+	for (int i = 0; i < queryCount; i += 2)
+	{
+		train.row(rng.uniform(0, trainCount)).copyTo(query.row(i));
+		for (int b = rng.uniform(0, 40); b > 0; b--)
+			query.at<uint8_t>(i, rng.uniform(0, HAMMING_DESCRIPTOR_BYTES)) ^= (uint8_t)(1 << rng.uniform(0, 8));
+	}
+}
+
+/**
+ * @brief Brute-force Hamming kernels and the multi-index-hashing index, in descriptor comparisons per second.
+ */
+static void Benchmark_Hamming()
+{
+	cv::RNG rng(0x48414D4Dull);
+	const int maxDistance = 50;
+	const HammingKernel best = Hamming_GetBestKernel();
+
+	/* one frame of ORB features against one keyframe, and against a full keyframe map */
+	for (const int trainCount : { 500, 32000 })
+	{
+		cv::Mat train, query;
+		Benchmark_MakeDescriptors(rng, trainCount, 500, train, query);
+		std::vector<HammingMatch> reference;
+		Hamming_MatchBruteForce(query, train, reference, HammingKernelScalar);
+
+		for (const HammingKernel kernel : { HammingKernelScalar, HammingKernelAvx2, HammingKernelAvx512 })
+		{
+			if (kernel > best)
+				continue;
+			std::vector<HammingMatch> matches;
+			const int iterations = trainCount > 1000 ? 2 : BENCHMARK_ITERATIONS;
+			LARGE_INTEGER start;
+			QueryPerformanceCounter(&start);
+			for (int i = 0; i < iterations; i++)
+				Hamming_MatchBruteForce(query, train, matches, kernel);
+			const double ms = Benchmark_ElapsedMs(start) / iterations;
+
+			int mismatches = 0;
+			for (size_t i = 0; i < matches.size(); i++)
+				mismatches += matches[i].distance != reference[i].distance;
+
+			HydraHookEngineLogInfo(
+				"opencv-benchmark {\"stage\":\"hamming\",\"kernel\":\"%s\",\"query\":%d,\"train\":%d,\"ms\":%.3f,\"comparisons_per_s\":%.3g,\"mismatches\":%d}",
+				Hamming_GetKernelName(kernel), query.rows, trainCount, ms, (double)query.rows * trainCount * 1000.0 / ms, mismatches);
+		}
+	}
+
+	/* MIH: query rate and recall of matches brute force finds within maxDistance */
+	for (const int trainCount : { 8192, 32000, 128000 })
+	{
+		cv::Mat train, query;
+		Benchmark_MakeDescriptors(rng, trainCount, 2000, train, query);
+		std::vector<HammingMatch> reference;
+		Hamming_MatchBruteForce(query, train, reference, best);
+
+		HammingIndex index;
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		index.Build(train);
+		const double buildMs = Benchmark_ElapsedMs(start);
+
+		std::vector<HammingMatch> matches((size_t)query.rows);
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < query.rows; i++)
+			index.Match(query.ptr<uint8_t>(i), maxDistance, matches[(size_t)i]);
+		const double ms = Benchmark_ElapsedMs(start);
+
+		int expected = 0, recalled = 0;
+		for (size_t i = 0; i < matches.size(); i++)
+		{
+			if (reference[i].distance > maxDistance)
+				continue;
+			expected++;
+			recalled += matches[i].distance == reference[i].distance;
+		}
+
+		HydraHookEngineLogInfo(
+			"opencv-benchmark {\"stage\":\"hamming\",\"kernel\":\"mih\",\"query\":%d,\"train\":%d,\"build_ms\":%.2f,\"queries_per_s\":%.0f,\"recall\":%.3f}",
+			query.rows, trainCount, buildMs, query.rows * 1000.0 / ms, expected ? (double)recalled / expected : 1.0);
+	}
+}
+
+/**
+ * @brief Smooth random R8G8B8A8 frame; different seeds stand in for different scenes.
+ */
+static cv::Mat Benchmark_MakeSceneFrame(cv::RNG& rng, cv::Size size)
+{
+	cv::Mat coarse(size.height / 64 + 2, size.width / 64 + 2, CV_8UC4);
+	rng.fill(coarse, cv::RNG::UNIFORM, 0, 256);
+	cv::Mat scene;
+	cv::resize(coarse, scene, size, 0, 0, cv::INTER_CUBIC);
+	return scene;
+}
+
+/**
+ * @brief Frame statistics fused into the readback conversion vs. separate passes, and scene-cut scores.
+ */
+static void Benchmark_FrameStats()
+{
+	struct Case { int width, height; DownscaleFilter filter; };
+	static const Case cases[] =
+	{
+		{ 1920, 1080, DownscaleFilterArea },
+		{ 2560, 1440, DownscaleFilterArea },
+		{ 2560, 1440, DownscaleFilterBilinear },
+		{ 3840, 2160, DownscaleFilterArea },
+	};
+
+	FrameStatsAccumulator accumulator;
+	FrameStats stats;
+
+	for (const Case& c : cases)
+	{
+		const cv::Mat rgba = Benchmark_MakeRgbaFrame(c.width, c.height);
+		const cv::Size dstSize = Downscale_GetAnalysisSize(c.width, c.height, 960);
+		cv::Mat gray;
+
+		Downscale_RgbaToGray(rgba.data, rgba.step, c.width, c.height, dstSize, c.filter, gray, &accumulator);
+
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+			Downscale_RgbaToGray(rgba.data, rgba.step, c.width, c.height, dstSize, c.filter, gray, nullptr);
+		const double plainMs = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+		{
+			Downscale_RgbaToGray(rgba.data, rgba.step, c.width, c.height, dstSize, c.filter, gray, &accumulator);
+			accumulator.Finish(stats);
+		}
+		const double fusedMs = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+		/* The alternative: histogram and moments as passes of their own over gray and the full readback */
+		const cv::Mat source = rgba(cv::Rect(0, 0, c.width, c.height));
+		cv::Mat hist;
+		cv::Scalar mean, stddev;
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+		{
+			const int channels[] = { 0 };
+			const int bins[] = { 256 };
+			const float range[] = { 0.0f, 256.0f };
+			const float* ranges[] = { range };
+			cv::calcHist(&gray, 1, channels, cv::noArray(), hist, 1, bins, ranges);
+			cv::meanStdDev(gray, mean, stddev);
+			for (int ty = 0; ty < FRAMESTATS_TILES_Y; ty++)
+			{
+				for (int tx = 0; tx < FRAMESTATS_TILES_X; tx++)
+				{
+					const cv::Rect tile(tx * c.width / FRAMESTATS_TILES_X, ty * c.height / FRAMESTATS_TILES_Y,
+						c.width / FRAMESTATS_TILES_X, c.height / FRAMESTATS_TILES_Y);
+					cv::Scalar tileMean, tileStddev;
+					cv::meanStdDev(source(tile), tileMean, tileStddev);
+				}
+			}
+		}
+		const double separateMs = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+		cv::meanStdDev(gray, mean, stddev);
+		HydraHookEngineLogInfo(
+			"opencv-benchmark {\"stage\":\"frame_stats\",\"filter\":\"%s\",\"src\":\"%dx%d\",\"dst\":\"%dx%d\",\"downscale_ms\":%.3f,\"fused_stats_ms\":%.3f,\"separate_stats_ms\":%.3f,\"stats_mpix_per_s\":%.1f,\"mean_error\":%.3f,\"stddev_error\":%.3f}",
+			Downscale_GetFilterName(cv::Size(c.width, c.height), dstSize, c.filter), c.width, c.height, dstSize.width, dstSize.height,
+			plainMs, fusedMs, separateMs, (double)c.width * c.height / (std::max)(fusedMs - plainMs, 1e-3) / 1000.0,
+			std::abs(stats.lumaMean - mean[0]), std::abs(stats.lumaStddev - stddev[0]));
+	}
+
+	/* Score separation: camera pan within a scene, hard cut to another scene, fade to black */
+	cv::RNG rng(94);
+	const cv::Size size(1920, 1080);
+	const cv::Size dstSize = Downscale_GetAnalysisSize(size.width, size.height, 960);
+	const cv::Mat world = Benchmark_MakeSceneFrame(rng, cv::Size(size.width + 64, size.height));
+	const cv::Mat other = Benchmark_MakeSceneFrame(rng, size);
+	cv::Mat faded;
+	world(cv::Rect(0, 0, size.width, size.height)).convertTo(faded, -1, 0.03);
+
+	const auto analyze = [&](const cv::Mat& rgba, FrameStats& out)
+	{
+		cv::Mat gray;
+		Downscale_RgbaToGray(rgba.data, rgba.step, size.width, size.height, dstSize, DownscaleFilterArea, gray, &accumulator);
+		accumulator.Finish(out);
+	};
+
+	FrameStats base, panned, cut, fade;
+	analyze(world(cv::Rect(0, 0, size.width, size.height)), base);
+	analyze(world(cv::Rect(32, 0, size.width, size.height)), panned);
+	analyze(other, cut);
+	analyze(faded, fade);
+
+	HydraHookEngineLogInfo(
+		"opencv-benchmark {\"stage\":\"scene_cut\",\"pan_score\":%.3f,\"cut_score\":%.3f,\"fade_score\":%.3f,\"blank_detected\":%s,\"scene_blank\":%s}",
+		FrameStats_SceneCutScore(base, panned), FrameStats_SceneCutScore(base, cut), FrameStats_SceneCutScore(base, fade),
+		FrameStats_IsBlank(fade) ? "true" : "false", FrameStats_IsBlank(base) ? "true" : "false");
+}
+
+/**
+ * @brief Block-matching motion field on a panning UI-like sequence: predictive vs. exhaustive search per block size.
+ */
+static void Benchmark_MotionField()
+{
+	cv::RNG rng(95);
+	const cv::Size size(960, 540);
+	const cv::Point pan(3, -2);		/* on-screen motion of the content per frame */
+	const int frames = BENCHMARK_ITERATIONS + 1;
+	const cv::Mat world = Benchmark_MakeUiFrame(rng, cv::Size(size.width + frames * std::abs(pan.x), size.height + frames * std::abs(pan.y)));
+
+	std::vector<cv::Mat> sequence;
+	for (int f = 0; f < frames; f++)
+	{
+		const cv::Point origin(frames * pan.x - f * pan.x, -f * pan.y);
+		sequence.push_back(world(cv::Rect(origin, size)).clone());
+	}
+
+	static const int blockSizes[] = { 8, 16, 32 };
+	for (const int blockSize : blockSizes)
+	{
+		for (const MotionSearch search : { MotionSearchPredictive, MotionSearchExhaustive })
+		{
+			MotionEstimator estimator;
+			cv::Mat field;
+			estimator.Estimate(sequence[0], blockSize, search, field);
+
+			double ms = 0.0;
+			size_t correct = 0, inner = 0;
+			for (int f = 1; f < frames; f++)
+			{
+				LARGE_INTEGER start;
+				QueryPerformanceCounter(&start);
+				estimator.Estimate(sequence[(size_t)f], blockSize, search, field);
+				ms += Benchmark_ElapsedMs(start);
+
+				/* border blocks may have moved in from outside the frame */
+				for (int by = 1; by + 1 < field.rows; by++)
+				{
+					for (int bx = 1; bx + 1 < field.cols; bx++)
+					{
+						const cv::Vec2s v = field.at<cv::Vec2s>(by, bx);
+						correct += v[0] == pan.x && v[1] == pan.y;
+						inner++;
+					}
+				}
+			}
+
+			HydraHookEngineLogInfo(
+				"opencv-benchmark {\"stage\":\"motion_field\",\"search\":\"%s\",\"block\":%d,\"grid\":\"%dx%d\",\"ms\":%.3f,\"accuracy\":%.3f}",
+				search == MotionSearchPredictive ? "predictive" : "exhaustive", blockSize, field.cols, field.rows,
+				ms / (frames - 1), inner ? (double)correct / inner : 0.0);
+		}
+	}
+}
+
+/**
+ * @brief Small random-weight conv net standing in for a detector backbone.
+ */
+static cv::dnn::Net Benchmark_MakeConvNet(cv::RNG& rng)
+{
+	cv::dnn::Net net;
+	int channels = 3;
+	for (int i = 0; i < 4; i++)
+	{
+		const int outChannels = 16 << i;
+		cv::dnn::LayerParams conv;
+		conv.name = cv::format("conv%d", i);
+		conv.type = "Convolution";
+		conv.set("kernel_size", 3);
+		conv.set("stride", 2);
+		conv.set("pad", 1);
+		conv.set("num_output", outChannels);
+		conv.set("bias_term", false);
+		const int shape[] = { outChannels, channels, 3, 3 };
+		cv::Mat weights(4, shape, CV_32F);
+		rng.fill(weights, cv::RNG::NORMAL, 0.0, 0.1);
+		conv.blobs.push_back(weights);
+		net.addLayerToPrev(conv.name, conv.type, conv);
+
+		cv::dnn::LayerParams relu;
+		relu.name = cv::format("relu%d", i);
+		relu.type = "ReLU";
+		net.addLayerToPrev(relu.name, relu.type, relu);
+		channels = outChannels;
+	}
+	net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+	net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+	return net;
+}
+
+/**
+ * @brief Fused readback-to-NCHW preprocessing vs. cvtColor + blobFromImage, and forward cost per frame by batch size.
+ */
+static void Benchmark_Inference()
+{
+	InferenceEngine engine;	/* never started; Preprocess only needs the default settings */
+	const InferenceSettings settings;
+	const cv::Size inputSize(settings.inputSize, settings.inputSize);
+
+	static const cv::Size sources[] = { cv::Size(1920, 1080), cv::Size(2560, 1440), cv::Size(3840, 2160) };
+	for (const cv::Size& source : sources)
+	{
+		const cv::Mat rgba = Benchmark_MakeRgbaFrame(source.width, source.height);
+		cv::Mat fused, rgb, separate;
+
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+			engine.Preprocess(rgba.data, rgba.step, source.width, source.height, fused);
+		const double fusedMs = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+		{
+			cv::cvtColor(rgba(cv::Rect(0, 0, source.width, source.height)), rgb, cv::COLOR_RGBA2RGB);
+			cv::resize(rgb, rgb, inputSize, 0, 0, cv::INTER_AREA);
+			separate = cv::dnn::blobFromImage(rgb, 1.0 / 255.0);
+		}
+		const double separateMs = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+		const cv::Mat a(3 * inputSize.height, inputSize.width, CV_32F, fused.ptr<float>());
+		const cv::Mat b(3 * inputSize.height, inputSize.width, CV_32F, separate.ptr<float>());
+		cv::Mat diff;
+		cv::absdiff(a, b, diff);
+		HydraHookEngineLogInfo(
+			"opencv-benchmark {\"stage\":\"inference_preprocess\",\"src\":\"%dx%d\",\"input\":%d,\"fused_ms\":%.3f,\"separate_ms\":%.3f,\"mean_abs_diff\":%.4f}",
+			source.width, source.height, settings.inputSize, fusedMs, separateMs, cv::mean(diff)[0]);
+	}
+
+	cv::RNG rng(96);
+	cv::dnn::Net net = Benchmark_MakeConvNet(rng);
+	for (const int batch : { 1, 2, 4, 8 })
+	{
+		const int dims[] = { batch, 3, settings.inputSize, settings.inputSize };
+		cv::Mat input(4, dims, CV_32F);
+		rng.fill(input, cv::RNG::UNIFORM, -1.0, 1.0);
+		net.setInput(input);
+		net.forward();
+
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+		{
+			net.setInput(input);
+			net.forward();
+		}
+		const double ms = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+		HydraHookEngineLogInfo(
+			"opencv-benchmark {\"stage\":\"inference_batch\",\"batch\":%d,\"threads\":%d,\"batch_ms\":%.3f,\"frame_ms\":%.3f}",
+			batch, cv::getNumThreads(), ms, ms / batch);
+	}
+}
+
+/**
+ * @brief OpenCV reference for one color rule: HSV conversion, inRange and connectedComponentsWithStats.
+ */
+static int Benchmark_ReferenceBlobs(const cv::Mat& rgba, const ColorRule& rule, cv::Mat& rgb, cv::Mat& hsv, cv::Mat& mask)
+{
+	cv::cvtColor(rgba, rgb, cv::COLOR_RGBA2RGB);
+	cv::cvtColor(rgb, hsv, cv::COLOR_RGB2HSV);
+	if (rule.hueMin > rule.hueMax)
+	{
+		cv::Mat upper;
+		cv::inRange(hsv, cv::Scalar(rule.hueMin, rule.satMin, rule.valMin), cv::Scalar(179, rule.satMax, rule.valMax), mask);
+		cv::inRange(hsv, cv::Scalar(0, rule.satMin, rule.valMin), cv::Scalar(rule.hueMax, rule.satMax, rule.valMax), upper);
+		mask |= upper;
+	}
+	else
+		cv::inRange(hsv, cv::Scalar(rule.hueMin, rule.satMin, rule.valMin), cv::Scalar(rule.hueMax, rule.satMax, rule.valMax), mask);
+
+	cv::Mat labels, stats, centroids;
+	const int count = cv::connectedComponentsWithStats(mask, labels, stats, centroids, 8);
+	int blobs = 0;
+	for (int i = 1; i < count; i++)
+		blobs += stats.at<int>(i, cv::CC_STAT_AREA) >= rule.minArea;
+	return blobs;
+}
+
+/**
+ * @brief HSV threshold + run-length labelling on RGBA frames with HUD-like bars and markers, against OpenCV.
+ */
+static void Benchmark_ColorBlobs()
+{
+	cv::RNG rng(97);
+	ColorRule red;
+	red.name = "red";
+	red.hueMin = 170;
+	red.hueMax = 10;
+	red.satMin = 120;
+	red.valMin = 90;
+	red.minArea = 16;
+	ColorRule yellow = red;
+	yellow.name = "yellow";
+	yellow.hueMin = 22;
+	yellow.hueMax = 34;
+	yellow.valMin = 120;
+
+	static const cv::Size sizes[] = { cv::Size(1920, 1080), cv::Size(3840, 2160) };
+	for (const cv::Size& size : sizes)
+	{
+		cv::Mat rgba = Benchmark_MakeRgbaFrame(size.width, size.height)(cv::Rect(0, 0, size.width, size.height)).clone();
+		for (int i = 0; i < 60; i++)
+		{
+			const cv::Point p(rng.uniform(0, size.width), rng.uniform(0, size.height));
+			if (i % 2)
+				cv::rectangle(rgba, cv::Rect(p, cv::Size(rng.uniform(40, 400), rng.uniform(6, 24))), cv::Scalar(220, 30, 40, 255), cv::FILLED);
+			else
+				cv::circle(rgba, p, rng.uniform(4, 20), cv::Scalar(240, 210, 30, 255), cv::FILLED);
+		}
+
+		struct Case { const char* name; std::vector<cv::Rect> rois; };
+		const Case cases[] =
+		{
+			{ "full_frame", { cv::Rect() } },
+			{ "hud_rois", { cv::Rect(0, 0, size.width / 4, size.height / 8), cv::Rect(size.width * 3 / 4, 0, size.width / 4, size.height / 8),
+				cv::Rect(0, size.height * 7 / 8, size.width / 4, size.height / 8), cv::Rect(size.width * 3 / 4, size.height * 7 / 8, size.width / 4, size.height / 8) } },
+		};
+
+		for (const Case& c : cases)
+		{
+			ColorBlobDetector detector;
+			std::vector<ColorRule> rules;
+			for (const cv::Rect& roi : c.rois)
+			{
+				for (ColorRule rule : { red, yellow })
+				{
+					rule.roi = roi;
+					detector.Add(rule);
+					rules.push_back(rule);
+				}
+			}
+
+			std::vector<ColorBlobGroup> groups;
+			detector.Extract(rgba, cv::Point(), groups);
+
+			LARGE_INTEGER start;
+			QueryPerformanceCounter(&start);
+			for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+				detector.Extract(rgba, cv::Point(), groups);
+			const double ms = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+			cv::Mat rgb, hsv, mask;
+			int referenceBlobs = 0;
+			QueryPerformanceCounter(&start);
+			for (int i = 0; i < BENCHMARK_ITERATIONS; i++)
+			{
+				referenceBlobs = 0;
+				for (const ColorRule& rule : rules)
+					referenceBlobs += Benchmark_ReferenceBlobs(rule.roi.empty() ? rgba : rgba(rule.roi), rule, rgb, hsv, mask);
+			}
+			const double referenceMs = Benchmark_ElapsedMs(start) / BENCHMARK_ITERATIONS;
+
+			size_t blobs = 0;
+			for (const auto& group : groups)
+				blobs += group.blobs.size();
+			HydraHookEngineLogInfo(
+				"opencv-benchmark {\"stage\":\"color_blobs\",\"case\":\"%s\",\"size\":\"%dx%d\",\"rules\":%zu,\"ms\":%.3f,\"opencv_ms\":%.3f,\"blobs\":%zu,\"opencv_blobs\":%d}",
+				c.name, size.width, size.height, rules.size(), ms, referenceMs, blobs, referenceBlobs);
+		}
+	}
+}
+
+/**
+ * @brief Per-frame buffers from the default allocator vs. the frame pool, with a few frames in flight like the capture path.
+ */
+static void Benchmark_FramePool()
+{
+	static constexpr int BENCHMARK_FRAMES_IN_FLIGHT = 3;
+
+	struct Case { const char* name; cv::Size size; int type; };
+	static const Case cases[] =
+	{
+		{ "analysis_gray", cv::Size(960, 540), CV_8UC1 },
+		{ "readback_1080p", cv::Size(1920, 1080), CV_8UC4 },
+		{ "readback_1440p", cv::Size(2560, 1440), CV_8UC4 },
+		{ "readback_2160p", cv::Size(3840, 2160), CV_8UC4 },
+	};
+
+	FramePool pool(false);
+	FramePool largePagePool(true);
+	for (const Case& c : cases)
+	{
+		struct Variant { const char* name; FramePool* pool; };	/* nullptr = OpenCV's default allocator */
+		const Variant variants[] =
+		{
+			{ "default", nullptr },
+			{ "pool", &pool },
+			{ "pool_large_pages", &largePagePool },
+		};
+
+		for (const Variant& v : variants)
+		{
+			cv::Mat inFlight[BENCHMARK_FRAMES_IN_FLIGHT];
+			const auto runFrame = [&](int i)
+			{
+				/* A new header per frame, like the Present path; the oldest frame in flight is dropped */
+				cv::Mat frame;
+				frame.allocator = v.pool;
+				frame.create(c.size, c.type);
+				frame.setTo(cv::Scalar::all(i & 0xff));
+				inFlight[i % BENCHMARK_FRAMES_IN_FLIGHT] = frame;
+			};
+
+			for (int i = 0; i < BENCHMARK_FRAMES_IN_FLIGHT * 2; i++)
+				runFrame(i);
+			const FramePoolStats before = v.pool ? v.pool->GetStats() : FramePoolStats();
+
+			LARGE_INTEGER start;
+			QueryPerformanceCounter(&start);
+			for (int i = 0; i < BENCHMARK_ITERATIONS * 5; i++)
+				runFrame(i);
+			const double ms = Benchmark_ElapsedMs(start) / (BENCHMARK_ITERATIONS * 5);
+
+			const FramePoolStats after = v.pool ? v.pool->GetStats() : FramePoolStats();
+			const uint64_t allocations = v.pool ? after.allocations - before.allocations : (uint64_t)BENCHMARK_ITERATIONS * 5;
+			HydraHookEngineLogInfo(
+				"opencv-benchmark {\"stage\":\"frame_pool\",\"case\":\"%s\",\"size\":\"%dx%d\",\"allocator\":\"%s\",\"ms\":%.3f,\"steady_allocations\":%llu,\"large_page_buffers\":%zu,\"live_mb\":%.1f}",
+				c.name, c.size.width, c.size.height, v.name, ms, (unsigned long long)allocations,
+				after.largePageBuffers, after.liveBytes / (1024.0 * 1024.0));
+		}
+	}
+}
+
+struct Benchmark_StreamViewer
+{
+	uint64_t frames = 0;
+	uint64_t bytes = 0;
+};
+
+/**
+ * @brief Minimal MJPEG viewer: splits the multipart stream by Content-Length, optionally slow to consume.
+ */
+static void Benchmark_StreamViewerProc(unsigned short port, DWORD frameDelayMs, Benchmark_StreamViewer* out)
+{
+	const SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (s == INVALID_SOCKET)
+		return;
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	static const char request[] = "GET / HTTP/1.0\r\n\r\n";
+	if (connect(s, (const sockaddr*)&address, sizeof(address)) == SOCKET_ERROR
+		|| send(s, request, sizeof(request) - 1, 0) == SOCKET_ERROR)
+	{
+		closesocket(s);
+		return;
+	}
+
+	std::string pending;
+	std::vector<char> chunk(64 * 1024);
+	size_t bodyLeft = 0;	/* JPEG bytes plus the trailing CRLF of the current part */
+	for (;;)
+	{
+		const int n = recv(s, chunk.data(), (int)chunk.size(), 0);
+		if (n <= 0)
+			break;
+		out->bytes += (uint64_t)n;
+		pending.append(chunk.data(), (size_t)n);
+
+		for (;;)
+		{
+			if (bodyLeft)
+			{
+				const size_t take = (std::min)(bodyLeft, pending.size());
+				pending.erase(0, take);
+				bodyLeft -= take;
+				if (bodyLeft)
+					break;
+				out->frames++;
+				if (frameDelayMs)
+					Sleep(frameDelayMs);
+				continue;
+			}
+			/* The response header has no Content-Length and is skipped like an empty part */
+			const size_t end = pending.find("\r\n\r\n");
+			if (end == std::string::npos)
+				break;
+			const size_t length = pending.find("Content-Length: ");
+			if (length != std::string::npos && length < end)
+				bodyLeft = strtoul(pending.c_str() + length + 16, nullptr, 10) + 2;
+			pending.erase(0, end + 4);
+		}
+	}
+	closesocket(s);
+}
+
+/**
+ * @brief MJPEG server throughput with a fast and a deliberately slow local viewer, and what publishing costs the worker.
+ */
+static void Benchmark_FrameStream()
+{
+	static constexpr double BENCHMARK_STREAM_MS = 2000.0;
+	static constexpr DWORD BENCHMARK_STREAM_SLOW_VIEWER_MS = 50;
+
+	struct Case { const char* name; cv::Size size; bool color; };
+	static const Case cases[] =
+	{
+		{ "gray_annotated", cv::Size(960, 540), false },
+		{ "bgr_1080p", cv::Size(1920, 1080), true },
+	};
+
+	cv::RNG rng(98);
+	for (const Case& c : cases)
+	{
+		std::vector<cv::Mat> frames;
+		for (int i = 0; i < 4; i++)
+		{
+			cv::Mat converted;
+			cv::cvtColor(Benchmark_MakeSceneFrame(rng, c.size), converted, c.color ? cv::COLOR_RGBA2BGR : cv::COLOR_RGBA2GRAY);
+			frames.push_back(converted);
+		}
+
+		auto results = std::make_shared<PerceptionResults>();
+		for (int i = 0; i < 300; i++)
+		{
+			const cv::Point2f p(rng.uniform(0.0f, (float)c.size.width), rng.uniform(0.0f, (float)c.size.height));
+			results->prevPts.push_back(p);
+			results->currPts.push_back(p + cv::Point2f(rng.uniform(-4.0f, 4.0f), rng.uniform(-4.0f, 4.0f)));
+		}
+		for (int i = 0; i < 3; i++)
+		{
+			TrackedObject object;
+			object.id = i + 1;
+			object.box = cv::Rect2f(100.0f + 200.0f * i, 100.0f, 80.0f, 120.0f);
+			results->trackedObjects.push_back(object);
+		}
+
+		FrameStreamSettings settings;
+		settings.port = 0;
+		FrameBus bus;
+		FrameStreamServer server;
+		if (!server.Start(settings, bus))
+			return;
+
+		Benchmark_StreamViewer fast, slow;
+		std::thread fastThread(Benchmark_StreamViewerProc, server.Port(), 0, &fast);
+		std::thread slowThread(Benchmark_StreamViewerProc, server.Port(), BENCHMARK_STREAM_SLOW_VIEWER_MS, &slow);
+
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		while (server.GetStats().clients < 2 && Benchmark_ElapsedMs(start) < 1000.0)
+			Sleep(1);
+
+		double publishMs = 0.0, publishMaxMs = 0.0;
+		uint64_t published = 0;
+		QueryPerformanceCounter(&start);
+		while (Benchmark_ElapsedMs(start) < BENCHMARK_STREAM_MS)
+		{
+			LARGE_INTEGER publishStart;
+			QueryPerformanceCounter(&publishStart);
+			BusFrame frame;
+			frame.image = frames[published % frames.size()];
+			if (!c.color)
+				frame.results = results;
+			bus.Publish(std::move(frame));
+			const double ms = Benchmark_ElapsedMs(publishStart);
+			publishMs += ms;
+			publishMaxMs = (std::max)(publishMaxMs, ms);
+			published++;
+			Sleep(1);
+		}
+		const double seconds = Benchmark_ElapsedMs(start) / 1000.0;
+
+		/* Let the viewers take what is in flight, then disconnect them */
+		Sleep(100);
+		const FrameStreamStats stats = server.GetStats();
+		server.Stop();
+		fastThread.join();
+		slowThread.join();
+
+		HydraHookEngineLogInfo(
+			"opencv-benchmark {\"stage\":\"frame_stream\",\"case\":\"%s\",\"size\":\"%dx%d\",\"published_fps\":%.1f,\"encoded_fps\":%.1f,\"encode_ms\":%.3f,\"fast_viewer_fps\":%.1f,\"slow_viewer_fps\":%.1f,\"fast_viewer_mbps\":%.2f,\"publish_us\":%.1f,\"publish_max_us\":%.1f,\"superseded\":%llu,\"skipped\":%llu}",
+			c.name, c.size.width, c.size.height, published / seconds, stats.encoded / seconds, stats.encodeMs,
+			fast.frames / seconds, slow.frames / seconds, fast.bytes * 8.0 / seconds / 1e6,
+			published ? publishMs * 1000.0 / published : 0.0, publishMaxMs * 1000.0,
+			(unsigned long long)stats.superseded, (unsigned long long)stats.skipped);
+	}
+}
+
+/**
+ * @brief Fan-out of pooled 1080p frames to N consumers over the frame bus vs. a private copy per consumer.
+ */
+static void Benchmark_FrameBus()
+{
+	static constexpr int BENCHMARK_BUS_FRAMES = 240;
+	static constexpr size_t BENCHMARK_BUS_DEPTH = 2;
+	static const int consumerCounts[] = { 1, 2, 4, 8 };
+	const cv::Size size(1920, 1080);
+
+	for (const int consumers : consumerCounts)
+	{
+		for (const bool copyPerConsumer : { false, true })
+		{
+			FramePool pool(false);
+			/* The copy baseline gives every consumer its own bus so each one receives a private frame */
+			std::vector<FrameBus> buses(copyPerConsumer ? consumers : 1);
+			std::vector<FrameSubscriptionPtr> subscriptions;
+			for (int i = 0; i < consumers; i++)
+				subscriptions.push_back(buses[copyPerConsumer ? i : 0].Subscribe("benchmark", BENCHMARK_BUS_DEPTH, FrameDropOldest));
+
+			std::atomic<uint64_t> consumed{ 0 };
+			std::vector<std::thread> threads;
+			for (const FrameSubscriptionPtr& subscription : subscriptions)
+			{
+				threads.emplace_back([subscription, &consumed]
+				{
+					/* Read-only work on the shared view, roughly a cheap analysis stage */
+					BusFramePtr frame;
+					while (subscription->Wait(frame))
+					{
+						cv::mean(frame->image);
+						consumed++;
+						frame.reset();
+					}
+				});
+			}
+
+			double publishMs = 0.0, publishMaxMs = 0.0;
+			size_t maxLiveBytes = 0;
+			uint64_t warmAllocations = 0;
+			LARGE_INTEGER start;
+			QueryPerformanceCounter(&start);
+			for (int i = 0; i < BENCHMARK_BUS_FRAMES; i++)
+			{
+				if (i == BENCHMARK_BUS_FRAMES / 4)
+					warmAllocations = pool.GetStats().allocations;
+
+				/* Stands in for the readback writing a new pooled frame */
+				cv::Mat image;
+				image.allocator = &pool;
+				image.create(size, CV_8UC4);
+				image.setTo(cv::Scalar::all(i & 0xff));
+
+				LARGE_INTEGER publishStart;
+				QueryPerformanceCounter(&publishStart);
+				if (copyPerConsumer)
+				{
+					for (FrameBus& bus : buses)
+					{
+						BusFrame frame;
+						frame.image.allocator = &pool;
+						image.copyTo(frame.image);
+						bus.Publish(std::move(frame));
+					}
+				}
+				else
+				{
+					BusFrame frame;
+					frame.image = image;
+					buses[0].Publish(std::move(frame));
+				}
+				const double ms = Benchmark_ElapsedMs(publishStart);
+				publishMs += ms;
+				publishMaxMs = (std::max)(publishMaxMs, ms);
+				maxLiveBytes = (std::max)(maxLiveBytes, pool.GetStats().liveBytes);
+			}
+			const double seconds = Benchmark_ElapsedMs(start) / 1000.0;
+
+			uint64_t delivered = 0, dropped = 0;
+			for (const FrameSubscriptionPtr& subscription : subscriptions)
+			{
+				const FrameSubscriptionStats stats = subscription->GetStats();
+				delivered += stats.delivered;
+				dropped += stats.dropped;
+			}
+			const uint64_t steadyAllocations = pool.GetStats().allocations - warmAllocations;
+			for (FrameBus& bus : buses)
+				bus.Close();
+			for (std::thread& thread : threads)
+				thread.join();
+
+			HydraHookEngineLogInfo(
+				"opencv-benchmark {\"stage\":\"frame_bus\",\"case\":\"%s\",\"consumers\":%d,\"size\":\"%dx%d\",\"publish_us\":%.1f,\"publish_max_us\":%.1f,\"published_fps\":%.1f,\"consumed_fps\":%.1f,\"delivered\":%llu,\"dropped\":%llu,\"steady_allocations\":%llu,\"peak_live_mb\":%.1f}",
+				copyPerConsumer ? "copy_per_consumer" : "shared", consumers, size.width, size.height,
+				publishMs * 1000.0 / BENCHMARK_BUS_FRAMES, publishMaxMs * 1000.0, BENCHMARK_BUS_FRAMES / seconds,
+				(uint64_t)consumed / seconds, (unsigned long long)delivered, (unsigned long long)dropped,
+				(unsigned long long)steadyAllocations, maxLiveBytes / (1024.0 * 1024.0));
+		}
+	}
+}
+
+/**
+ * @brief Runs every stage benchmark on synthetic data; called on the capture worker (F9).
+ */
+void Benchmark_RunAll()
+{
+	HydraHookEngineLogInfo("HydraHook-OpenCV: Running benchmarks (%d iterations per case)", BENCHMARK_ITERATIONS);
+	Benchmark_Downscale();
+	Benchmark_FrameHash();
+	Benchmark_TemplateMatch();
+	Benchmark_Tracker();
+	Benchmark_Hamming();
+	Benchmark_FrameStats();
+	Benchmark_MotionField();
+	Benchmark_Inference();
+	Benchmark_ColorBlobs();
+	Benchmark_FrameStream();
+	Benchmark_FramePool();
+	Benchmark_FrameBus();
+	HydraHookEngineLogInfo("HydraHook-OpenCV: Benchmarks done");
+}
@@ -26,14 +26,26 @@ SOFTWARE.
 #include <Windows.h>
 
 #include "Capture.h"
+#include "Benchmark.h"
+#include "ColorBlobs.h"
+#include "Downscale.h"
+#include "FrameBus.h"
+#include "FrameHash.h"
+#include "FramePool.h"
+#include "FrameStream.h"
+#include "FrameTiming.h"
+#include "Inference.h"
 #include "Overlay.h"
 #include "Perception.h"
+#include "TemplateMatch.h"
+#include "Tracker.h"
 
 #include <HydraHook/Engine/HydraHookDirect3D11.h>
 #include <HydraHook/Engine/HydraHookDirect3D12.h>
 #include <HydraHook/Engine/HydraHookCore.h>
 
 #include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
 
 #include <imgui.h>
 #include <imgui_impl_win32.h>
@@ -41,30 +53,90 @@ SOFTWARE.
 
 #include <dxgi1_4.h>
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstdio>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN64
 #include <imgui_impl_dx12.h>
 #endif
 
 static constexpr UINT CAPTURE_NUM_BUFFERS = 2;
-
+/* Width of the gray frame handed to the perception pipeline (height keeps the aspect ratio); 0 = native */
+static constexpr int CAPTURE_ANALYSIS_WIDTH = 960;
+static constexpr DownscaleFilter CAPTURE_ANALYSIS_FILTER = DownscaleFilterArea;
+/* Scene-cut score (histogram / tile color distance to the previous frame) that forces re-detection */
+static constexpr float CAPTURE_SCENE_CUT_THRESHOLD = 0.5f;
+/* Near-duplicate filter: frames within this Hamming distance of any stored fingerprint are dropped */
+static constexpr FrameHashKind CAPTURE_DEDUP_HASH = FrameHashPerceptual;
+static constexpr int CAPTURE_DEDUP_MAX_DISTANCE = 6;
+static constexpr size_t CAPTURE_DEDUP_CAPACITY = 1 << 20;
+/* Directory unique analysis frames are written to as PNG; nullptr disables dataset collection */
+static const char* const CAPTURE_DATASET_DIRECTORY = nullptr;
+/* Frames the dataset writer may fall behind by before new frames are skipped */
+static constexpr size_t CAPTURE_DATASET_QUEUE_DEPTH = 8;
+/* Directory of gray or color PNG UI templates at swap chain resolution; nullptr disables template matching */
+static const char* const CAPTURE_TEMPLATE_DIRECTORY = nullptr;
+/* Upper bound for extrapolating results to present time; older results are drawn where they were */
+static constexpr double CAPTURE_MAX_EXTRAPOLATION_MS = 100.0;
+/* ONNX model (float or int8 quantized) run on the CPU; nullptr disables the inference stage.
+   Its input is built from the mapped readback, i.e. on the D3D11 render thread (up to 16 taps per input pixel) */
+static const char* const CAPTURE_INFERENCE_MODEL = nullptr;
+static constexpr InferenceTask CAPTURE_INFERENCE_TASK = InferenceTaskDetection;
+static constexpr int CAPTURE_INFERENCE_INPUT_SIZE = 320;
+static constexpr int CAPTURE_INFERENCE_THREADS = 2;
+static constexpr int CAPTURE_INFERENCE_MAX_BATCH = 4;
+static constexpr float CAPTURE_INFERENCE_LATENCY_BUDGET_MS = 66.0f;
+/* HSV blob extraction on the full-resolution readback, e.g. for HUD bars and markers */
+static constexpr bool CAPTURE_COLOR_BLOBS = false;
+static const ColorRule CAPTURE_COLOR_RULES[] =
+{
+	/* name, roi (swap chain, required), hue min/max (0-179, wraps), sat min/max, val min/max, min area */
+	/* Example ROIs: the bottom HUD band of a 1920x1080 swap chain; keep their bounding box small, it is copied per frame */
+	{ "red", cv::Rect(0, 900, 640, 180), 170, 10, 120, 255, 90, 255, 16 },
+	{ "yellow", cv::Rect(1280, 900, 640, 180), 22, 34, 120, 255, 120, 255, 16 },
+};
+/* Back full-resolution frame buffers with large pages; needs the "Lock pages in memory" user right */
+static constexpr bool CAPTURE_FRAME_POOL_LARGE_PAGES = false;
+/* Annotated analysis frames as MJPEG on http://127.0.0.1:<port>/, 0 disables */
+static constexpr unsigned short CAPTURE_STREAM_PORT = 0;
+static constexpr int CAPTURE_STREAM_ENCODER_THREADS = 2;
+static constexpr int CAPTURE_STREAM_QUALITY = 75;
+
+/* Never destroyed: Mats in other modules' statics can be released after this module's globals */
+static FramePool* const g_framePool = new FramePool(CAPTURE_FRAME_POOL_LARGE_PAGES);
 static std::mutex g_resultsMutex;
 static PerceptionResults g_results;
 static std::atomic<bool> g_workerRunning{ true };
 static std::atomic<bool> g_captureShutdownDone{ false };
 static std::thread* g_workerThread = nullptr;
+static std::thread* g_readbackThread = nullptr;
+static std::thread* g_recorderThread = nullptr;
 static std::atomic<bool> g_showOverlay{ true };
+static std::atomic<bool> g_benchmarkRequested{ false };
+static std::atomic<bool> g_latencyCompensation{ true };
+static FrameHashIndex g_dedupIndex;
+static TemplateMatcher g_templateMatcher;
+static InferenceEngine g_inference;
+static ColorBlobDetector g_colorBlobs;
+static FrameStreamServer g_stream;
+/* Frames at readback, and the same frames again once perception attached its results */
+static FrameBus g_captureBus;
+static FrameBus g_analysisBus;
+static CorrelationTracker g_tracker;
 
 /* D3D11 */
 static ID3D11Texture2D* g_d3d11_staging[CAPTURE_NUM_BUFFERS] = {};
 static ID3D11Query* g_d3d11_query[CAPTURE_NUM_BUFFERS] = {};
+static FrameStatsAccumulator g_d3d11_statsAccumulator;
 static UINT g_d3d11_captureWidth = 0;
 static UINT g_d3d11_captureHeight = 0;
 static UINT g_d3d11_frameCounter = 0;
+static FrameTag g_d3d11_captureTag[CAPTURE_NUM_BUFFERS] = {};
 static ID3D11RenderTargetView* g_d3d11_mainRTV = nullptr;
 static bool g_d3d11_imguiInitialized = false;
 
@@ -87,6 +159,7 @@ static UINT g_d3d12_captureWidth = 0;
 static UINT g_d3d12_captureHeight = 0;
 static UINT g_d3d12_captureRowPitch = 0;
 static UINT g_d3d12_frameCounter = 0;
+static FrameTag g_d3d12_captureTag[CAPTURE_NUM_BUFFERS] = {};
 static UINT64 g_d3d12_fenceValueForReadback[CAPTURE_NUM_BUFFERS] = {};
 static bool g_d3d12_imguiInitialized = false;
 #ifdef _WIN64
@@ -98,13 +171,14 @@ static UINT g_d3d12_srvDescriptorCount = 0;
 /* Worker sync */
 static std::condition_variable g_workerCv;
 static std::mutex g_workerMutex;
-static int g_pendingApi = 0;
-static cv::Mat g_pendingD3D11Frame;
 static UINT g_pendingWidth = 0;
 static UINT g_pendingHeight = 0;
+static FrameTag g_pendingTag;
 static UINT64 g_pendingD3D12FenceValue = 0;
 static ID3D12Resource* g_pendingD3D12Readback = nullptr;
 static UINT g_pendingD3D12RowPitch = 0;
+static std::vector<cv::Rect2f> g_pendingTrackTargets;	/* swap chain coordinates */
+static bool g_pendingTrackClear = false;
 
 static bool D3D11_CreateCaptureResources(ID3D11Device* pDevice, UINT width, UINT height);
 static void D3D11_ReleaseCaptureResources();
@@ -121,96 +195,282 @@ static void EvtHydraHookD3D12PrePresent(IDXGISwapChain* pSwapChain, UINT SyncInt
 static void EvtHydraHookD3D12PreResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount, UINT Width, UINT Height, DXGI_FORMAT NewFormat, UINT SwapChainFlags, PHYDRAHOOK_EVT_PRE_EXTENSION Extension);
 static void EvtHydraHookD3D12PostResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount, UINT Width, UINT Height, DXGI_FORMAT NewFormat, UINT SwapChainFlags, PHYDRAHOOK_EVT_POST_EXTENSION Extension);
 
-static void WorkerThreadProc()
+static void Capture_PollHotkeys()
+{
+	bool compensate = g_latencyCompensation;
+	Overlay_ToggleState(VK_F8, compensate);
+	g_latencyCompensation = compensate;
+
+	bool runBenchmark = false;
+	Overlay_ToggleState(VK_F9, runBenchmark);
+	if (runBenchmark)
+		g_benchmarkRequested = true;
+}
+
+/**
+ * @brief Fingerprints an analysis frame and records it unless it is a near-duplicate of a stored one.
+ */
+static void Capture_DeduplicateFrame(const cv::Mat& frame, PerceptionResults& out)
+{
+	const FrameFingerprint fp = FrameHash_Compute(frame);
+	const uint64_t hash = FrameHash_Select(fp, CAPTURE_DEDUP_HASH);
+	const int nearest = g_dedupIndex.FindNearest(hash, CAPTURE_DEDUP_MAX_DISTANCE);
+
+	out.frameHash = hash;
+	out.dedupDistance = nearest;
+	out.duplicateFrame = nearest != -1;
+
+	if (!out.duplicateFrame)
+	{
+		if (g_dedupIndex.Size() >= CAPTURE_DEDUP_CAPACITY)
+		{
+			HydraHookEngineLogWarning("HydraHook-OpenCV: Dedup index reached %zu fingerprints, clearing", g_dedupIndex.Size());
+			g_dedupIndex.Clear();
+		}
+		g_dedupIndex.Insert(hash);
+	}
+	out.dedupStored = g_dedupIndex.Size();
+}
+
+/**
+ * @brief Applies overlay target selections, then advances every tracked object to this frame.
+ */
+static void Capture_UpdateTrackedObjects(const cv::Mat& frame, PerceptionResults& out)
+{
+	std::vector<cv::Rect2f> added;
+	bool clear = false;
+	{
+		std::lock_guard<std::mutex> lock(g_workerMutex);
+		added.swap(g_pendingTrackTargets);
+		clear = g_pendingTrackClear;
+		g_pendingTrackClear = false;
+	}
+
+	if (clear)
+		g_tracker.Clear();
+	for (const cv::Rect2f& box : added)
+	{
+		const float s = out.frameScale;
+		const int id = g_tracker.Add(frame, cv::Rect2f(box.x / s, box.y / s, box.width / s, box.height / s));
+		if (id < 0)
+			HydraHookEngineLogWarning("HydraHook-OpenCV: Selection %.0fx%.0f is too small to track", box.width, box.height);
+		else
+			HydraHookEngineLogInfo("HydraHook-OpenCV: Tracking object %d", id);
+	}
+
+	g_tracker.Update(frame, out.trackedObjects);
+}
+
+/**
+ * @brief Draws the latest results, extrapolated from their capture time to this Present.
+ */
+static void Capture_DrawOverlay(float width, float height, uint64_t presentIndex)
+{
+	PerceptionResults res;
+	Capture_GetResults(res);
+	FrameTiming_OnDisplay(res.tag, presentIndex);
+
+	float aheadMs = 0.0f;
+	if (g_latencyCompensation && res.tag.captureTicks)
+		aheadMs = (float)(std::min)(FrameTiming_ToMs((int64_t)(FrameTiming_Now() - res.tag.captureTicks)), CAPTURE_MAX_EXTRAPOLATION_MS);
+
+	Overlay_Render(width, height, res, aheadMs);
+	Overlay_DrawDebugHUD(res);
+}
+
+/**
+ * @brief Bus frame from a mapped R8G8B8A8 readback: analysis frame, statistics and the readback-only extras.
+ */
+static void Capture_BuildBusFrame(const uint8_t* pData, size_t rowPitch, UINT width, UINT height, FrameStatsAccumulator& statsAccumulator, BusFrame& out)
 {
+	out.frameSize = cv::Size((int)width, (int)height);
+	out.image.allocator = out.inferenceBlob.allocator = out.colorCrop.allocator = g_framePool;
+
+	/* Gray conversion, downscale and frame statistics in one pass; each mapped pixel is read once */
+	Downscale_RgbaToGray(pData, rowPitch, (int)width, (int)height,
+		Downscale_GetAnalysisSize((int)width, (int)height, CAPTURE_ANALYSIS_WIDTH), CAPTURE_ANALYSIS_FILTER, out.image, &statsAccumulator);
+	statsAccumulator.Finish(out.stats);
+	if (g_inference.IsRunning())
+		g_inference.Preprocess(pData, rowPitch, (int)width, (int)height, out.inferenceBlob);
+	/* Only the ROI bounds are copied; blob extraction runs on the worker */
+	const cv::Rect area = g_colorBlobs.Size() ? g_colorBlobs.CropArea(out.frameSize) : cv::Rect();
+	if (!area.empty())
+	{
+		cv::Mat((int)height, (int)width, CV_8UC4, (void*)pData, rowPitch)(area).copyTo(out.colorCrop);
+		out.colorOrigin = area.tl();
+	}
+}
+
+/**
+ * @brief Waits for D3D12 readbacks off the render thread and publishes them on the capture bus.
+ */
+static void ReadbackThreadProc()
+{
+	FrameStatsAccumulator statsAccumulator;
+
 	while (g_workerRunning)
 	{
-		int api = 0;
-		UINT64 d3d12FenceVal = 0;
-		ID3D12Resource* pD3D12Readback = nullptr;
-		UINT width = 0, height = 0;
-		UINT rowPitch = 0;
+		UINT64 fenceValue = 0;
+		ID3D12Resource* pReadback = nullptr;
+		UINT width = 0, height = 0, rowPitch = 0;
+		FrameTag tag;
 
 		{
 			std::unique_lock<std::mutex> lock(g_workerMutex);
-			g_workerCv.wait(lock, [] { return !g_workerRunning || g_pendingApi != 0; });
+			g_workerCv.wait(lock, [] { return !g_workerRunning || g_pendingD3D12Readback != nullptr; });
 			if (!g_workerRunning)
 				break;
 
-			api = g_pendingApi;
+			pReadback = g_pendingD3D12Readback;
+			g_pendingD3D12Readback = nullptr;
+			fenceValue = g_pendingD3D12FenceValue;
 			width = g_pendingWidth;
 			height = g_pendingHeight;
-			rowPitch = width * 4;
-			if (api == 12)
-				rowPitch = g_pendingD3D12RowPitch;
-			g_pendingApi = 0;
-
-			if (api == 12)
-			{
-				d3d12FenceVal = g_pendingD3D12FenceValue;
-				pD3D12Readback = g_pendingD3D12Readback;
-			}
+			rowPitch = g_pendingD3D12RowPitch ? g_pendingD3D12RowPitch : width * 4;
+			tag = g_pendingTag;
 		}
 
-		if (width == 0 || height == 0)
-			continue;
-
-		cv::Mat frame;
-
-		if (api == 11)
-		{
-			{
-				std::lock_guard<std::mutex> lock(g_workerMutex);
-				if (!g_pendingD3D11Frame.empty())
-				{
-					frame = g_pendingD3D11Frame;
-					g_pendingD3D11Frame.release();
-				}
-			}
-		}
 #ifdef _WIN64
-		else if (api == 12 && pD3D12Readback && g_d3d12_pFence && g_d3d12_hFenceEvent)
+		if (width && height && g_d3d12_pFence && g_d3d12_hFenceEvent)
 		{
-			g_d3d12_pFence->SetEventOnCompletion(d3d12FenceVal, g_d3d12_hFenceEvent);
+			g_d3d12_pFence->SetEventOnCompletion(fenceValue, g_d3d12_hFenceEvent);
 			while (g_workerRunning && WaitForSingleObject(g_d3d12_hFenceEvent, 200) == WAIT_TIMEOUT)
 				;
-			if (!g_workerRunning)
-			{
-				pD3D12Readback->Release();
-				continue;
-			}
 
-			const UINT rp = (rowPitch != 0) ? rowPitch : (width * 4);
-			const SIZE_T readSize = (SIZE_T)height * (SIZE_T)rp;
-			D3D12_RANGE readRange = { 0, readSize };
+			D3D12_RANGE readRange = { 0, (SIZE_T)height * (SIZE_T)rowPitch };
 			void* pData = nullptr;
-			if (SUCCEEDED(pD3D12Readback->Map(0, &readRange, &pData)))
+			if (g_workerRunning && SUCCEEDED(pReadback->Map(0, &readRange, &pData)))
 			{
-				frame.create((int)height, (int)width, CV_8UC3);
-				for (UINT y = 0; y < height; y++)
-				{
-					const uint8_t* src = (const uint8_t*)pData + y * rp;
-					uint8_t* dst = frame.ptr((int)y);
-					for (UINT x = 0; x < width; x++)
-					{
-						dst[x * 3 + 0] = src[x * 4 + 2];
-						dst[x * 3 + 1] = src[x * 4 + 1];
-						dst[x * 3 + 2] = src[x * 4 + 0];
-					}
-				}
-				pD3D12Readback->Unmap(0, nullptr);
+				BusFrame frame;
+				frame.tag = tag;
+				Capture_BuildBusFrame((const uint8_t*)pData, rowPitch, width, height, statsAccumulator, frame);
+				pReadback->Unmap(0, nullptr);
+				g_captureBus.Publish(std::move(frame));
 			}
-			pD3D12Readback->Release();
 		}
 #endif
-		if (!frame.empty())
+		pReadback->Release();
+	}
+}
+
+/**
+ * @brief Writes analyzed, non-duplicate frames to the dataset directory, off the perception worker.
+ */
+static void RecorderThreadProc(FrameSubscriptionPtr frames)
+{
+	UINT written = 0;
+	BusFramePtr frame;
+	while (frames->Wait(frame))
+	{
+		const PerceptionResults* res = frame->results.get();
+		if (!res || res->blankFrame || res->duplicateFrame)
+			continue;
+
+		char path[MAX_PATH];
+		sprintf_s(path, "%s\\frame-%08u-%016llx.png", CAPTURE_DATASET_DIRECTORY, written++, (unsigned long long)res->frameHash);
+		try
 		{
-			PerceptionResults out;
-			RunPerceptionPipeline(frame, out);
-			{
-				std::lock_guard<std::mutex> lock(g_resultsMutex);
-				g_results = out;
-			}
+			cv::imwrite(path, frame->image);
+		}
+		catch (const cv::Exception& ex)
+		{
+			HydraHookEngineLogError("HydraHook-OpenCV: Writing dataset frame %s failed: %s", path, ex.what());
+		}
+	}
+
+	const FrameSubscriptionStats stats = frames->GetStats();
+	if (stats.dropped)
+		HydraHookEngineLogWarning("HydraHook-OpenCV: Recorder dropped %llu of %llu frames",
+			(unsigned long long)stats.dropped, (unsigned long long)(stats.delivered + stats.dropped));
+}
+
+/**
+ * @brief Perception subscriber: analyzes the newest captured frame and republishes it with its results.
+ */
+static void WorkerThreadProc(FrameSubscriptionPtr frames)
+{
+	FrameTag prevTag;
+	FrameStats prevStats;
+
+	if (CAPTURE_TEMPLATE_DIRECTORY && g_templateMatcher.Size() == 0)
+	{
+		const size_t loaded = g_templateMatcher.LoadDirectory(CAPTURE_TEMPLATE_DIRECTORY);
+		HydraHookEngineLogInfo("HydraHook-OpenCV: Loaded %zu UI templates from %s", loaded, CAPTURE_TEMPLATE_DIRECTORY);
+	}
+
+	if (CAPTURE_INFERENCE_MODEL && !g_inference.IsRunning())
+	{
+		InferenceSettings settings;
+		settings.modelPath = CAPTURE_INFERENCE_MODEL;
+		settings.task = CAPTURE_INFERENCE_TASK;
+		settings.inputSize = CAPTURE_INFERENCE_INPUT_SIZE;
+		settings.threads = CAPTURE_INFERENCE_THREADS;
+		settings.maxBatch = CAPTURE_INFERENCE_MAX_BATCH;
+		settings.latencyBudgetMs = CAPTURE_INFERENCE_LATENCY_BUDGET_MS;
+		g_inference.Start(settings);
+	}
+
+	if (CAPTURE_STREAM_PORT && !g_stream.IsRunning())
+	{
+		FrameStreamSettings settings;
+		settings.port = CAPTURE_STREAM_PORT;
+		settings.encoderThreads = CAPTURE_STREAM_ENCODER_THREADS;
+		settings.quality = CAPTURE_STREAM_QUALITY;
+		g_stream.Start(settings, g_analysisBus);
+	}
+
+	while (g_workerRunning)
+	{
+		if (g_benchmarkRequested.exchange(false))
+			Benchmark_RunAll();
+
+		/* The timeout only bounds how long a benchmark request waits while no frames arrive */
+		BusFramePtr captured;
+		if (!frames->Wait(captured, 100) || captured->image.empty())
+			continue;
+
+		const cv::Mat& frame = captured->image;
+		const FrameTag& tag = captured->tag;
+
+		PerceptionResults out;
+		out.frameStats = captured->stats;
+		out.sceneCutScore = FrameStats_SceneCutScore(prevStats, captured->stats);
+		out.sceneCut = out.sceneCutScore >= CAPTURE_SCENE_CUT_THRESHOLD;
+		out.blankFrame = FrameStats_IsBlank(captured->stats);
+		prevStats = captured->stats;
+		if (out.sceneCut)
+			g_templateMatcher.ResetTracking();
+
+		/* Fades and loading screens carry nothing to track; keep the expensive stages idle */
+		if (!out.blankFrame)
+			RunPerceptionPipeline(frame, out, out.sceneCut);
+		out.frameScale = (float)captured->frameSize.width / (float)frame.cols;
+		out.tag = tag;
+		out.frameIntervalMs = prevTag.captureTicks ? (float)FrameTiming_ToMs((int64_t)(tag.captureTicks - prevTag.captureTicks)) : 0.0f;
+		prevTag = tag;
+		if (!out.blankFrame)
+		{
+			Capture_DeduplicateFrame(frame, out);
+			Capture_UpdateTrackedObjects(frame, out);
+			if (g_templateMatcher.Size())
+				g_templateMatcher.Match(frame, out.frameScale, out.templateMatches);
+			g_inference.Submit(captured->inferenceBlob, tag, frame.size());
+			if (!captured->colorCrop.empty())
+				g_colorBlobs.Extract(captured->colorCrop, captured->colorOrigin, out.colorBlobs);
+		}
+		g_inference.GetLatest(out.inference);
+
+		/* Same pooled buffers, now with the results attached, for the stream, recorder and analytics */
+		if (g_analysisBus.HasSubscribers())
+		{
+			BusFrame analyzed = *captured;
+			analyzed.results = std::make_shared<const PerceptionResults>(out);
+			g_analysisBus.Publish(std::move(analyzed));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(g_resultsMutex);
+			g_results = std::move(out);
 		}
 	}
 }
@@ -219,13 +479,29 @@ void Capture_SetupCallbacks(PHYDRAHOOK_ENGINE EngineHandle, HYDRAHOOK_D3D_VERSIO
 {
 	HydraHookEngineLogInfo("HydraHook-OpenCV: Loading");
 
+	FrameTiming_Calibrate();
+
+	/* Before the worker starts; the Present paths read the rules for cropping */
+	if (CAPTURE_COLOR_BLOBS && !g_colorBlobs.Size())
+	{
+		for (const ColorRule& rule : CAPTURE_COLOR_RULES)
+		{
+			if (!g_colorBlobs.Add(rule))
+				HydraHookEngineLogWarning("HydraHook-OpenCV: color rule \"%s\" has no ROI, skipped", rule.name.c_str());
+		}
+	}
+
 	{
 		std::lock_guard<std::mutex> lock(g_workerMutex);
 		if (!g_workerThread)
 		{
 			g_captureShutdownDone = false;
 			g_workerRunning = true;
-			g_workerThread = new std::thread(WorkerThreadProc);
+			/* Subscribed before any frame is published; the worker only ever wants the newest one */
+			g_workerThread = new std::thread(WorkerThreadProc, g_captureBus.Subscribe("perception", 1, FrameDropOldest));
+			g_readbackThread = new std::thread(ReadbackThreadProc);
+			if (CAPTURE_DATASET_DIRECTORY)
+				g_recorderThread = new std::thread(RecorderThreadProc, g_analysisBus.Subscribe("recorder", CAPTURE_DATASET_QUEUE_DEPTH, FrameDropNewest));
 		}
 	}
 
@@ -263,18 +539,25 @@ void Capture_Shutdown()
 	g_workerRunning = false;
 	{
 		std::lock_guard<std::mutex> lock(g_workerMutex);
-		g_pendingApi = 0;
-		g_pendingD3D11Frame.release();
+		g_pendingTrackTargets.clear();
 		if (g_pendingD3D12Readback) { g_pendingD3D12Readback->Release(); g_pendingD3D12Readback = nullptr; }
 	}
 	g_workerCv.notify_all();
-	if (g_workerThread)
+	/* Wakes every subscriber; frames still queued are dropped and go back to the pool */
+	g_captureBus.Close();
+	g_analysisBus.Close();
+	for (std::thread** thread : { &g_workerThread, &g_readbackThread, &g_recorderThread })
 	{
-		if (g_workerThread->joinable())
-			g_workerThread->join();
-		delete g_workerThread;
-		g_workerThread = nullptr;
+		if (!*thread)
+			continue;
+		if ((*thread)->joinable())
+			(*thread)->join();
+		delete *thread;
+		*thread = nullptr;
 	}
+	g_inference.Stop();
+	g_stream.Stop();
+	g_framePool->Trim();
 	if (g_d3d11_mainRTV)
 	{
 		g_d3d11_mainRTV->Release();
@@ -284,12 +567,42 @@ void Capture_Shutdown()
 	D3D12_CleanupInitResources();
 }
 
+void Capture_AddTrackTarget(const cv::Rect2f& displayBox)
+{
+	std::lock_guard<std::mutex> lock(g_workerMutex);
+	g_pendingTrackTargets.push_back(displayBox);
+}
+
+void Capture_ClearTrackTargets()
+{
+	std::lock_guard<std::mutex> lock(g_workerMutex);
+	g_pendingTrackTargets.clear();
+	g_pendingTrackClear = true;
+}
+
+FrameSubscriptionPtr Capture_SubscribeFrames(const std::string& name, size_t depth, FrameDropPolicy policy, bool analyzed)
+{
+	return (analyzed ? g_analysisBus : g_captureBus).Subscribe(name, depth, policy);
+}
+
+void Capture_UnsubscribeFrames(const FrameSubscriptionPtr& subscription)
+{
+	/* Removing from the bus it is not on is a no-op */
+	g_captureBus.Unsubscribe(subscription);
+	g_analysisBus.Unsubscribe(subscription);
+}
+
 void Capture_GetResults(PerceptionResults& out)
 {
 	std::lock_guard<std::mutex> lock(g_resultsMutex);
 	out = g_results;
 }
 
+bool Capture_GetLatencyCompensation()
+{
+	return g_latencyCompensation;
+}
+
 bool Capture_GetShowOverlay()
 {
 	return g_showOverlay;
@@ -429,6 +742,7 @@ static void EvtHydraHookD3D11PrePresent(
 	const UINT bufIdx = g_d3d11_frameCounter % CAPTURE_NUM_BUFFERS;
 	pContext->CopyResource(g_d3d11_staging[bufIdx], pBackBuffer);
 	pContext->End(g_d3d11_query[bufIdx]);
+	g_d3d11_captureTag[bufIdx] = { g_d3d11_frameCounter, FrameTiming_Now() };
 
 	if (g_d3d11_frameCounter >= 1)
 	{
@@ -439,29 +753,11 @@ static void EvtHydraHookD3D11PrePresent(
 			D3D11_MAPPED_SUBRESOURCE mapped = {};
 			if (SUCCEEDED(pContext->Map(g_d3d11_staging[prevIdx], 0, D3D11_MAP_READ, 0, &mapped)))
 			{
-				cv::Mat frame;
-				frame.create((int)height, (int)width, CV_8UC3);
-				const UINT rp = mapped.RowPitch;
-				for (UINT y = 0; y < height; y++)
-				{
-					const uint8_t* src = (const uint8_t*)mapped.pData + y * rp;
-					uint8_t* dst = frame.ptr((int)y);
-					for (UINT x = 0; x < width; x++)
-					{
-						dst[x * 3 + 0] = src[x * 4 + 2];
-						dst[x * 3 + 1] = src[x * 4 + 1];
-						dst[x * 3 + 2] = src[x * 4 + 0];
-					}
-				}
+				BusFrame frame;
+				frame.tag = g_d3d11_captureTag[prevIdx];
+				Capture_BuildBusFrame((const uint8_t*)mapped.pData, mapped.RowPitch, width, height, g_d3d11_statsAccumulator, frame);
 				pContext->Unmap(g_d3d11_staging[prevIdx], 0);
-				{
-					std::lock_guard<std::mutex> lock(g_workerMutex);
-					g_pendingD3D11Frame = frame;
-					g_pendingApi = 11;
-					g_pendingWidth = g_d3d11_captureWidth;
-					g_pendingHeight = g_d3d11_captureHeight;
-				}
-				g_workerCv.notify_one();
+				g_captureBus.Publish(std::move(frame));
 			}
 		}
 	}
@@ -475,16 +771,16 @@ static void EvtHydraHookD3D11PrePresent(
 	Overlay_ToggleState(VK_F12, showOverlay);
 	g_showOverlay = showOverlay;
 
+	Capture_PollHotkeys();
+
 	if (g_showOverlay)
 	{
 		ImGui_ImplDX11_NewFrame();
 		ImGui_ImplWin32_NewFrame();
 		ImGui::NewFrame();
 
-		PerceptionResults res;
-		Capture_GetResults(res);
-		Overlay_Render((float)width, (float)height, res);
-		Overlay_DrawDebugHUD(res);
+		/* frame counter already advanced past this Present */
+		Capture_DrawOverlay((float)width, (float)height, g_d3d11_frameCounter - 1);
 
 		ImGui::Render();
 		ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
@@ -537,6 +833,9 @@ static void EvtHydraHookD3D11PostResizeBuffers(
 	(void)NewFormat;
 	(void)SwapChainFlags;
 	(void)Extension;
+
+	/* Frames of the old size are freed as they come back instead of sitting idle */
+	g_framePool->Trim();
 }
 
 #pragma endregion
@@ -899,6 +1198,7 @@ static void EvtHydraHookD3D12PrePresent(
 	dstLoc.PlacedFootprint = footprint;
 
 	g_d3d12_pCommandList->CopyTextureRegion(&dstLoc, 0, 0, 0, &srcLoc, nullptr);
+	g_d3d12_captureTag[bufIdx] = { g_d3d12_frameCounter, FrameTiming_Now() };
 
 	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
 	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
@@ -910,6 +1210,8 @@ static void EvtHydraHookD3D12PrePresent(
 	Overlay_ToggleState(VK_F12, showOverlay);
 	g_showOverlay = showOverlay;
 
+	Capture_PollHotkeys();
+
 	if (g_showOverlay)
 	{
 #ifdef _WIN64
@@ -918,10 +1220,7 @@ static void EvtHydraHookD3D12PrePresent(
 		ImGui_ImplWin32_NewFrame();
 		ImGui::NewFrame();
 
-		PerceptionResults res;
-		Capture_GetResults(res);
-		Overlay_Render((float)width, (float)height, res);
-		Overlay_DrawDebugHUD(res);
+		Capture_DrawOverlay((float)width, (float)height, g_d3d12_frameCounter);
 
 		ImGui::Render();
 		ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_d3d12_pCommandList);
@@ -942,7 +1241,10 @@ static void EvtHydraHookD3D12PrePresent(
 		const UINT prevIdx = (g_d3d12_frameCounter - 1) % CAPTURE_NUM_BUFFERS;
 		{
 			std::lock_guard<std::mutex> lock(g_workerMutex);
-			g_pendingApi = 12;
+			/* The readback thread is still behind; the older frame is superseded */
+			if (g_pendingD3D12Readback)
+				g_pendingD3D12Readback->Release();
+			g_pendingTag = g_d3d12_captureTag[prevIdx];
 			g_pendingD3D12FenceValue = g_d3d12_fenceValueForReadback[prevIdx];
 			g_pendingD3D12Readback = g_d3d12_readback[prevIdx];
 			if (g_pendingD3D12Readback) g_pendingD3D12Readback->AddRef();
@@ -1008,6 +1310,8 @@ static void EvtHydraHookD3D12PostResizeBuffers(
 	(void)SwapChainFlags;
 	(void)Extension;
 
+	g_framePool->Trim();
+
 	if (!D3D12_CreateOverlayResources(pSwapChain))
 		HydraHookEngineLogError("HydraHook-OpenCV: D3D12_CreateOverlayResources failed after resize");
 #ifdef _WIN64
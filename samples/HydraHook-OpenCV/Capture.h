@@ -24,11 +24,18 @@ SOFTWARE.
 
 #pragma once
 
+#include "FrameBus.h"
 #include "Perception.h"
 #include <HydraHook/Engine/HydraHookCore.h>
 
 void Capture_SetupCallbacks(PHYDRAHOOK_ENGINE EngineHandle, HYDRAHOOK_D3D_VERSION GameVersion);
 void Capture_Shutdown();
 void Capture_GetResults(PerceptionResults& out);
+void Capture_AddTrackTarget(const cv::Rect2f& displayBox);
+void Capture_ClearTrackTargets();
+/* Frames at readback (analyzed=false) or after perception with results attached (analyzed=true) */
+FrameSubscriptionPtr Capture_SubscribeFrames(const std::string& name, size_t depth, FrameDropPolicy policy, bool analyzed);
+void Capture_UnsubscribeFrames(const FrameSubscriptionPtr& subscription);
+bool Capture_GetLatencyCompensation();
 bool Capture_GetShowOverlay();
 void Capture_SetShowOverlay(bool show);
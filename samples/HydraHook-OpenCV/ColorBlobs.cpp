@@ -0,0 +1,294 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "ColorBlobs.h"
+
+#include <opencv2/core/utility.hpp>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cstring>
+
+/* Per rule; a noisy threshold shouldn't flood the results */
+static constexpr size_t COLORBLOB_MAX_BLOBS = 256;
+
+struct ColorRun
+{
+	int x0;			/* first pixel */
+	int x1;			/* one past the last pixel */
+	int y;
+	int label;
+};
+
+/* Per-thread scratch; rules run on OpenCV's pool */
+struct ColorBlobScratch
+{
+	std::vector<uint8_t> mask;
+	std::vector<ColorRun> runs;
+	std::vector<int> parent;
+	std::vector<int> blobOfLabel;
+};
+
+static thread_local ColorBlobScratch t_scratch;
+
+/**
+ * @brief Writes 0xFF for every R8G8B8A8 pixel inside the rule's HSV box, 0 otherwise.
+ *
+ * Saturation is tested as delta * 255 against limit * V, so only hue needs a division.
+ */
+static void ThresholdRow(const uint8_t* src, int width, const ColorRule& rule, uint8_t* mask)
+{
+	const bool wrap = rule.hueMin > rule.hueMax;
+	int x = 0;
+
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 thirty = _mm_set1_ps(30.0f);
+	const __m128 sixty = _mm_set1_ps(60.0f);
+	const __m128 oneTwenty = _mm_set1_ps(120.0f);
+	const __m128 oneEighty = _mm_set1_ps(180.0f);
+	const __m128 full = _mm_set1_ps(255.0f);
+	const __m128 hueMin = _mm_set1_ps((float)rule.hueMin);
+	const __m128 hueMax = _mm_set1_ps((float)rule.hueMax);
+	const __m128 satMin = _mm_set1_ps((float)rule.satMin);
+	const __m128 satMax = _mm_set1_ps((float)rule.satMax);
+	const __m128 valMin = _mm_set1_ps((float)rule.valMin);
+	const __m128 valMax = _mm_set1_ps((float)rule.valMax);
+
+	const auto test4 = [&](const uint8_t* p) -> __m128i
+	{
+		/* four pixels per register; channels fall out of shifts and masks, no shuffles needed */
+		const __m128i px = _mm_loadu_si128((const __m128i*)p);
+		const __m128 r = _mm_cvtepi32_ps(_mm_and_si128(px, byteMask));
+		const __m128 g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 8), byteMask));
+		const __m128 b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 16), byteMask));
+
+		const __m128 v = _mm_max_ps(r, _mm_max_ps(g, b));
+		const __m128 delta = _mm_sub_ps(v, _mm_min_ps(r, _mm_min_ps(g, b)));
+		const __m128 scaledDelta = _mm_mul_ps(delta, full);
+
+		__m128 ok = _mm_and_ps(_mm_cmpge_ps(v, valMin), _mm_cmple_ps(v, valMax));
+		ok = _mm_and_ps(ok, _mm_cmpge_ps(scaledDelta, _mm_mul_ps(satMin, v)));
+		ok = _mm_and_ps(ok, _mm_cmple_ps(scaledDelta, _mm_mul_ps(satMax, v)));
+
+		const __m128 scale = _mm_div_ps(thirty, _mm_max_ps(delta, one));
+		const __m128 hueR = _mm_mul_ps(_mm_sub_ps(g, b), scale);
+		const __m128 hueG = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(b, r), scale), sixty);
+		const __m128 hueB = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(r, g), scale), oneTwenty);
+		const __m128 isR = _mm_cmpeq_ps(v, r);
+		const __m128 isG = _mm_andnot_ps(isR, _mm_cmpeq_ps(v, g));
+		__m128 hue = _mm_or_ps(_mm_and_ps(isR, hueR), _mm_andnot_ps(isR, _mm_or_ps(_mm_and_ps(isG, hueG), _mm_andnot_ps(isG, hueB))));
+		hue = _mm_add_ps(hue, _mm_and_ps(_mm_cmplt_ps(hue, zero), oneEighty));
+
+		const __m128 aboveMin = _mm_cmpge_ps(hue, hueMin);
+		const __m128 belowMax = _mm_cmple_ps(hue, hueMax);
+		ok = _mm_and_ps(ok, wrap ? _mm_or_ps(aboveMin, belowMax) : _mm_and_ps(aboveMin, belowMax));
+		return _mm_castps_si128(ok);
+	};
+
+	for (; x + 16 <= width; x += 16)
+	{
+		const uint8_t* p = src + x * 4;
+		const __m128i lo = _mm_packs_epi32(test4(p), test4(p + 16));
+		const __m128i hi = _mm_packs_epi32(test4(p + 32), test4(p + 48));
+		_mm_storeu_si128((__m128i*)(mask + x), _mm_packs_epi16(lo, hi));
+	}
+	for (; x < width; x++)
+	{
+		const uint8_t* p = src + x * 4;
+		const int r = p[0], g = p[1], b = p[2];
+		const int v = (std::max)(r, (std::max)(g, b));
+		const int delta = v - (std::min)(r, (std::min)(g, b));
+		float hue;
+		if (v == r)
+			hue = 30.0f * (g - b) / (std::max)(delta, 1);
+		else if (v == g)
+			hue = 60.0f + 30.0f * (b - r) / (std::max)(delta, 1);
+		else
+			hue = 120.0f + 30.0f * (r - g) / (std::max)(delta, 1);
+		if (hue < 0.0f)
+			hue += 180.0f;
+		const bool hueOk = wrap ? (hue >= rule.hueMin || hue <= rule.hueMax) : (hue >= rule.hueMin && hue <= rule.hueMax);
+		mask[x] = (hueOk && v >= rule.valMin && v <= rule.valMax
+			&& delta * 255 >= rule.satMin * v && delta * 255 <= rule.satMax * v) ? 0xFF : 0;
+	}
+}
+
+static int FindRoot(std::vector<int>& parent, int label)
+{
+	while (parent[(size_t)label] != label)
+	{
+		parent[(size_t)label] = parent[(size_t)parent[(size_t)label]];
+		label = parent[(size_t)label];
+	}
+	return label;
+}
+
+bool ColorBlobDetector::Add(const ColorRule& rule)
+{
+	if (rule.roi.empty())
+		return false;
+
+	m_Rules.push_back(rule);
+	return true;
+}
+
+cv::Rect ColorBlobDetector::CropArea(cv::Size frameSize) const
+{
+	const cv::Rect frame(0, 0, frameSize.width, frameSize.height);
+	cv::Rect area;
+	for (const auto& rule : m_Rules)
+	{
+		const cv::Rect roi = rule.roi & frame;
+		if (!roi.empty())
+			area = area.empty() ? roi : (area | roi);
+	}
+	return area;
+}
+
+void ColorBlobDetector::Extract(const cv::Mat& rgba, cv::Point origin, std::vector<ColorBlobGroup>& out) const
+{
+	out.assign(m_Rules.size(), ColorBlobGroup());
+	if (rgba.empty() || rgba.type() != CV_8UC4)
+		return;
+
+	cv::parallel_for_(cv::Range(0, (int)m_Rules.size()), [&](const cv::Range& range)
+	{
+		for (int i = range.start; i < range.end; i++)
+			ExtractRule(m_Rules[(size_t)i], rgba, origin, out[(size_t)i]);
+	});
+}
+
+/**
+ * @brief Thresholds one rule's ROI and labels its runs; 8-connected.
+ */
+void ColorBlobDetector::ExtractRule(const ColorRule& rule, const cv::Mat& rgba, cv::Point origin, ColorBlobGroup& out)
+{
+	out.name = rule.name;
+
+	const cv::Rect available(origin, rgba.size());
+	const cv::Rect roi = rule.roi & available;
+	if (roi.empty())
+		return;
+
+	ColorBlobScratch& s = t_scratch;
+	s.mask.resize((size_t)roi.width);
+	s.runs.clear();
+	s.parent.clear();
+
+	size_t prevBegin = 0;
+	size_t prevEnd = 0;
+	for (int y = 0; y < roi.height; y++)
+	{
+		const uint8_t* row = rgba.ptr<uint8_t>(roi.y - origin.y + y) + (size_t)(roi.x - origin.x) * 4;
+		ThresholdRow(row, roi.width, rule, s.mask.data());
+
+		const size_t rowBegin = s.runs.size();
+		const uint8_t* mask = s.mask.data();
+		int x = 0;
+		while (x < roi.width)
+		{
+			/* skip empty 16-pixel chunks without looking at single bytes */
+			if (x + 16 <= roi.width && !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(mask + x))))
+			{
+				x += 16;
+				continue;
+			}
+			if (!mask[x])
+			{
+				x++;
+				continue;
+			}
+			const int start = x;
+			while (x < roi.width && mask[x])
+				x++;
+
+			ColorRun run = { start, x, y, (int)s.parent.size() };
+			s.parent.push_back(run.label);
+
+			/* previous-row runs touching [start - 1, x] are 8-connected */
+			for (size_t p = prevBegin; p < prevEnd; p++)
+			{
+				const ColorRun& above = s.runs[p];
+				if (above.x1 < start)
+				{
+					prevBegin = p + 1;
+					continue;
+				}
+				if (above.x0 > x)
+					break;
+				const int a = FindRoot(s.parent, above.label);
+				const int b = FindRoot(s.parent, run.label);
+				if (a != b)
+					s.parent[(size_t)(std::max)(a, b)] = (std::min)(a, b);
+			}
+			s.runs.push_back(run);
+		}
+		prevBegin = rowBegin;
+		prevEnd = s.runs.size();
+	}
+
+	/* one blob per root, accumulated run by run */
+	struct Accumulator { int x0, y0, x1, y1; int64_t area, sumX2, sumY; };
+	std::vector<Accumulator> blobs;
+	s.blobOfLabel.assign(s.parent.size(), -1);
+	for (const ColorRun& run : s.runs)
+	{
+		const int root = FindRoot(s.parent, run.label);
+		int& index = s.blobOfLabel[(size_t)root];
+		if (index < 0)
+		{
+			index = (int)blobs.size();
+			blobs.push_back({ run.x0, run.y, run.x1, run.y + 1, 0, 0, 0 });
+		}
+		Accumulator& acc = blobs[(size_t)index];
+		const int length = run.x1 - run.x0;
+		acc.x0 = (std::min)(acc.x0, run.x0);
+		acc.x1 = (std::max)(acc.x1, run.x1);
+		acc.y1 = run.y + 1;
+		acc.area += length;
+		acc.sumX2 += (int64_t)length * (run.x0 + run.x1 - 1);	/* twice the sum of x over the run */
+		acc.sumY += (int64_t)length * run.y;
+	}
+
+	for (const Accumulator& acc : blobs)
+	{
+		if (acc.area < rule.minArea)
+			continue;
+		ColorBlob blob;
+		blob.box = cv::Rect(roi.x + acc.x0, roi.y + acc.y0, acc.x1 - acc.x0, acc.y1 - acc.y0);
+		blob.area = (int)acc.area;
+		blob.centroid = cv::Point2f(roi.x + (float)acc.sumX2 / (2.0f * acc.area), roi.y + (float)acc.sumY / acc.area);
+		out.blobs.push_back(blob);
+	}
+
+	std::sort(out.blobs.begin(), out.blobs.end(), [](const ColorBlob& a, const ColorBlob& b) { return a.area > b.area; });
+	if (out.blobs.size() > COLORBLOB_MAX_BLOBS)
+		out.blobs.resize(COLORBLOB_MAX_BLOBS);
+}
@@ -0,0 +1,75 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Perception.h"
+
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Pixels a color rule accepts, in OpenCV's 8-bit HSV convention (hue 0-179).
+ *
+ * hueMin > hueMax wraps around 0, e.g. 170-10 for red.
+ */
+struct ColorRule
+{
+	std::string name;
+	cv::Rect roi;			/* swap chain coordinates; required, the readback is copied on the render thread */
+	int hueMin = 0;
+	int hueMax = 179;
+	int satMin = 0;
+	int satMax = 255;
+	int valMin = 0;
+	int valMax = 255;
+	int minArea = 1;		/* smaller blobs are dropped */
+};
+
+/**
+ * @brief HSV thresholding and run-length connected components on R8G8B8A8 readback pixels.
+ *
+ * Each rule thresholds its ROI row by row (SSE2, four pixels per step, no HSV image is built)
+ * and labels the resulting runs against the runs of the previous row with union-find, so only
+ * runs, never pixels, are visited twice. Rules run in parallel on OpenCV's pool.
+ */
+class ColorBlobDetector
+{
+public:
+	/* False (rule ignored) for an empty ROI */
+	bool Add(const ColorRule& rule);
+	size_t Size() const { return m_Rules.size(); }
+
+	/* Bounding box of all ROIs within the frame; the part of the readback worth keeping */
+	cv::Rect CropArea(cv::Size frameSize) const;
+
+	/* rgba covers the swap chain rectangle starting at origin, e.g. a CropArea copy */
+	void Extract(const cv::Mat& rgba, cv::Point origin, std::vector<ColorBlobGroup>& out) const;
+
+private:
+	static void ExtractRule(const ColorRule& rule, const cv::Mat& rgba, cv::Point origin, ColorBlobGroup& out);
+
+	std::vector<ColorRule> m_Rules;
+};
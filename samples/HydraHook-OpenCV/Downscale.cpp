@@ -0,0 +1,372 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "Downscale.h"
+
+#include <tmmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifndef PF_SSSE3_INSTRUCTIONS_AVAILABLE
+#define PF_SSSE3_INSTRUCTIONS_AVAILABLE 36
+#endif
+
+/* BT.601 luma weights scaled to 128 so R*wR + G*wG fits the signed 16-bit lanes of pmaddubsw.
+   Captured rows are R8G8B8A8 (see the staging/readback formats in Capture.cpp). */
+static constexpr int LUMA_WEIGHT_R = 38;
+static constexpr int LUMA_WEIGHT_G = 75;
+static constexpr int LUMA_WEIGHT_B = 15;
+static constexpr int LUMA_SHIFT = 7;
+
+static constexpr int DOWNSCALE_MAX_BOX_FACTOR = 4;
+
+static const bool g_hasSsse3 = IsProcessorFeaturePresent(PF_SSSE3_INSTRUCTIONS_AVAILABLE) != FALSE;
+
+/* Per-thread scratch; the D3D11 path downscales on the render thread, D3D12 on the capture worker. */
+struct DownscaleScratch
+{
+	std::vector<uint16_t> acc;
+	std::vector<float> accF;
+	std::vector<uint16_t> rows[2];
+	int rowIndex[2] = { -1, -1 };
+	int nextSlot = 0;
+
+	std::vector<int> xStart;
+	std::vector<int> xCount;
+	std::vector<float> xWeights;
+	int tableSrcWidth = 0;
+	int tableDstWidth = 0;
+	DownscaleFilter tableFilter = DownscaleFilterArea;
+};
+
+static thread_local DownscaleScratch t_scratch;
+
+/**
+ * @brief Converts one R8G8B8A8 row to luma; adds to dst instead of overwriting if accumulate is set.
+ */
+static void LumaRow(const uint8_t* src, int width, uint16_t* dst, bool accumulate)
+{
+	int x = 0;
+	if (g_hasSsse3)
+	{
+		const __m128i weights = _mm_setr_epi8(
+			LUMA_WEIGHT_R, LUMA_WEIGHT_G, LUMA_WEIGHT_B, 0, LUMA_WEIGHT_R, LUMA_WEIGHT_G, LUMA_WEIGHT_B, 0,
+			LUMA_WEIGHT_R, LUMA_WEIGHT_G, LUMA_WEIGHT_B, 0, LUMA_WEIGHT_R, LUMA_WEIGHT_G, LUMA_WEIGHT_B, 0);
+		const __m128i round = _mm_set1_epi16(1 << (LUMA_SHIFT - 1));
+		for (; x + 8 <= width; x += 8)
+		{
+			const __m128i lo = _mm_loadu_si128((const __m128i*)(src + x * 4));
+			const __m128i hi = _mm_loadu_si128((const __m128i*)(src + x * 4 + 16));
+			/* pmaddubsw yields (R*wR + G*wG, B*wB) per pixel, phaddw folds the pairs */
+			__m128i luma = _mm_hadd_epi16(_mm_maddubs_epi16(lo, weights), _mm_maddubs_epi16(hi, weights));
+			luma = _mm_srli_epi16(_mm_add_epi16(luma, round), LUMA_SHIFT);
+			if (accumulate)
+				luma = _mm_add_epi16(luma, _mm_loadu_si128((const __m128i*)(dst + x)));
+			_mm_storeu_si128((__m128i*)(dst + x), luma);
+		}
+	}
+	for (; x < width; x++)
+	{
+		const uint8_t* p = src + x * 4;
+		const uint16_t luma = (uint16_t)((p[0] * LUMA_WEIGHT_R + p[1] * LUMA_WEIGHT_G + p[2] * LUMA_WEIGHT_B + (1 << (LUMA_SHIFT - 1))) >> LUMA_SHIFT);
+		dst[x] = accumulate ? (uint16_t)(dst[x] + luma) : luma;
+	}
+}
+
+/**
+ * @brief Returns the luma of source row y, converting it only if it isn't one of the two cached rows.
+ *
+ * Rows are requested in ascending order, so a row shared by two output rows (area boundary,
+ * bilinear neighbours) is read from mapped memory once.
+ */
+static const uint16_t* CachedLumaRow(DownscaleScratch& s, const uint8_t* src, size_t rowPitch, int width, int y)
+{
+	for (int i = 0; i < 2; i++)
+	{
+		if (s.rowIndex[i] == y)
+			return s.rows[i].data();
+	}
+	const int slot = s.nextSlot;
+	s.nextSlot ^= 1;
+	s.rows[slot].resize((size_t)width);
+	LumaRow(src + (size_t)y * rowPitch, width, s.rows[slot].data(), false);
+	s.rowIndex[slot] = y;
+	return s.rows[slot].data();
+}
+
+/**
+ * @brief Sums factor x factor luma blocks; each source row is converted straight into the accumulator.
+ */
+static void BoxDownscale(const uint8_t* src, size_t rowPitch, int width, int factor, cv::Mat& dst, FrameStatsAccumulator* stats)
+{
+	DownscaleScratch& s = t_scratch;
+	s.acc.resize((size_t)width + 8);
+	uint16_t* acc = s.acc.data();
+	const int dstWidth = dst.cols;
+	const int area = factor * factor;
+
+	for (int dy = 0; dy < dst.rows; dy++)
+	{
+		const uint8_t* row = src + (size_t)dy * factor * rowPitch;
+		for (int i = 0; i < factor; i++)
+			LumaRow(row + (size_t)i * rowPitch, width, acc, i != 0);
+
+		uint8_t* out = dst.ptr<uint8_t>(dy);
+		int dx = 0;
+		if (g_hasSsse3 && factor == 2)
+		{
+			const __m128i round = _mm_set1_epi16(2);
+			for (; dx + 8 <= dstWidth; dx += 8)
+			{
+				__m128i sum = _mm_hadd_epi16(_mm_loadu_si128((const __m128i*)(acc + dx * 2)), _mm_loadu_si128((const __m128i*)(acc + dx * 2 + 8)));
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+				_mm_storel_epi64((__m128i*)(out + dx), _mm_packus_epi16(sum, sum));
+			}
+		}
+		else if (g_hasSsse3 && factor == 4)
+		{
+			const __m128i round = _mm_set1_epi16(8);
+			for (; dx + 8 <= dstWidth; dx += 8)
+			{
+				const uint16_t* a = acc + dx * 4;
+				const __m128i pairsLo = _mm_hadd_epi16(_mm_loadu_si128((const __m128i*)a), _mm_loadu_si128((const __m128i*)(a + 8)));
+				const __m128i pairsHi = _mm_hadd_epi16(_mm_loadu_si128((const __m128i*)(a + 16)), _mm_loadu_si128((const __m128i*)(a + 24)));
+				__m128i sum = _mm_hadd_epi16(pairsLo, pairsHi);
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 4);
+				_mm_storel_epi64((__m128i*)(out + dx), _mm_packus_epi16(sum, sum));
+			}
+		}
+		else if (factor == 1)
+		{
+			for (; dx + 8 <= dstWidth; dx += 8)
+			{
+				const __m128i v = _mm_loadu_si128((const __m128i*)(acc + dx));
+				_mm_storel_epi64((__m128i*)(out + dx), _mm_packus_epi16(v, v));
+			}
+		}
+		/* 3x (and tails): the horizontal reduction only touches 1/factor^2 of the converted pixels */
+		for (; dx < dstWidth; dx++)
+		{
+			const uint16_t* a = acc + dx * factor;
+			int sum = 0;
+			for (int i = 0; i < factor; i++)
+				sum += a[i];
+			out[dx] = (uint8_t)((sum + area / 2) / area);
+		}
+
+		if (stats)
+			stats->AddRow(row, out, dy);
+	}
+}
+
+/**
+ * @brief Builds the horizontal source span and weights of every output column.
+ */
+static void BuildColumnTable(DownscaleScratch& s, int srcWidth, int dstWidth, DownscaleFilter filter)
+{
+	if (s.tableSrcWidth == srcWidth && s.tableDstWidth == dstWidth && s.tableFilter == filter)
+		return;
+
+	s.xStart.assign((size_t)dstWidth, 0);
+	s.xCount.assign((size_t)dstWidth, 0);
+	s.xWeights.clear();
+	const double scale = (double)srcWidth / dstWidth;
+
+	for (int dx = 0; dx < dstWidth; dx++)
+	{
+		if (filter == DownscaleFilterBilinear)
+		{
+			const double sx = (std::max)((dx + 0.5) * scale - 0.5, 0.0);
+			const int x0 = (std::min)((int)sx, srcWidth - 1);
+			const float fx = (x0 + 1 < srcWidth) ? (float)(sx - x0) : 0.0f;
+			s.xStart[dx] = x0;
+			s.xCount[dx] = 2;
+			s.xWeights.push_back(1.0f - fx);
+			s.xWeights.push_back(fx);
+		}
+		else
+		{
+			const double x0 = dx * scale;
+			const double x1 = (std::min)((dx + 1) * scale, (double)srcWidth);
+			const int first = (int)x0;
+			const int last = (std::min)((int)std::ceil(x1), srcWidth);
+			s.xStart[dx] = first;
+			s.xCount[dx] = last - first;
+			for (int x = first; x < last; x++)
+			{
+				const double overlap = (std::min)(x1, x + 1.0) - (std::max)(x0, (double)x);
+				s.xWeights.push_back((float)(overlap / scale));
+			}
+		}
+	}
+	s.tableSrcWidth = srcWidth;
+	s.tableDstWidth = dstWidth;
+	s.tableFilter = filter;
+}
+
+/**
+ * @brief Adds weight * luma to a float accumulator row.
+ */
+static void AccumulateRow(float* acc, const uint16_t* luma, int width, float weight)
+{
+	int x = 0;
+	const __m128 w = _mm_set1_ps(weight);
+	const __m128i zero = _mm_setzero_si128();
+	for (; x + 8 <= width; x += 8)
+	{
+		const __m128i v = _mm_loadu_si128((const __m128i*)(luma + x));
+		const __m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero));
+		const __m128 hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero));
+		_mm_storeu_ps(acc + x, _mm_add_ps(_mm_loadu_ps(acc + x), _mm_mul_ps(lo, w)));
+		_mm_storeu_ps(acc + x + 4, _mm_add_ps(_mm_loadu_ps(acc + x + 4), _mm_mul_ps(hi, w)));
+	}
+	for (; x < width; x++)
+		acc[x] += luma[x] * weight;
+}
+
+/**
+ * @brief Arbitrary-ratio area average or bilinear resample, vertical pass on the fly per source row.
+ */
+static void ResampleDownscale(const uint8_t* src, size_t rowPitch, int width, int height, DownscaleFilter filter, cv::Mat& dst, FrameStatsAccumulator* stats)
+{
+	DownscaleScratch& s = t_scratch;
+	BuildColumnTable(s, width, dst.cols, filter);
+	s.accF.resize((size_t)width + 1);
+	s.rowIndex[0] = s.rowIndex[1] = -1;
+	s.nextSlot = 0;
+	float* acc = s.accF.data();
+	/* bilinear columns may reference x0 + 1 == width with zero weight */
+	acc[width] = 0.0f;
+
+	const double scale = (double)height / dst.rows;
+
+	for (int dy = 0; dy < dst.rows; dy++)
+	{
+		std::fill(acc, acc + width, 0.0f);
+		int firstRow = 0;
+
+		if (filter == DownscaleFilterBilinear)
+		{
+			const double sy = (std::max)((dy + 0.5) * scale - 0.5, 0.0);
+			const int y0 = (std::min)((int)sy, height - 1);
+			const int y1 = (std::min)(y0 + 1, height - 1);
+			const float fy = (float)(sy - y0);
+			firstRow = y0;
+			AccumulateRow(acc, CachedLumaRow(s, src, rowPitch, width, y0), width, 1.0f - fy);
+			if (fy > 0.0f && y1 != y0)
+				AccumulateRow(acc, CachedLumaRow(s, src, rowPitch, width, y1), width, fy);
+		}
+		else
+		{
+			const double y0 = dy * scale;
+			const double y1 = (std::min)((dy + 1) * scale, (double)height);
+			const int last = (std::min)((int)std::ceil(y1), height);
+			firstRow = (int)y0;
+			for (int y = (int)y0; y < last; y++)
+			{
+				const double overlap = (std::min)(y1, y + 1.0) - (std::max)(y0, (double)y);
+				AccumulateRow(acc, CachedLumaRow(s, src, rowPitch, width, y), width, (float)(overlap / scale));
+			}
+		}
+
+		uint8_t* out = dst.ptr<uint8_t>(dy);
+		const float* weights = s.xWeights.data();
+		for (int dx = 0; dx < dst.cols; dx++)
+		{
+			const float* a = acc + s.xStart[dx];
+			const int count = s.xCount[dx];
+			float sum = 0.0f;
+			for (int i = 0; i < count; i++)
+				sum += a[i] * weights[i];
+			weights += count;
+			out[dx] = (uint8_t)(std::min)(sum + 0.5f, 255.0f);
+		}
+
+		/* the first source row was converted last or second to last, still in cache */
+		if (stats)
+			stats->AddRow(src + (size_t)firstRow * rowPitch, out, dy);
+	}
+}
+
+cv::Size Downscale_GetAnalysisSize(int width, int height, int analysisWidth)
+{
+	if (analysisWidth <= 0 || analysisWidth >= width || width <= 0 || height <= 0)
+		return cv::Size(width, height);
+	const int analysisHeight = (int)(((int64_t)height * analysisWidth + width / 2) / width);
+	return cv::Size(analysisWidth, (std::max)(analysisHeight, 1));
+}
+
+/**
+ * @brief Returns the integer box factor for srcSize -> dstSize, or 0 if there is none.
+ */
+static int GetBoxFactor(cv::Size srcSize, cv::Size dstSize)
+{
+	for (int factor = 1; factor <= DOWNSCALE_MAX_BOX_FACTOR; factor++)
+	{
+		if (srcSize.width == dstSize.width * factor && srcSize.height == dstSize.height * factor)
+			return factor;
+	}
+	return 0;
+}
+
+const char* Downscale_GetFilterName(cv::Size srcSize, cv::Size dstSize, DownscaleFilter filter)
+{
+	if (filter == DownscaleFilterArea)
+	{
+		switch (GetBoxFactor(srcSize, dstSize))
+		{
+		case 1: return "copy";
+		case 2: return "box2";
+		case 3: return "box3";
+		case 4: return "box4";
+		default: return "area";
+		}
+	}
+	return "bilinear";
+}
+
+void Downscale_RgbaToGray(const uint8_t* src, size_t rowPitch, int width, int height, cv::Size dstSize, DownscaleFilter filter, cv::Mat& dst, FrameStatsAccumulator* stats)
+{
+	if (!src || width <= 0 || height <= 0)
+	{
+		dst.release();
+		return;
+	}
+	dstSize.width = (std::min)((std::max)(dstSize.width, 1), width);
+	dstSize.height = (std::min)((std::max)(dstSize.height, 1), height);
+	dst.create(dstSize, CV_8UC1);
+	if (stats)
+		stats->Begin(width, dstSize);
+
+	const int factor = (filter == DownscaleFilterArea) ? GetBoxFactor(cv::Size(width, height), dstSize) : 0;
+	if (factor)
+		BoxDownscale(src, rowPitch, width, factor, dst, stats);
+	else
+		ResampleDownscale(src, rowPitch, width, height, filter, dst, stats);
+}
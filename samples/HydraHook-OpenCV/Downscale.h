@@ -0,0 +1,43 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "FrameStats.h"
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+
+/**
+ * @brief Resampling filter used when the analysis size is not an integer fraction of the source.
+ */
+enum DownscaleFilter
+{
+	DownscaleFilterArea,		/**< Pixel-area average; 2x/3x/4x ratios use the box kernels. */
+	DownscaleFilterBilinear		/**< Two source rows per output row, cheapest for large ratios. */
+};
+
+cv::Size Downscale_GetAnalysisSize(int width, int height, int analysisWidth);
+void Downscale_RgbaToGray(const uint8_t* src, size_t rowPitch, int width, int height, cv::Size dstSize, DownscaleFilter filter, cv::Mat& dst, FrameStatsAccumulator* stats);
+const char* Downscale_GetFilterName(cv::Size srcSize, cv::Size dstSize, DownscaleFilter filter);
@@ -0,0 +1,171 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "FrameBus.h"
+
+#include <algorithm>
+#include <chrono>
+
+FrameSubscription::FrameSubscription(std::string name, size_t depth, FrameDropPolicy policy)
+	: m_Name(std::move(name)), m_Depth((std::max)(depth, (size_t)1)), m_Policy(policy)
+{
+}
+
+bool FrameSubscription::Wait(BusFramePtr& frame, int timeoutMs)
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	const auto ready = [this] { return m_Cancelled || !m_Queue.empty(); };
+	if (timeoutMs < 0)
+		m_Cv.wait(lock, ready);
+	else if (!m_Cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready))
+		return false;
+	if (m_Cancelled)
+		return false;
+
+	frame = std::move(m_Queue.front());
+	m_Queue.pop_front();
+	m_Stats.queued = m_Queue.size();
+	return true;
+}
+
+bool FrameSubscription::TryPop(BusFramePtr& frame)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (m_Cancelled || m_Queue.empty())
+		return false;
+	frame = std::move(m_Queue.front());
+	m_Queue.pop_front();
+	m_Stats.queued = m_Queue.size();
+	return true;
+}
+
+void FrameSubscription::SetPaused(bool paused)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Paused = paused;
+	if (paused)
+	{
+		m_Queue.clear();
+		m_Stats.queued = 0;
+	}
+}
+
+void FrameSubscription::Cancel()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Cancelled = true;
+		m_Queue.clear();
+		m_Stats.queued = 0;
+	}
+	m_Cv.notify_all();
+}
+
+FrameSubscriptionStats FrameSubscription::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Stats;
+}
+
+bool FrameSubscription::Push(const BusFramePtr& frame)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_Paused || m_Cancelled)
+			return false;
+		if (m_Queue.size() >= m_Depth)
+		{
+			m_Stats.dropped++;
+			if (m_Policy == FrameDropNewest)
+				return false;
+			m_Queue.pop_front();
+		}
+		m_Queue.push_back(frame);
+		m_Stats.delivered++;
+		m_Stats.queued = m_Queue.size();
+		m_Stats.maxQueued = (std::max)(m_Stats.maxQueued, m_Queue.size());
+	}
+	m_Cv.notify_one();
+	return true;
+}
+
+FrameSubscriptionPtr FrameBus::Subscribe(const std::string& name, size_t depth, FrameDropPolicy policy)
+{
+	auto subscription = std::make_shared<FrameSubscription>(name, depth, policy);
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Subscriptions.push_back(subscription);
+	return subscription;
+}
+
+void FrameBus::Unsubscribe(const FrameSubscriptionPtr& subscription)
+{
+	if (!subscription)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Subscriptions.erase(std::remove(m_Subscriptions.begin(), m_Subscriptions.end(), subscription), m_Subscriptions.end());
+	}
+	subscription->Cancel();
+}
+
+size_t FrameBus::Publish(BusFrame&& frame)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	frame.sequence = ++m_Sequence;
+	if (m_Subscriptions.empty())
+		return 0;
+
+	/* One immutable frame for everybody; subscribers only add references */
+	const BusFramePtr shared = std::make_shared<const BusFrame>(std::move(frame));
+	size_t queued = 0;
+	for (const FrameSubscriptionPtr& subscription : m_Subscriptions)
+	{
+		if (subscription->Push(shared))
+			queued++;
+	}
+	return queued;
+}
+
+bool FrameBus::HasSubscribers() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return std::any_of(m_Subscriptions.begin(), m_Subscriptions.end(), [](const FrameSubscriptionPtr& subscription)
+	{
+		return !subscription->m_Paused;
+	});
+}
+
+void FrameBus::Close()
+{
+	std::vector<FrameSubscriptionPtr> subscriptions;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		subscriptions.swap(m_Subscriptions);
+	}
+	for (const FrameSubscriptionPtr& subscription : subscriptions)
+		subscription->Cancel();
+}
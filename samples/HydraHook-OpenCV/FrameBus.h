@@ -0,0 +1,141 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Perception.h"
+
+#include <opencv2/core.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One captured frame and what was derived from it at readback.
+ *
+ * Published frames are immutable and shared by every subscriber; the Mats are pooled
+ * (FramePool) and go back to the pool once the last subscriber drops the frame.
+ */
+struct BusFrame
+{
+	uint64_t sequence = 0;		/* assigned by FrameBus::Publish */
+	FrameTag tag;
+	cv::Size frameSize;			/* swap chain size the frame was captured at */
+	cv::Mat image;				/* analysis frame, CV_8UC1 */
+	FrameStats stats;
+	cv::Mat inferenceBlob;		/* empty unless inference runs */
+	cv::Mat colorCrop;			/* R8G8B8A8 crop of the color rule ROIs, empty unless blobs are extracted */
+	cv::Point colorOrigin;
+	std::shared_ptr<const PerceptionResults> results;	/* set on frames republished after analysis */
+};
+
+typedef std::shared_ptr<const BusFrame> BusFramePtr;
+
+enum FrameDropPolicy
+{
+	FrameDropOldest,	/* a full queue discards its oldest frame; for consumers that want the newest frame */
+	FrameDropNewest		/* a full queue rejects the incoming frame; for consumers that want consecutive frames */
+};
+
+struct FrameSubscriptionStats
+{
+	uint64_t delivered = 0;		/* frames queued for the subscriber */
+	uint64_t dropped = 0;		/* frames lost to a full queue */
+	size_t queued = 0;
+	size_t maxQueued = 0;
+};
+
+/**
+ * @brief A subscriber's queue; the subscriber only ever sees const frames.
+ *
+ * Several threads may wait on the same subscription, each frame goes to one of them.
+ */
+class FrameSubscription
+{
+public:
+	FrameSubscription(std::string name, size_t depth, FrameDropPolicy policy);
+
+	const std::string& Name() const { return m_Name; }
+
+	/* Waits up to timeoutMs (negative waits forever); false on timeout or once cancelled */
+	bool Wait(BusFramePtr& frame, int timeoutMs = -1);
+	bool TryPop(BusFramePtr& frame);
+
+	/* A paused subscription receives nothing and holds no frames */
+	void SetPaused(bool paused);
+	void Cancel();
+	bool IsCancelled() const { return m_Cancelled; }
+
+	FrameSubscriptionStats GetStats() const;
+
+private:
+	friend class FrameBus;
+	bool Push(const BusFramePtr& frame);
+
+	const std::string m_Name;
+	const size_t m_Depth;
+	const FrameDropPolicy m_Policy;
+	std::atomic<bool> m_Paused{ false };
+	std::atomic<bool> m_Cancelled{ false };
+
+	mutable std::mutex m_Mutex;
+	std::condition_variable m_Cv;
+	std::deque<BusFramePtr> m_Queue;
+	FrameSubscriptionStats m_Stats;
+};
+
+typedef std::shared_ptr<FrameSubscription> FrameSubscriptionPtr;
+
+/**
+ * @brief Fans captured frames out to any number of subscribers without copying them.
+ *
+ * Publish never blocks: it appends one reference per subscriber, and each subscriber's
+ * queue depth and drop policy decide what happens when that subscriber falls behind.
+ */
+class FrameBus
+{
+public:
+	~FrameBus() { Close(); }
+
+	FrameSubscriptionPtr Subscribe(const std::string& name, size_t depth, FrameDropPolicy policy);
+	void Unsubscribe(const FrameSubscriptionPtr& subscription);
+
+	/* Assigns the sequence number; returns the number of subscribers that queued the frame */
+	size_t Publish(BusFrame&& frame);
+	bool HasSubscribers() const;
+
+	/* Cancels and removes every subscription, e.g. on shutdown */
+	void Close();
+
+private:
+	mutable std::mutex m_Mutex;
+	std::vector<FrameSubscriptionPtr> m_Subscriptions;
+	uint64_t m_Sequence = 0;
+};
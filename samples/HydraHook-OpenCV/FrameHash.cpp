@@ -0,0 +1,181 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "FrameHash.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <iterator>
+
+static constexpr int FRAMEHASH_PHASH_SIZE = 32;
+static constexpr int FRAMEHASH_PHASH_BAND = 8;
+
+/**
+ * @brief dHash bits from a 9x8 thumbnail: bit (y*8 + x) is set if pixel x is brighter than pixel x + 1.
+ */
+static uint64_t FrameHash_Difference(const cv::Mat& thumb)
+{
+	const __m128i bias = _mm_set1_epi8((char)0x80);
+	uint64_t hash = 0;
+	for (int y = 0; y < 8; y++)
+	{
+		const uint8_t* row = thumb.ptr<uint8_t>(y);
+		/* unsigned compare via sign flip; both loads stay inside the 9-byte row */
+		const __m128i left = _mm_xor_si128(_mm_loadl_epi64((const __m128i*)row), bias);
+		const __m128i right = _mm_xor_si128(_mm_loadl_epi64((const __m128i*)(row + 1)), bias);
+		const uint64_t bits = (uint64_t)(_mm_movemask_epi8(_mm_cmpgt_epi8(left, right)) & 0xFF);
+		hash |= bits << (y * 8);
+	}
+	return hash;
+}
+
+/**
+ * @brief pHash bits: the 8x8 lowest-frequency DCT coefficients thresholded at their median (DC excluded).
+ */
+static uint64_t FrameHash_Perceptual(const cv::Mat& thumb)
+{
+	static thread_local cv::Mat coeffs;
+	cv::dct(thumb, coeffs);
+
+	float band[FRAMEHASH_PHASH_BAND * FRAMEHASH_PHASH_BAND];
+	for (int y = 0; y < FRAMEHASH_PHASH_BAND; y++)
+	{
+		const float* row = coeffs.ptr<float>(y);
+		for (int x = 0; x < FRAMEHASH_PHASH_BAND; x++)
+			band[y * FRAMEHASH_PHASH_BAND + x] = row[x];
+	}
+
+	float sorted[FRAMEHASH_PHASH_BAND * FRAMEHASH_PHASH_BAND - 1];
+	std::copy(band + 1, band + FRAMEHASH_PHASH_BAND * FRAMEHASH_PHASH_BAND, sorted);
+	const int mid = (int)(std::size(sorted) / 2);
+	std::nth_element(sorted, sorted + mid, sorted + std::size(sorted));
+	const __m128 median = _mm_set1_ps(sorted[mid]);
+
+	uint64_t hash = 0;
+	for (int i = 0; i < FRAMEHASH_PHASH_BAND * FRAMEHASH_PHASH_BAND; i += 4)
+	{
+		const uint64_t bits = (uint64_t)_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(band + i), median));
+		hash |= bits << i;
+	}
+	return hash;
+}
+
+FrameFingerprint FrameHash_Compute(const cv::Mat& gray)
+{
+	FrameFingerprint fp;
+	if (gray.empty() || gray.type() != CV_8UC1)
+		return fp;
+
+	static thread_local cv::Mat dThumb, pThumb, pThumbF;
+	cv::resize(gray, dThumb, cv::Size(9, 8), 0, 0, cv::INTER_AREA);
+	cv::resize(gray, pThumb, cv::Size(FRAMEHASH_PHASH_SIZE, FRAMEHASH_PHASH_SIZE), 0, 0, cv::INTER_AREA);
+	pThumb.convertTo(pThumbF, CV_32F);
+
+	fp.dHash = FrameHash_Difference(dThumb);
+	fp.pHash = FrameHash_Perceptual(pThumbF);
+	return fp;
+}
+
+void FrameHashIndex::Clear()
+{
+	m_Nodes.clear();
+}
+
+void FrameHashIndex::Reserve(size_t count)
+{
+	m_Nodes.reserve(count);
+}
+
+void FrameHashIndex::Insert(uint64_t hash)
+{
+	const int32_t index = (int32_t)m_Nodes.size();
+	m_Nodes.push_back({ hash, -1, -1, 0 });
+	if (index == 0)
+		return;
+
+	int32_t node = 0;
+	for (;;)
+	{
+		const int d = FrameHash_Distance(hash, m_Nodes[node].hash);
+		if (d == 0)
+		{
+			/* exact duplicate; keep the tree unchanged */
+			m_Nodes.pop_back();
+			return;
+		}
+
+		int32_t child = m_Nodes[node].firstChild;
+		while (child != -1 && m_Nodes[child].distance != d)
+			child = m_Nodes[child].nextSibling;
+
+		if (child == -1)
+		{
+			m_Nodes[index].distance = d;
+			m_Nodes[index].nextSibling = m_Nodes[node].firstChild;
+			m_Nodes[node].firstChild = index;
+			return;
+		}
+		node = child;
+	}
+}
+
+int FrameHashIndex::FindNearest(uint64_t hash, int radius) const
+{
+	if (m_Nodes.empty())
+		return -1;
+
+	int best = -1;
+	m_Stack.clear();
+	m_Stack.push_back(0);
+
+	while (!m_Stack.empty())
+	{
+		const Node& node = m_Nodes[m_Stack.back()];
+		m_Stack.pop_back();
+
+		const int d = FrameHash_Distance(hash, node.hash);
+		if (d <= radius && (best == -1 || d < best))
+		{
+			best = d;
+			if (d == 0)
+				break;
+			/* later candidates must beat the current best */
+			radius = d - 1;
+		}
+
+		for (int32_t child = node.firstChild; child != -1; child = m_Nodes[child].nextSibling)
+		{
+			const int cd = m_Nodes[child].distance;
+			if (cd >= d - radius && cd <= d + radius)
+				m_Stack.push_back(child);
+		}
+	}
+	return best;
+}
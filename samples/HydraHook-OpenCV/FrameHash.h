@@ -0,0 +1,89 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Hamming.h"
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 64-bit perceptual fingerprints of a gray frame.
+ */
+struct FrameFingerprint
+{
+	uint64_t dHash = 0;		/* sign of horizontal gradients on a 9x8 thumbnail */
+	uint64_t pHash = 0;		/* low 8x8 DCT coefficients of a 32x32 thumbnail against their median */
+};
+
+enum FrameHashKind
+{
+	FrameHashDifference,
+	FrameHashPerceptual
+};
+
+static inline int FrameHash_Distance(uint64_t a, uint64_t b)
+{
+	return Hamming_Popcount64(a ^ b);
+}
+
+static inline uint64_t FrameHash_Select(const FrameFingerprint& fp, FrameHashKind kind)
+{
+	return kind == FrameHashDifference ? fp.dHash : fp.pHash;
+}
+
+FrameFingerprint FrameHash_Compute(const cv::Mat& gray);
+
+/**
+ * @brief BK-tree over 64-bit hashes answering Hamming-radius queries.
+ *
+ * Nodes are stored first-child/next-sibling in one vector, so an index of N hashes is N * 24 bytes
+ * and queries only visit children whose edge distance lies within [d - radius, d + radius].
+ * Not thread-safe; the capture worker owns the dedup index.
+ */
+class FrameHashIndex
+{
+public:
+	void Clear();
+	void Reserve(size_t count);
+	size_t Size() const { return m_Nodes.size(); }
+	void Insert(uint64_t hash);
+
+	/* Returns the distance of the closest stored hash within radius, or -1 */
+	int FindNearest(uint64_t hash, int radius) const;
+
+private:
+	struct Node
+	{
+		uint64_t hash;
+		int32_t firstChild;
+		int32_t nextSibling;
+		int32_t distance;	/* distance to the parent */
+	};
+
+	std::vector<Node> m_Nodes;
+	mutable std::vector<int32_t> m_Stack;
+};
@@ -0,0 +1,242 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "FramePool.h"
+#include <HydraHook/Engine/HydraHookCore.h>
+
+#include <malloc.h>
+
+#include <algorithm>
+
+static constexpr size_t FRAME_POOL_ALIGNMENT = 64;
+/* Idle buffers kept per shape; more than the capture path ever has in flight */
+static constexpr size_t FRAME_POOL_MAX_IDLE_PER_SHAPE = 8;
+
+FramePool::~FramePool()
+{
+	Trim();
+}
+
+void FramePool::Trim()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	/* Buffers still in use are freed instead of pooled when they come back */
+	m_Generation++;
+	for (Buffer* buffer : m_Idle)
+		Free(buffer);
+	m_Idle.clear();
+	m_Stats.idleBuffers = 0;
+}
+
+FramePoolStats FramePool::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Stats;
+}
+
+cv::UMatData* FramePool::allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+	cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const
+{
+	/* Headers over foreign memory are none of the pool's business */
+	if (data)
+		return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+
+	Buffer* buffer = Take(dims, sizes, type);
+	/* Mat::create falls back to the default allocator */
+	if (!buffer)
+		CV_Error(cv::Error::StsNoMem, "FramePool: allocation failed");
+
+	for (int i = 0; i < dims; i++)
+		step[i] = buffer->steps[(size_t)i];
+
+	cv::UMatData* u = new cv::UMatData(this);
+	u->data = u->origdata = (uchar*)buffer->memory;
+	u->size = buffer->steps[0] * (size_t)sizes[0];
+	u->userdata = buffer;
+	return u;
+}
+
+bool FramePool::allocate(cv::UMatData* data, cv::AccessFlag accessFlags, cv::UMatUsageFlags usageFlags) const
+{
+	(void)accessFlags;
+	(void)usageFlags;
+	return data != nullptr;
+}
+
+void FramePool::deallocate(cv::UMatData* data) const
+{
+	if (!data)
+		return;
+	CV_Assert(data->urefcount == 0 && data->refcount == 0);
+	Buffer* buffer = (Buffer*)data->userdata;
+	delete data;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (buffer->generation == m_Generation)
+	{
+		const size_t sameShape = (size_t)std::count_if(m_Idle.begin(), m_Idle.end(), [buffer](const Buffer* idle)
+		{
+			return idle->type == buffer->type && idle->sizes == buffer->sizes;
+		});
+		if (sameShape < FRAME_POOL_MAX_IDLE_PER_SHAPE)
+		{
+			m_Idle.push_back(buffer);
+			m_Stats.idleBuffers++;
+			return;
+		}
+	}
+	Free(buffer);
+}
+
+/**
+ * @brief Most recently returned idle buffer of the shape (still cache-warm), or a new one.
+ */
+FramePool::Buffer* FramePool::Take(int dims, const int* sizes, int type) const
+{
+	const std::vector<int> shape(sizes, sizes + dims);
+	bool largePages = false;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for (auto it = m_Idle.rbegin(); it != m_Idle.rend(); ++it)
+		{
+			Buffer* buffer = *it;
+			if (buffer->type != type || buffer->sizes != shape)
+				continue;
+			m_Idle.erase(std::next(it).base());
+			m_Stats.idleBuffers--;
+			m_Stats.reuses++;
+			return buffer;
+		}
+		largePages = m_LargePages && EnableLargePages();
+	}
+
+	Buffer* buffer = new Buffer();
+	buffer->type = type;
+	buffer->sizes = shape;
+	buffer->steps.resize((size_t)dims);
+	buffer->steps[(size_t)dims - 1] = CV_ELEM_SIZE(type);
+	for (int i = dims - 2; i >= 0; i--)
+		buffer->steps[(size_t)i] = buffer->steps[(size_t)i + 1] * (size_t)sizes[i + 1];
+	/* Every row starts on a cache line, so row-parallel stages never share one */
+	if (dims == 2)
+		buffer->steps[0] = (buffer->steps[0] + FRAME_POOL_ALIGNMENT - 1) & ~(FRAME_POOL_ALIGNMENT - 1);
+	const size_t bytes = buffer->steps[0] * (size_t)sizes[0];
+
+	if (largePages && bytes >= m_LargePageMinimum)
+	{
+		const size_t rounded = (bytes + m_LargePageMinimum - 1) & ~(m_LargePageMinimum - 1);
+		buffer->memory = VirtualAlloc(nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		if (buffer->memory)
+		{
+			buffer->bytes = rounded;
+			buffer->largePage = true;
+		}
+	}
+	/* No contiguous physical large pages left is common after a while; regular pages still work */
+	if (!buffer->memory)
+	{
+		buffer->memory = _aligned_malloc(bytes, FRAME_POOL_ALIGNMENT);
+		buffer->bytes = bytes;
+	}
+	if (!buffer->memory)
+	{
+		delete buffer;
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	buffer->generation = m_Generation;
+	m_Stats.allocations++;
+	m_Stats.liveBuffers++;
+	m_Stats.liveBytes += buffer->bytes;
+	if (buffer->largePage)
+		m_Stats.largePageBuffers++;
+	return buffer;
+}
+
+/**
+ * @brief Returns a buffer's memory to the system; m_Mutex must be held.
+ */
+void FramePool::Free(Buffer* buffer) const
+{
+	if (buffer->largePage)
+		VirtualFree(buffer->memory, 0, MEM_RELEASE);
+	else
+		_aligned_free(buffer->memory);
+
+	m_Stats.liveBuffers--;
+	m_Stats.liveBytes -= buffer->bytes;
+	if (buffer->largePage)
+		m_Stats.largePageBuffers--;
+	delete buffer;
+}
+
+/**
+ * @brief Enables SeLockMemoryPrivilege once; m_Mutex must be held.
+ *
+ * The privilege ("Lock pages in memory") has to be granted to the account beforehand,
+ * enabling it only succeeds if the token already holds it.
+ */
+bool FramePool::EnableLargePages() const
+{
+	if (m_LargePageState)
+		return m_LargePageState > 0;
+	m_LargePageState = -1;
+
+	m_LargePageMinimum = GetLargePageMinimum();
+	if (!m_LargePageMinimum)
+	{
+		HydraHookEngineLogWarning("HydraHook-OpenCV: Large pages are not supported, frame pool uses regular pages");
+		return false;
+	}
+
+	HANDLE token = nullptr;
+	if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+	{
+		HydraHookEngineLogWarning("HydraHook-OpenCV: OpenProcessToken failed (%lu), frame pool uses regular pages", GetLastError());
+		return false;
+	}
+
+	TOKEN_PRIVILEGES privileges = {};
+	privileges.PrivilegeCount = 1;
+	privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+	BOOL adjusted = LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid);
+	if (adjusted)
+		adjusted = AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr);
+	/* AdjustTokenPrivileges succeeds without assigning anything if the token lacks the privilege */
+	const DWORD error = GetLastError();
+	CloseHandle(token);
+	if (!adjusted || error == ERROR_NOT_ALL_ASSIGNED)
+	{
+		HydraHookEngineLogWarning("HydraHook-OpenCV: SeLockMemoryPrivilege not held, frame pool uses regular pages");
+		return false;
+	}
+
+	m_LargePageState = 1;
+	HydraHookEngineLogInfo("HydraHook-OpenCV: Frame pool uses large pages (%zu KB) for full-resolution buffers", m_LargePageMinimum / 1024);
+	return true;
+}
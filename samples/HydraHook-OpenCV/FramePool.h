@@ -0,0 +1,97 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+struct FramePoolStats
+{
+	uint64_t allocations = 0;	/* buffers taken from the system */
+	uint64_t reuses = 0;		/* allocations served from an idle buffer */
+	size_t liveBuffers = 0;		/* in use or idle */
+	size_t idleBuffers = 0;
+	size_t liveBytes = 0;
+	size_t largePageBuffers = 0;
+};
+
+/**
+ * @brief Resident cv::MatAllocator for the per-frame images of the capture path.
+ *
+ * A cv::Mat whose allocator is the pool takes its buffer from the pool on create(), and the
+ * buffer goes back when the last Mat sharing it is released, so frames move between stages
+ * by reference and steady-state capture allocates nothing large. Idle buffers are kept per
+ * shape and type; Trim() drops them, e.g. after ResizeBuffers changed every frame size.
+ *
+ * Buffers are 64-byte aligned and 2D rows are padded to a multiple of 64 bytes. With large
+ * pages enabled, buffers of at least one large page are backed by MEM_LARGE_PAGES when the
+ * process holds SeLockMemoryPrivilege, which mostly saves TLB misses on full-resolution copies.
+ *
+ * The pool must outlive every Mat it allocated.
+ */
+class FramePool : public cv::MatAllocator
+{
+public:
+	explicit FramePool(bool largePages = false) : m_LargePages(largePages) {}
+	~FramePool() override;
+
+	FramePool(const FramePool&) = delete;
+	FramePool& operator=(const FramePool&) = delete;
+
+	void Trim();
+	FramePoolStats GetStats() const;
+
+	cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+		cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override;
+	bool allocate(cv::UMatData* data, cv::AccessFlag accessFlags, cv::UMatUsageFlags usageFlags) const override;
+	void deallocate(cv::UMatData* data) const override;
+
+private:
+	struct Buffer
+	{
+		void* memory = nullptr;
+		size_t bytes = 0;
+		bool largePage = false;
+		uint64_t generation = 0;
+		int type = 0;
+		std::vector<int> sizes;
+		std::vector<size_t> steps;
+	};
+
+	Buffer* Take(int dims, const int* sizes, int type) const;
+	void Free(Buffer* buffer) const;
+	bool EnableLargePages() const;
+
+	const bool m_LargePages;
+	mutable std::mutex m_Mutex;
+	mutable std::vector<Buffer*> m_Idle;
+	mutable FramePoolStats m_Stats;
+	mutable uint64_t m_Generation = 0;
+	mutable int m_LargePageState = 0;	/* 0 = not tried, 1 = available, -1 = unavailable */
+	mutable size_t m_LargePageMinimum = 0;
+};
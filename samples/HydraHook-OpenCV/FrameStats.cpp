@@ -0,0 +1,197 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "FrameStats.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/* An average tile color shift of this many levels counts as a complete change */
+static constexpr float FRAMESTATS_TILE_DISTANCE_SCALE = 64.0f;
+/* Frames with less luma spread are flat: fades to black, white flashes, plain loading screens */
+static constexpr float FRAMESTATS_BLANK_STDDEV = 6.0f;
+
+void FrameStatsAccumulator::Begin(int srcWidth, cv::Size dstSize)
+{
+	m_SrcWidth = srcWidth;
+	m_DstSize = dstSize;
+	memset(m_Histogram, 0, sizeof(m_Histogram));
+	m_Sum = 0;
+	m_SumSq = 0;
+	memset(m_TileSum, 0, sizeof(m_TileSum));
+	memset(m_TileSumSq, 0, sizeof(m_TileSumSq));
+	memset(m_TileCount, 0, sizeof(m_TileCount));
+}
+
+/**
+ * @brief Adds one analysis row and the R8G8B8A8 source row it was started from.
+ */
+void FrameStatsAccumulator::AddRow(const uint8_t* srcRow, const uint8_t* grayRow, int dy)
+{
+	const int width = m_DstSize.width;
+	const __m128i zero = _mm_setzero_si128();
+
+	/* Luma sum via psadbw, sum of squares via pmaddwd; 32-bit lanes hold a 4K row of 255^2 */
+	__m128i sum = zero;
+	__m128i sumSq = zero;
+	int x = 0;
+	for (; x + 16 <= width; x += 16)
+	{
+		const __m128i v = _mm_loadu_si128((const __m128i*)(grayRow + x));
+		sum = _mm_add_epi64(sum, _mm_sad_epu8(v, zero));
+		const __m128i lo = _mm_unpacklo_epi8(v, zero);
+		const __m128i hi = _mm_unpackhi_epi8(v, zero);
+		sumSq = _mm_add_epi32(sumSq, _mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi)));
+	}
+	alignas(16) uint64_t sumLanes[2];
+	alignas(16) uint32_t sumSqLanes[4];
+	_mm_store_si128((__m128i*)sumLanes, sum);
+	_mm_store_si128((__m128i*)sumSqLanes, sumSq);
+	m_Sum += sumLanes[0] + sumLanes[1];
+	m_SumSq += (uint64_t)sumSqLanes[0] + sumSqLanes[1] + sumSqLanes[2] + sumSqLanes[3];
+	for (; x < width; x++)
+	{
+		m_Sum += grayRow[x];
+		m_SumSq += (uint32_t)grayRow[x] * grayRow[x];
+	}
+
+	x = 0;
+	for (; x + 4 <= width; x += 4)
+	{
+		m_Histogram[0][grayRow[x]]++;
+		m_Histogram[1][grayRow[x + 1]]++;
+		m_Histogram[2][grayRow[x + 2]]++;
+		m_Histogram[3][grayRow[x + 3]]++;
+	}
+	for (; x < width; x++)
+		m_Histogram[0][grayRow[x]]++;
+
+	/* Color moments: the source pixel at the left edge of every analysis column */
+	const int ty = (std::min)(dy * FRAMESTATS_TILES_Y / m_DstSize.height, FRAMESTATS_TILES_Y - 1);
+	const uint64_t step = ((uint64_t)m_SrcWidth << 16) / (uint64_t)width;
+	for (int tx = 0; tx < FRAMESTATS_TILES_X; tx++)
+	{
+		const int x0 = tx * width / FRAMESTATS_TILES_X;
+		const int x1 = (tx + 1) * width / FRAMESTATS_TILES_X;
+		__m128 tileSum = _mm_setzero_ps();
+		__m128 tileSumSq = _mm_setzero_ps();
+		for (int dx = x0; dx < x1; dx++)
+		{
+			int pixel;
+			memcpy(&pixel, srcRow + ((dx * step) >> 16) * 4, sizeof(pixel));
+			const __m128 rgba = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero));
+			tileSum = _mm_add_ps(tileSum, rgba);
+			tileSumSq = _mm_add_ps(tileSumSq, _mm_mul_ps(rgba, rgba));
+		}
+		alignas(16) float s[4];
+		alignas(16) float sq[4];
+		_mm_store_ps(s, tileSum);
+		_mm_store_ps(sq, tileSumSq);
+		for (int c = 0; c < 3; c++)
+		{
+			m_TileSum[ty][tx][c] += s[c];
+			m_TileSumSq[ty][tx][c] += sq[c];
+		}
+		m_TileCount[ty][tx] += (uint32_t)(x1 - x0);
+	}
+}
+
+void FrameStatsAccumulator::Finish(FrameStats& out) const
+{
+	const uint32_t count = (uint32_t)m_DstSize.area();
+	out.valid = count != 0;
+	if (!out.valid)
+		return;
+
+	for (int i = 0; i < 256; i++)
+		out.histogram[i] = m_Histogram[0][i] + m_Histogram[1][i] + m_Histogram[2][i] + m_Histogram[3][i];
+	out.pixelCount = count;
+
+	const double mean = (double)m_Sum / count;
+	out.lumaMean = (float)mean;
+	out.lumaStddev = (float)std::sqrt((std::max)((double)m_SumSq / count - mean * mean, 0.0));
+
+	for (int ty = 0; ty < FRAMESTATS_TILES_Y; ty++)
+	{
+		for (int tx = 0; tx < FRAMESTATS_TILES_X; tx++)
+		{
+			const double n = (std::max)(m_TileCount[ty][tx], 1u);
+			for (int c = 0; c < 3; c++)
+			{
+				const double m = m_TileSum[ty][tx][c] / n;
+				out.tileMean[ty][tx][c] = (float)m;
+				out.tileStddev[ty][tx][c] = (float)std::sqrt((std::max)(m_TileSumSq[ty][tx][c] / n - m * m, 0.0));
+			}
+		}
+	}
+}
+
+/**
+ * @brief Bhattacharyya distance of the luma histograms, 0 for identical distributions, 1 for disjoint ones.
+ */
+float FrameStats_HistogramDistance(const FrameStats& a, const FrameStats& b)
+{
+	if (!a.valid || !b.valid)
+		return 0.0f;
+	double coefficient = 0.0;
+	for (int i = 0; i < 256; i++)
+		coefficient += std::sqrt((double)a.histogram[i] * b.histogram[i]);
+	coefficient /= std::sqrt((double)a.pixelCount * b.pixelCount);
+	return (float)std::sqrt((std::max)(1.0 - coefficient, 0.0));
+}
+
+/**
+ * @brief Average RGB shift of the tile means, scaled to [0, 1].
+ *
+ * Catches cuts between scenes of similar brightness that a global histogram misses.
+ */
+float FrameStats_TileDistance(const FrameStats& a, const FrameStats& b)
+{
+	if (!a.valid || !b.valid)
+		return 0.0f;
+	double total = 0.0;
+	for (int ty = 0; ty < FRAMESTATS_TILES_Y; ty++)
+	{
+		for (int tx = 0; tx < FRAMESTATS_TILES_X; tx++)
+			total += cv::norm(a.tileMean[ty][tx] - b.tileMean[ty][tx]);
+	}
+	const double average = total / (FRAMESTATS_TILES_X * FRAMESTATS_TILES_Y);
+	return (float)(std::min)(average / FRAMESTATS_TILE_DISTANCE_SCALE, 1.0);
+}
+
+float FrameStats_SceneCutScore(const FrameStats& prev, const FrameStats& curr)
+{
+	return (std::max)(FrameStats_HistogramDistance(prev, curr), FrameStats_TileDistance(prev, curr));
+}
+
+bool FrameStats_IsBlank(const FrameStats& stats)
+{
+	return stats.valid && stats.lumaStddev < FRAMESTATS_BLANK_STDDEV;
+}
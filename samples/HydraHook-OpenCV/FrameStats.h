@@ -0,0 +1,75 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+
+static constexpr int FRAMESTATS_TILES_X = 8;
+static constexpr int FRAMESTATS_TILES_Y = 8;
+
+/**
+ * @brief Luminance and color statistics of one captured frame.
+ */
+struct FrameStats
+{
+	uint32_t histogram[256] = {};	/* luma of the analysis frame */
+	uint32_t pixelCount = 0;
+	float lumaMean = 0.0f;
+	float lumaStddev = 0.0f;
+	cv::Vec3f tileMean[FRAMESTATS_TILES_Y][FRAMESTATS_TILES_X];		/* RGB, one source pixel per analysis pixel */
+	cv::Vec3f tileStddev[FRAMESTATS_TILES_Y][FRAMESTATS_TILES_X];
+	bool valid = false;
+};
+
+/**
+ * @brief Collects FrameStats row by row while the readback is converted.
+ *
+ * Downscale_RgbaToGray hands over every analysis row together with the source row it was
+ * started from, so both are still in cache: luma statistics cover every analysis pixel,
+ * color moments sample the source row once per analysis column.
+ */
+class FrameStatsAccumulator
+{
+public:
+	void Begin(int srcWidth, cv::Size dstSize);
+	void AddRow(const uint8_t* srcRow, const uint8_t* grayRow, int dy);
+	void Finish(FrameStats& out) const;
+
+private:
+	int m_SrcWidth = 0;
+	cv::Size m_DstSize;
+	uint32_t m_Histogram[4][256];	/* interleaved so consecutive equal pixels don't serialize on one counter */
+	uint64_t m_Sum = 0;
+	uint64_t m_SumSq = 0;
+	double m_TileSum[FRAMESTATS_TILES_Y][FRAMESTATS_TILES_X][3];
+	double m_TileSumSq[FRAMESTATS_TILES_Y][FRAMESTATS_TILES_X][3];
+	uint32_t m_TileCount[FRAMESTATS_TILES_Y][FRAMESTATS_TILES_X];
+};
+
+float FrameStats_HistogramDistance(const FrameStats& a, const FrameStats& b);
+float FrameStats_TileDistance(const FrameStats& a, const FrameStats& b);
+float FrameStats_SceneCutScore(const FrameStats& prev, const FrameStats& curr);
+bool FrameStats_IsBlank(const FrameStats& stats);
@@ -0,0 +1,442 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "FrameStream.h"
+#include <HydraHook/Engine/HydraHookCore.h>
+
+#include <ws2tcpip.h>
+
+#include <opencv2/core/utility.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#pragma comment(lib, "ws2_32.lib")
+
+#define FRAME_STREAM_BOUNDARY "hydrahookframe"
+
+/* A viewer that has not taken a single byte for this long is dropped */
+static constexpr DWORD FRAME_STREAM_SEND_TIMEOUT_MS = 5000;
+static constexpr DWORD FRAME_STREAM_REQUEST_TIMEOUT_MS = 1000;
+static constexpr size_t FRAME_STREAM_MAX_REQUEST = 4096;
+
+struct FrameStreamServer::Client
+{
+	std::atomic<SOCKET> socket{ INVALID_SOCKET };	/* closed by whoever exchanges it out first */
+	std::thread thread;
+	std::atomic<bool> done{ false };
+};
+
+static void FrameStream_CloseSocket(std::atomic<SOCKET>& socket)
+{
+	const SOCKET s = socket.exchange(INVALID_SOCKET);
+	if (s != INVALID_SOCKET)
+		closesocket(s);
+}
+
+/**
+ * @brief Writes every buffer; blocking sockets only return once all of it is queued or the send timed out.
+ */
+static bool FrameStream_Send(SOCKET s, WSABUF* buffers, DWORD count)
+{
+	DWORD total = 0;
+	for (DWORD i = 0; i < count; i++)
+		total += buffers[i].len;
+	DWORD sent = 0;
+	return WSASend(s, buffers, count, &sent, 0, nullptr, nullptr) == 0 && sent == total;
+}
+
+/**
+ * @brief Consumes the viewer's HTTP request; the path is ignored, every request gets the stream.
+ */
+static bool FrameStream_ReadRequest(SOCKET s)
+{
+	std::string request;
+	char buffer[512];
+	while (request.size() < FRAME_STREAM_MAX_REQUEST && request.find("\r\n\r\n") == std::string::npos)
+	{
+		const int n = recv(s, buffer, sizeof(buffer), 0);
+		if (n <= 0)
+			return false;
+		request.append(buffer, (size_t)n);
+	}
+	return true;
+}
+
+/**
+ * @brief Draws the results the frame was analyzed with; colors follow the in-game overlay.
+ */
+static void FrameStream_Annotate(const cv::Mat& image, const PerceptionResults& res, cv::Mat& bgr)
+{
+	/* The published frame is shared with the capture path, drawing goes to a private copy */
+	if (image.channels() == 1)
+		cv::cvtColor(image, bgr, cv::COLOR_GRAY2BGR);
+	else
+		image.copyTo(bgr);
+
+	const cv::Scalar colPoint(0, 255, 0);
+	const cv::Scalar colVector(0, 200, 255);
+	const cv::Scalar colTemplate(255, 160, 0);
+	const cv::Scalar colTracked(0, 255, 255);
+	const cv::Scalar colOccluded(60, 60, 255);
+	const cv::Scalar colDetection(0, 140, 255);
+	const cv::Scalar colBlob(255, 255, 255);
+
+	const size_t points = (std::min)(res.prevPts.size(), res.currPts.size());
+	for (size_t i = 0; i < points; i++)
+	{
+		cv::line(bgr, res.prevPts[i], res.currPts[i], colVector, 1, cv::LINE_AA);
+		cv::circle(bgr, res.currPts[i], 2, colPoint, cv::FILLED);
+	}
+
+	for (const TemplateMatchResult& match : res.templateMatches)
+	{
+		if (!match.found)
+			continue;
+		cv::rectangle(bgr, cv::Rect(match.box), colTemplate, 1);
+		cv::putText(bgr, match.name, cv::Point((int)match.box.x, (int)match.box.y - 3), cv::FONT_HERSHEY_PLAIN, 1.0, colTemplate);
+	}
+
+	for (const TrackedObject& object : res.trackedObjects)
+	{
+		const cv::Scalar& col = object.occluded ? colOccluded : colTracked;
+		cv::rectangle(bgr, cv::Rect(object.box), col, 1);
+		cv::putText(bgr, std::to_string(object.id), cv::Point((int)object.box.x, (int)object.box.y - 3), cv::FONT_HERSHEY_PLAIN, 1.0, col);
+	}
+
+	for (const InferenceDetection& detection : res.inference.detections)
+	{
+		char label[32];
+		snprintf(label, sizeof(label), "%d %.2f", detection.classId, detection.score);
+		cv::rectangle(bgr, cv::Rect(detection.box), colDetection, 2);
+		cv::putText(bgr, label, cv::Point((int)detection.box.x, (int)detection.box.y - 3), cv::FONT_HERSHEY_PLAIN, 1.0, colDetection);
+	}
+
+	/* Blobs are in swap chain coordinates */
+	const float toFrame = res.frameScale > 0.0f ? 1.0f / res.frameScale : 1.0f;
+	for (const ColorBlobGroup& group : res.colorBlobs)
+	{
+		for (const ColorBlob& blob : group.blobs)
+		{
+			const cv::Rect2f box((float)blob.box.x * toFrame, (float)blob.box.y * toFrame, (float)blob.box.width * toFrame, (float)blob.box.height * toFrame);
+			cv::rectangle(bgr, cv::Rect(box), colBlob, 1);
+		}
+	}
+
+	char status[128];
+	snprintf(status, sizeof(status), "#%llu  %d/%d inliers%s%s%s", (unsigned long long)res.tag.presentIndex, res.inliers, res.featureCount,
+		res.duplicateFrame ? "  DUP" : "", res.sceneCut ? "  CUT" : "", res.blankFrame ? "  BLANK" : "");
+	cv::putText(bgr, status, cv::Point(6, 18), cv::FONT_HERSHEY_PLAIN, 1.2, cv::Scalar(0, 0, 0), 3);
+	cv::putText(bgr, status, cv::Point(6, 18), cv::FONT_HERSHEY_PLAIN, 1.2, cv::Scalar(255, 255, 255), 1);
+}
+
+bool FrameStreamServer::Start(const FrameStreamSettings& settings, FrameBus& bus)
+{
+	Stop();
+
+	WSADATA wsaData;
+	const int startupError = WSAStartup(MAKEWORD(2, 2), &wsaData);
+	if (startupError != 0)
+	{
+		HydraHookEngineLogError("HydraHook-OpenCV: WSAStartup failed: %d", startupError);
+		return false;
+	}
+
+	SOCKET listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listenSocket == INVALID_SOCKET)
+	{
+		HydraHookEngineLogError("HydraHook-OpenCV: Failed to create stream socket: %d", WSAGetLastError());
+		WSACleanup();
+		return false;
+	}
+
+	/* Nobody else may bind the same port and read the stream */
+	const BOOL exclusive = TRUE;
+	setsockopt(listenSocket, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, (const char*)&exclusive, sizeof(exclusive));
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(settings.port);
+	address.sin_addr.s_addr = htonl(settings.loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+	int addressLength = sizeof(address);
+	if (bind(listenSocket, (const sockaddr*)&address, sizeof(address)) == SOCKET_ERROR
+		|| listen(listenSocket, SOMAXCONN) == SOCKET_ERROR
+		|| getsockname(listenSocket, (sockaddr*)&address, &addressLength) == SOCKET_ERROR)
+	{
+		HydraHookEngineLogError("HydraHook-OpenCV: Failed to listen on stream port %u: %d", settings.port, WSAGetLastError());
+		closesocket(listenSocket);
+		WSACleanup();
+		return false;
+	}
+
+	m_Settings = settings;
+	m_Settings.encoderThreads = (std::max)(settings.encoderThreads, 1);
+	m_Settings.quality = (std::min)((std::max)(settings.quality, 0), 100);
+	m_Settings.maxClients = (std::max)(settings.maxClients, 1);
+	m_Listen = listenSocket;
+	m_Port = ntohs(address.sin_port);
+	m_Latest.reset();
+	m_Stats = FrameStreamStats();
+	m_Bus = &bus;
+	m_Subscription = bus.Subscribe("stream", 1, FrameDropOldest);
+	m_Subscription->SetPaused(true);
+	m_Running = true;
+
+	for (int i = 0; i < m_Settings.encoderThreads; i++)
+		m_Encoders.emplace_back(&FrameStreamServer::EncoderThreadProc, this);
+	m_AcceptThread = std::thread(&FrameStreamServer::AcceptThreadProc, this);
+
+	HydraHookEngineLogInfo("HydraHook-OpenCV: Streaming MJPEG on http://%s:%u/ (%d encoder threads, quality %d)",
+		m_Settings.loopbackOnly ? "127.0.0.1" : "0.0.0.0", m_Port, m_Settings.encoderThreads, m_Settings.quality);
+	return true;
+}
+
+void FrameStreamServer::Stop()
+{
+	if (!m_Running.exchange(false))
+		return;
+
+	/* closesocket cancels the blocking accept, recv and send calls of the other threads */
+	closesocket(m_Listen);
+	m_Listen = INVALID_SOCKET;
+	{
+		std::lock_guard<std::mutex> lock(m_ClientMutex);
+		for (const auto& client : m_Clients)
+			FrameStream_CloseSocket(client->socket);
+	}
+	m_ClientCv.notify_all();
+	/* Cancelling wakes the encoders */
+	m_Bus->Unsubscribe(m_Subscription);
+
+	if (m_AcceptThread.joinable())
+		m_AcceptThread.join();
+	for (std::thread& encoder : m_Encoders)
+	{
+		if (encoder.joinable())
+			encoder.join();
+	}
+	m_Encoders.clear();
+	ReapClients(true);
+	m_Latest.reset();
+	m_Subscription.reset();
+	m_Bus = nullptr;
+
+	WSACleanup();
+}
+
+FrameStreamStats FrameStreamServer::GetStats() const
+{
+	FrameStreamStats stats;
+	{
+		std::lock_guard<std::mutex> lock(m_ClientMutex);
+		stats = m_Stats;
+	}
+	stats.published = m_Subscription ? m_Subscription->GetStats().delivered : 0;
+	stats.clients = m_ClientCount;
+	return stats;
+}
+
+void FrameStreamServer::AcceptThreadProc()
+{
+	while (m_Running)
+	{
+		const SOCKET s = accept(m_Listen, nullptr, nullptr);
+		if (s == INVALID_SOCKET)
+		{
+			if (m_Running)
+				Sleep(50);
+			continue;
+		}
+
+		ReapClients(false);
+
+		const BOOL noDelay = TRUE;
+		const DWORD sendTimeout = FRAME_STREAM_SEND_TIMEOUT_MS;
+		const DWORD recvTimeout = FRAME_STREAM_REQUEST_TIMEOUT_MS;
+		setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+		setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, (const char*)&sendTimeout, sizeof(sendTimeout));
+		setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char*)&recvTimeout, sizeof(recvTimeout));
+
+		std::lock_guard<std::mutex> lock(m_ClientMutex);
+		if (!m_Running)
+		{
+			closesocket(s);
+			break;
+		}
+		if (m_Clients.size() >= (size_t)m_Settings.maxClients)
+		{
+			static const char busy[] = "HTTP/1.0 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+			send(s, busy, sizeof(busy) - 1, 0);
+			closesocket(s);
+			continue;
+		}
+
+		auto client = std::make_shared<Client>();
+		client->socket = s;
+		m_Clients.push_back(client);
+		if (m_ClientCount++ == 0)
+			m_Subscription->SetPaused(false);
+		client->thread = std::thread(&FrameStreamServer::ClientThreadProc, this, client);
+	}
+}
+
+void FrameStreamServer::EncoderThreadProc()
+{
+	const std::vector<int> params = { cv::IMWRITE_JPEG_QUALITY, m_Settings.quality };
+	cv::Mat annotated;
+
+	for (;;)
+	{
+		BusFramePtr frame;
+		if (!m_Subscription->Wait(frame))
+			return;
+		if (frame->image.empty())
+			continue;
+
+		const int64 start = cv::getTickCount();
+		auto encoded = std::make_shared<Encoded>();
+		encoded->sequence = frame->sequence;
+		try
+		{
+			/* annotated is this encoder's own buffer, the bus frame is only read */
+			const bool annotate = m_Settings.annotate && frame->results;
+			if (annotate)
+				FrameStream_Annotate(frame->image, *frame->results, annotated);
+			if (!cv::imencode(".jpg", annotate ? annotated : frame->image, encoded->jpeg, params))
+				continue;
+		}
+		catch (const cv::Exception& ex)
+		{
+			HydraHookEngineLogWarning("HydraHook-OpenCV: Stream frame encoding failed: %s", ex.what());
+			continue;
+		}
+		const float ms = (float)((cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency());
+
+		{
+			std::lock_guard<std::mutex> lock(m_ClientMutex);
+			m_Stats.encoded++;
+			m_Stats.encodeMs = m_Stats.encodeMs > 0.0f ? m_Stats.encodeMs * 0.9f + ms * 0.1f : ms;
+			/* With several encoders a newer frame can finish first */
+			if (m_Latest && m_Latest->sequence > encoded->sequence)
+			{
+				m_Stats.superseded++;
+				continue;
+			}
+			m_Latest = std::move(encoded);
+		}
+		m_ClientCv.notify_all();
+	}
+}
+
+void FrameStreamServer::ClientThreadProc(std::shared_ptr<Client> client)
+{
+	const SOCKET s = client->socket;
+	static const char header[] =
+		"HTTP/1.0 200 OK\r\n"
+		"Content-Type: multipart/x-mixed-replace; boundary=" FRAME_STREAM_BOUNDARY "\r\n"
+		"Cache-Control: no-cache, no-store\r\n"
+		"Pragma: no-cache\r\n"
+		"Connection: close\r\n"
+		"\r\n";
+
+	bool ok = FrameStream_ReadRequest(s);
+	if (ok)
+	{
+		WSABUF buffer = { sizeof(header) - 1, (CHAR*)header };
+		ok = FrameStream_Send(s, &buffer, 1);
+	}
+
+	uint64_t sentSequence = 0;
+	while (ok)
+	{
+		std::shared_ptr<const Encoded> frame;
+		{
+			std::unique_lock<std::mutex> lock(m_ClientMutex);
+			m_ClientCv.wait(lock, [&] { return !m_Running || (m_Latest && m_Latest->sequence > sentSequence); });
+			if (!m_Running)
+				break;
+			frame = m_Latest;
+			if (sentSequence)
+				m_Stats.skipped += frame->sequence - sentSequence - 1;
+		}
+
+		/* The JPEG goes out straight from the shared buffer, only the part header is per viewer */
+		char part[128];
+		const int partLength = snprintf(part, sizeof(part), "--" FRAME_STREAM_BOUNDARY "\r\nContent-Type: image/jpeg\r\nContent-Length: %zu\r\n\r\n", frame->jpeg.size());
+		static const char trailer[] = "\r\n";
+		WSABUF buffers[3] =
+		{
+			{ (ULONG)partLength, part },
+			{ (ULONG)frame->jpeg.size(), (CHAR*)frame->jpeg.data() },
+			{ sizeof(trailer) - 1, (CHAR*)trailer },
+		};
+		ok = FrameStream_Send(s, buffers, 3);
+		sentSequence = frame->sequence;
+		if (ok)
+		{
+			std::lock_guard<std::mutex> lock(m_ClientMutex);
+			m_Stats.sent++;
+			m_Stats.bytesSent += (uint64_t)partLength + frame->jpeg.size() + sizeof(trailer) - 1;
+		}
+	}
+
+	FrameStream_CloseSocket(client->socket);
+	{
+		std::lock_guard<std::mutex> lock(m_ClientMutex);
+		/* Paused under the same lock the accept thread resumes it with */
+		if (--m_ClientCount == 0 && m_Subscription)
+			m_Subscription->SetPaused(true);
+	}
+	client->done = true;
+}
+
+void FrameStreamServer::ReapClients(bool all)
+{
+	std::vector<std::shared_ptr<Client>> finished;
+	{
+		std::lock_guard<std::mutex> lock(m_ClientMutex);
+		for (auto it = m_Clients.begin(); it != m_Clients.end();)
+		{
+			if (all || (*it)->done)
+			{
+				finished.push_back(std::move(*it));
+				it = m_Clients.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+	for (const auto& client : finished)
+	{
+		if (client->thread.joinable())
+			client->thread.join();
+	}
+}
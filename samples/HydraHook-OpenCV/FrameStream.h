@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "FrameBus.h"
+
+#include <winsock2.h>
+
+#include <opencv2/core.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct FrameStreamSettings
+{
+	unsigned short port = 8090;		/* 0 picks a free port, see FrameStreamServer::Port */
+	bool loopbackOnly = true;		/* bind 127.0.0.1; remote viewers go through an SSH tunnel */
+	int encoderThreads = 2;
+	int quality = 75;				/* JPEG quality, 0 - 100 */
+	int maxClients = 4;
+	bool annotate = true;			/* draw the perception results into the streamed frame */
+};
+
+struct FrameStreamStats
+{
+	uint64_t published = 0;		/* frames the bus delivered while a viewer was connected */
+	uint64_t encoded = 0;
+	uint64_t superseded = 0;	/* encoded, but a newer frame finished first */
+	uint64_t sent = 0;			/* frames written to viewers, summed over viewers */
+	uint64_t skipped = 0;		/* frames a viewer never got because it was still busy with an older one */
+	uint64_t bytesSent = 0;
+	size_t clients = 0;
+	float encodeMs = 0.0f;		/* running average per frame, annotation included */
+};
+
+/**
+ * @brief Serves bus frames as a multipart MJPEG stream (any browser, ffplay, VLC) over TCP.
+ *
+ * The server subscribes to a FrameBus with a one-frame, drop-oldest queue; a small encoder pool
+ * annotates (frames carrying results) and JPEG-encodes the newest frame (libjpeg-turbo through
+ * cv::imencode). Each viewer has its own
+ * sender thread that always picks up the newest encoded frame once its previous write completed, so a
+ * slow viewer only sees a lower frame rate and neither the capture worker nor other viewers wait on it.
+ * The subscription is paused while no viewer is connected.
+ */
+class FrameStreamServer
+{
+public:
+	~FrameStreamServer() { Stop(); }
+
+	bool Start(const FrameStreamSettings& settings, FrameBus& bus);
+	void Stop();
+	bool IsRunning() const { return m_Running; }
+	unsigned short Port() const { return m_Port; }
+	bool HasClients() const { return m_ClientCount > 0; }
+
+	FrameStreamStats GetStats() const;
+
+private:
+	struct Client;
+	struct Encoded
+	{
+		uint64_t sequence = 0;
+		std::vector<uchar> jpeg;
+	};
+
+	void AcceptThreadProc();
+	void EncoderThreadProc();
+	void ClientThreadProc(std::shared_ptr<Client> client);
+	void ReapClients(bool all);
+
+	FrameStreamSettings m_Settings;
+	std::atomic<bool> m_Running{ false };
+	std::atomic<size_t> m_ClientCount{ 0 };
+	SOCKET m_Listen = INVALID_SOCKET;
+	unsigned short m_Port = 0;
+	std::thread m_AcceptThread;
+	std::vector<std::thread> m_Encoders;
+	FrameBus* m_Bus = nullptr;
+	FrameSubscriptionPtr m_Subscription;	/* taken by whichever encoder is free */
+
+	/* Newest encoded frame; every viewer keeps its own cursor into this */
+	mutable std::mutex m_ClientMutex;
+	std::condition_variable m_ClientCv;
+	std::shared_ptr<const Encoded> m_Latest;
+	std::vector<std::shared_ptr<Client>> m_Clients;
+	FrameStreamStats m_Stats;
+};
@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "FrameTiming.h"
+#include <HydraHook/Engine/HydraHookCore.h>
+
+#include <intrin.h>
+
+#include <algorithm>
+#include <atomic>
+
+static constexpr double FRAMETIMING_CALIBRATION_MS = 20.0;
+static constexpr double FRAMETIMING_REPORT_INTERVAL_MS = 5000.0;
+/* weight of a new sample in the HUD's running average */
+static constexpr float FRAMETIMING_AVERAGE_WEIGHT = 0.05f;
+
+static bool g_useTsc = false;
+static double g_ticksPerMs = 0.0;
+
+/* Latency stats; only touched from the Present thread */
+static uint64_t g_lastDisplayedCapture = 0;
+static uint64_t g_windowStart = 0;
+static uint32_t g_windowFrames = 0;
+static double g_windowSumMs = 0.0;
+static double g_windowMaxMs = 0.0;
+static uint64_t g_windowSumPresents = 0;
+static std::atomic<float> g_avgMs{ 0.0f };
+static std::atomic<float> g_avgPresents{ 0.0f };
+
+/**
+ * @brief Measures the TSC rate against QueryPerformanceCounter; falls back to QPC without an invariant TSC.
+ */
+void FrameTiming_Calibrate()
+{
+	if (g_ticksPerMs > 0.0)
+		return;
+
+	LARGE_INTEGER qpcFrequency;
+	QueryPerformanceFrequency(&qpcFrequency);
+
+	int info[4];
+	__cpuid(info, 0x80000000);
+	if ((unsigned)info[0] >= 0x80000007)
+	{
+		__cpuid(info, 0x80000007);
+		g_useTsc = (info[3] & (1 << 8)) != 0;	/* invariant TSC */
+	}
+
+	if (!g_useTsc)
+	{
+		g_ticksPerMs = (double)qpcFrequency.QuadPart / 1000.0;
+		HydraHookEngineLogWarning("HydraHook-OpenCV: No invariant TSC, frame timestamps use QPC");
+		return;
+	}
+
+	LARGE_INTEGER qpcStart, qpcNow;
+	QueryPerformanceCounter(&qpcStart);
+	const uint64_t tscStart = __rdtsc();
+	const LONGLONG qpcTarget = qpcStart.QuadPart + (LONGLONG)(qpcFrequency.QuadPart * FRAMETIMING_CALIBRATION_MS / 1000.0);
+	do
+	{
+		YieldProcessor();
+		QueryPerformanceCounter(&qpcNow);
+	}
+	while (qpcNow.QuadPart < qpcTarget);
+	const uint64_t tscEnd = __rdtsc();
+
+	const double elapsedMs = (double)(qpcNow.QuadPart - qpcStart.QuadPart) * 1000.0 / (double)qpcFrequency.QuadPart;
+	g_ticksPerMs = (double)(tscEnd - tscStart) / elapsedMs;
+	HydraHookEngineLogInfo("HydraHook-OpenCV: TSC runs at %.1f MHz", g_ticksPerMs / 1000.0);
+}
+
+uint64_t FrameTiming_Now()
+{
+	if (g_useTsc)
+		return __rdtsc();
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return (uint64_t)now.QuadPart;
+}
+
+double FrameTiming_ToMs(int64_t ticks)
+{
+	return g_ticksPerMs > 0.0 ? (double)ticks / g_ticksPerMs : 0.0;
+}
+
+/**
+ * @brief Records capture-to-display latency the first time results of a captured frame are drawn.
+ */
+void FrameTiming_OnDisplay(const FrameTag& tag, uint64_t presentIndex)
+{
+	if (!tag.captureTicks || tag.captureTicks == g_lastDisplayedCapture)
+		return;
+	g_lastDisplayedCapture = tag.captureTicks;
+
+	const uint64_t now = FrameTiming_Now();
+	const double ms = FrameTiming_ToMs((int64_t)(now - tag.captureTicks));
+	const uint64_t presents = presentIndex - tag.presentIndex;
+
+	const float w = g_avgMs.load() == 0.0f ? 1.0f : FRAMETIMING_AVERAGE_WEIGHT;
+	g_avgMs = g_avgMs.load() * (1.0f - w) + (float)ms * w;
+	g_avgPresents = g_avgPresents.load() * (1.0f - w) + (float)presents * w;
+
+	if (!g_windowStart)
+		g_windowStart = now;
+	g_windowFrames++;
+	g_windowSumMs += ms;
+	g_windowMaxMs = (std::max)(g_windowMaxMs, ms);
+	g_windowSumPresents += presents;
+
+	if (FrameTiming_ToMs((int64_t)(now - g_windowStart)) >= FRAMETIMING_REPORT_INTERVAL_MS)
+	{
+		HydraHookEngineLogInfo(
+			"opencv-latency {\"results\":%u,\"avg_ms\":%.2f,\"max_ms\":%.2f,\"avg_presents\":%.2f}",
+			g_windowFrames, g_windowSumMs / g_windowFrames, g_windowMaxMs, (double)g_windowSumPresents / g_windowFrames);
+		g_windowStart = now;
+		g_windowFrames = 0;
+		g_windowSumMs = 0.0;
+		g_windowMaxMs = 0.0;
+		g_windowSumPresents = 0;
+	}
+}
+
+void FrameTiming_GetLatency(float& avgMs, float& avgPresents)
+{
+	avgMs = g_avgMs;
+	avgPresents = g_avgPresents;
+}
@@ -0,0 +1,270 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "Hamming.h"
+
+#include <immintrin.h>
+#include <intrin.h>
+
+#include <algorithm>
+
+static bool Hamming_OsSupportsXState(unsigned long long mask)
+{
+	int info[4];
+	__cpuid(info, 1);
+	if (!(info[2] & (1 << 27)))		/* OSXSAVE */
+		return false;
+	return (_xgetbv(0) & mask) == mask;
+}
+
+HammingKernel Hamming_GetBestKernel()
+{
+	static const HammingKernel best = []
+	{
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return HammingKernelScalar;
+
+		__cpuidex(info, 7, 0);
+		const bool avx2 = (info[1] & (1 << 5)) != 0;
+		const bool avx512f = (info[1] & (1 << 16)) != 0;
+		const bool vpopcntdq = (info[2] & (1 << 14)) != 0;
+
+		/* XCR0: SSE|AVX state, plus opmask/ZMM state for AVX-512 */
+		if (avx512f && vpopcntdq && Hamming_OsSupportsXState(0xE6))
+			return HammingKernelAvx512;
+		if (avx2 && Hamming_OsSupportsXState(0x06))
+			return HammingKernelAvx2;
+		return HammingKernelScalar;
+	}();
+	return best;
+}
+
+const char* Hamming_GetKernelName(HammingKernel kernel)
+{
+	switch (kernel)
+	{
+	case HammingKernelScalar: return "scalar";
+	case HammingKernelAvx2: return "avx2";
+	case HammingKernelAvx512: return "avx512";
+	default: return Hamming_GetKernelName(Hamming_GetBestKernel());
+	}
+}
+
+static inline int Hamming_Distance(const uint8_t* a, const uint8_t* b)
+{
+	int d = 0;
+	for (int i = 0; i < HAMMING_DESCRIPTOR_BYTES; i += 8)
+	{
+		d += Hamming_Popcount64(*(const uint64_t*)(a + i) ^ *(const uint64_t*)(b + i));
+	}
+	return d;
+}
+
+static inline void Hamming_Keep(HammingMatch& m, int trainIdx, int d)
+{
+	if (d < m.distance)
+	{
+		m.secondDistance = m.distance;
+		m.distance = d;
+		m.trainIdx = trainIdx;
+	}
+	else if (d < m.secondDistance)
+	{
+		m.secondDistance = d;
+	}
+}
+
+static void Hamming_MatchScalar(const uint8_t* q, const uint8_t* train, int count, HammingMatch& m)
+{
+	for (int j = 0; j < count; j++)
+		Hamming_Keep(m, j, Hamming_Distance(q, train + (size_t)j * HAMMING_DESCRIPTOR_BYTES));
+}
+
+static inline __m256i Hamming_PopcountBytes(__m256i v)
+{
+	const __m256i lut = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, nibble));
+	const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+	return _mm256_add_epi8(lo, hi);
+}
+
+static void Hamming_MatchAvx2(const uint8_t* q, const uint8_t* train, int count, HammingMatch& m)
+{
+	const __m256i query = _mm256_loadu_si256((const __m256i*)q);
+	const __m256i zero = _mm256_setzero_si256();
+	int j = 0;
+	for (; j + 4 <= count; j += 4)
+	{
+		const uint8_t* t = train + (size_t)j * HAMMING_DESCRIPTOR_BYTES;
+		/* psadbw leaves four 64-bit partial sums per descriptor */
+		const __m256i s0 = _mm256_sad_epu8(Hamming_PopcountBytes(_mm256_xor_si256(query, _mm256_loadu_si256((const __m256i*)t))), zero);
+		const __m256i s1 = _mm256_sad_epu8(Hamming_PopcountBytes(_mm256_xor_si256(query, _mm256_loadu_si256((const __m256i*)(t + 32)))), zero);
+		const __m256i s2 = _mm256_sad_epu8(Hamming_PopcountBytes(_mm256_xor_si256(query, _mm256_loadu_si256((const __m256i*)(t + 64)))), zero);
+		const __m256i s3 = _mm256_sad_epu8(Hamming_PopcountBytes(_mm256_xor_si256(query, _mm256_loadu_si256((const __m256i*)(t + 96)))), zero);
+
+		/* interleave as 32-bit lanes [a b a b | a b a b], [c d c d | c d c d] and reduce to [a b c d] */
+		const __m256i s01 = _mm256_or_si256(s0, _mm256_slli_epi64(s1, 32));
+		const __m256i s23 = _mm256_or_si256(s2, _mm256_slli_epi64(s3, 32));
+		const __m256i sum = _mm256_add_epi32(_mm256_unpacklo_epi64(s01, s23), _mm256_unpackhi_epi64(s01, s23));
+		const __m128i d = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+
+		alignas(16) int dist[4];
+		_mm_store_si128((__m128i*)dist, d);
+		for (int k = 0; k < 4; k++)
+			Hamming_Keep(m, j + k, dist[k]);
+	}
+	for (; j < count; j++)
+		Hamming_Keep(m, j, Hamming_Distance(q, train + (size_t)j * HAMMING_DESCRIPTOR_BYTES));
+}
+
+static void Hamming_MatchAvx512(const uint8_t* q, const uint8_t* train, int count, HammingMatch& m)
+{
+	const __m512i query = _mm512_broadcast_i64x4(_mm256_loadu_si256((const __m256i*)q));
+	int j = 0;
+	for (; j + 2 <= count; j += 2)
+	{
+		/* one zmm holds two descriptors; vpopcntq gives four 64-bit counts per descriptor */
+		const __m512i x = _mm512_xor_si512(query, _mm512_loadu_si512(train + (size_t)j * HAMMING_DESCRIPTOR_BYTES));
+		const __m512i pc = _mm512_popcnt_epi64(x);
+		const __m256i lo = _mm512_castsi512_si256(pc);
+		const __m256i hi = _mm512_extracti64x4_epi64(pc, 1);
+		const __m256i pairs = _mm256_add_epi64(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+		const __m128i d = _mm_add_epi64(_mm256_castsi256_si128(pairs), _mm256_extracti128_si256(pairs, 1));
+		Hamming_Keep(m, j, _mm_cvtsi128_si32(d));
+		Hamming_Keep(m, j + 1, _mm_cvtsi128_si32(_mm_unpackhi_epi64(d, d)));
+	}
+	for (; j < count; j++)
+		Hamming_Keep(m, j, Hamming_Distance(q, train + (size_t)j * HAMMING_DESCRIPTOR_BYTES));
+}
+
+void Hamming_MatchBruteForce(const cv::Mat& query, const cv::Mat& train, std::vector<HammingMatch>& matches, HammingKernel kernel)
+{
+	matches.assign((size_t)query.rows, HammingMatch());
+	if (query.empty() || train.empty() || query.cols != HAMMING_DESCRIPTOR_BYTES || train.cols != HAMMING_DESCRIPTOR_BYTES
+		|| query.type() != CV_8UC1 || train.type() != CV_8UC1 || !train.isContinuous())
+		return;
+
+	if (kernel == HammingKernelAuto)
+		kernel = Hamming_GetBestKernel();
+
+	for (int i = 0; i < query.rows; i++)
+	{
+		const uint8_t* q = query.ptr<uint8_t>(i);
+		switch (kernel)
+		{
+		case HammingKernelAvx512:
+			Hamming_MatchAvx512(q, train.data, train.rows, matches[(size_t)i]);
+			break;
+		case HammingKernelAvx2:
+			Hamming_MatchAvx2(q, train.data, train.rows, matches[(size_t)i]);
+			break;
+		default:
+			Hamming_MatchScalar(q, train.data, train.rows, matches[(size_t)i]);
+			break;
+		}
+	}
+}
+
+static inline uint16_t Hamming_Substring(const uint8_t* desc, int table)
+{
+	return (uint16_t)(desc[table * 2] | (desc[table * 2 + 1] << 8));
+}
+
+void HammingIndex::Build(const cv::Mat& descriptors)
+{
+	m_Descriptors = descriptors.isContinuous() ? descriptors : descriptors.clone();
+	const uint32_t count = (uint32_t)m_Descriptors.rows;
+	m_Visited.assign(count, 0);
+	m_Epoch = 0;
+
+	for (int table = 0; table < SUBSTRINGS; table++)
+	{
+		std::vector<uint32_t>& offsets = m_Offsets[table];
+		std::vector<uint32_t>& entries = m_Entries[table];
+		offsets.assign(BUCKETS + 1, 0);
+		entries.resize(count);
+
+		for (uint32_t i = 0; i < count; i++)
+			offsets[Hamming_Substring(m_Descriptors.ptr<uint8_t>((int)i), table) + 1]++;
+		for (int k = 0; k < BUCKETS; k++)
+			offsets[k + 1] += offsets[k];
+
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (uint32_t i = 0; i < count; i++)
+			entries[fill[Hamming_Substring(m_Descriptors.ptr<uint8_t>((int)i), table)]++] = i;
+	}
+}
+
+void HammingIndex::Probe(int table, uint16_t key, const uint8_t* query, HammingMatch& match) const
+{
+	const std::vector<uint32_t>& offsets = m_Offsets[table];
+	const std::vector<uint32_t>& entries = m_Entries[table];
+	for (uint32_t e = offsets[key]; e < offsets[key + 1]; e++)
+	{
+		const uint32_t idx = entries[e];
+		if (m_Visited[idx] == m_Epoch)
+			continue;
+		m_Visited[idx] = m_Epoch;
+		Hamming_Keep(match, (int)idx, Hamming_Distance(query, m_Descriptors.ptr<uint8_t>((int)idx)));
+	}
+}
+
+void HammingIndex::Match(const uint8_t* query, int maxDistance, HammingMatch& match) const
+{
+	match = HammingMatch();
+	if (m_Descriptors.empty())
+		return;
+
+	if (++m_Epoch == 0)
+	{
+		std::fill(m_Visited.begin(), m_Visited.end(), 0);
+		m_Epoch = 1;
+	}
+
+	/* substring radius 0 already covers distances up to 15; 1 covers 31 */
+	const bool probeNeighbours = maxDistance >= SUBSTRINGS;
+	for (int table = 0; table < SUBSTRINGS; table++)
+	{
+		const uint16_t key = Hamming_Substring(query, table);
+		Probe(table, key, query, match);
+		if (probeNeighbours)
+		{
+			for (int bit = 0; bit < 16; bit++)
+				Probe(table, (uint16_t)(key ^ (1 << bit)), query, match);
+		}
+	}
+
+	if (match.distance > maxDistance)
+		match = HammingMatch();
+	else if (match.secondDistance > maxDistance)
+		match.secondDistance = INT_MAX;
+}
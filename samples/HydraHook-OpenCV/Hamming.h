@@ -0,0 +1,93 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+/* ORB descriptors are 256 bits */
+static constexpr int HAMMING_DESCRIPTOR_BYTES = 32;
+
+enum HammingKernel
+{
+	HammingKernelScalar,
+	HammingKernelAvx2,			/* nibble-LUT pshufb popcount + psadbw */
+	HammingKernelAvx512,		/* vpopcntq (AVX512_VPOPCNTDQ) */
+	HammingKernelAuto
+};
+
+struct HammingMatch
+{
+	int trainIdx = -1;
+	int distance = INT_MAX;
+	int secondDistance = INT_MAX;	/* for the ratio test */
+};
+
+/**
+ * @brief Set bits of x without the POPCNT instruction (SWAR), which pre-Nehalem CPUs lack.
+ *
+ * Used by the scalar paths only; the vector kernels are CPUID-gated.
+ */
+static inline int Hamming_Popcount64(uint64_t x)
+{
+	x = x - ((x >> 1) & 0x5555555555555555ULL);
+	x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+
+HammingKernel Hamming_GetBestKernel();
+const char* Hamming_GetKernelName(HammingKernel kernel);
+void Hamming_MatchBruteForce(const cv::Mat& query, const cv::Mat& train, std::vector<HammingMatch>& matches, HammingKernel kernel = HammingKernelAuto);
+
+/**
+ * @brief Multi-index hashing over 256-bit descriptors.
+ *
+ * Each descriptor is split into 16 16-bit substrings with one bucket table per substring. By the
+ * pigeonhole principle, a descriptor within distance 31 of the query differs from it by at most one
+ * bit in some substring. Probing the exact and 1-bit neighbour buckets of every substring therefore
+ * finds all of them, and most matches further away as well. Not thread-safe.
+ */
+class HammingIndex
+{
+public:
+	void Build(const cv::Mat& descriptors);
+	size_t Size() const { return (size_t)m_Descriptors.rows; }
+	void Match(const uint8_t* query, int maxDistance, HammingMatch& match) const;
+
+private:
+	static constexpr int SUBSTRINGS = HAMMING_DESCRIPTOR_BYTES / 2;
+	static constexpr int BUCKETS = 1 << 16;
+
+	void Probe(int table, uint16_t key, const uint8_t* query, HammingMatch& match) const;
+
+	cv::Mat m_Descriptors;
+	std::vector<uint32_t> m_Offsets[SUBSTRINGS];	/* CSR: bucket k is m_Entries[m_Offsets[k] .. m_Offsets[k + 1]) */
+	std::vector<uint32_t> m_Entries[SUBSTRINGS];
+	mutable std::vector<uint32_t> m_Visited;
+	mutable uint32_t m_Epoch = 0;
+};
@@ -0,0 +1,400 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "Inference.h"
+#include <HydraHook/Engine/HydraHookCore.h>
+
+#include <opencv2/core/utility.hpp>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/* Samples per axis averaged into one input pixel; enough to keep a 4K -> 320 stretch from aliasing */
+static constexpr int INFERENCE_MAX_TAPS = 4;
+/* A detection of the newest frame in a batch must be seen in at least this share of the batch */
+static constexpr float INFERENCE_VOTE_SHARE = 0.5f;
+static constexpr float INFERENCE_VOTE_IOU = 0.5f;
+
+bool InferenceEngine::Start(const InferenceSettings& settings)
+{
+	Stop();
+
+	try
+	{
+		m_Net = cv::dnn::readNetFromONNX(settings.modelPath);
+	}
+	catch (const cv::Exception& ex)
+	{
+		HydraHookEngineLogError("HydraHook-OpenCV: Failed to load inference model %s: %s", settings.modelPath.c_str(), ex.what());
+		return false;
+	}
+	if (m_Net.empty())
+	{
+		HydraHookEngineLogError("HydraHook-OpenCV: Inference model %s is empty", settings.modelPath.c_str());
+		return false;
+	}
+	m_Net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+	m_Net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+
+	/* QDQ / QLinear models import as int8 layers and run on OpenCV's int8 kernels */
+	std::vector<cv::String> layerTypes;
+	m_Net.getLayerTypes(layerTypes);
+	const bool quantized = std::any_of(layerTypes.begin(), layerTypes.end(), [](const cv::String& type)
+	{
+		return type.find("Int8") != cv::String::npos || type == "Quantize" || type == "Dequantize";
+	});
+
+	/* OpenCV has one pool for the process; the budget caps every OpenCV stage of this sample, not just inference */
+	if (settings.threads > 0)
+		cv::setNumThreads(settings.threads);
+
+	m_Settings = settings;
+	m_Settings.inputSize = (std::max)(settings.inputSize, 32);
+	m_MaxBatch = (std::max)(settings.maxBatch, 1);
+	m_FrameMs = 0.0f;
+	m_Latest = InferenceResults();
+	m_Queue.clear();
+	m_Running = true;
+	m_Thread = std::thread(&InferenceEngine::ThreadProc, this);
+
+	HydraHookEngineLogInfo("HydraHook-OpenCV: Inference model %s loaded (%s, %dx%d input, batch <= %d, %d threads)",
+		settings.modelPath.c_str(), quantized ? "int8" : "float", m_Settings.inputSize, m_Settings.inputSize,
+		m_MaxBatch, cv::getNumThreads());
+	return true;
+}
+
+void InferenceEngine::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Running = false;
+		m_Queue.clear();
+	}
+	m_Cv.notify_all();
+	if (m_Thread.joinable())
+		m_Thread.join();
+}
+
+/**
+ * @brief Resize, normalize and NCHW layout of an R8G8B8A8 readback in one pass.
+ *
+ * Every input pixel averages taps x taps source samples spread over its footprint, so no
+ * full-size intermediate is written; per-channel scale and bias fold /255, mean and stddev.
+ */
+void InferenceEngine::Preprocess(const uint8_t* src, size_t rowPitch, int width, int height, cv::Mat& blob) const
+{
+	const int size = m_Settings.inputSize;
+	const int dims[] = { 1, 3, size, size };
+	blob.create(4, dims, CV_32F);
+	if (!src || width <= 0 || height <= 0)
+	{
+		blob.setTo(0.0f);
+		return;
+	}
+
+	const float scaleX = (float)width / size;
+	const float scaleY = (float)height / size;
+	const int tapsX = (std::min)((std::max)((int)std::ceil(scaleX), 1), INFERENCE_MAX_TAPS);
+	const int tapsY = (std::min)((std::max)((int)std::ceil(scaleY), 1), INFERENCE_MAX_TAPS);
+
+	static thread_local std::vector<int> columns;
+	columns.resize((size_t)size * tapsX);
+	for (int x = 0; x < size; x++)
+	{
+		for (int i = 0; i < tapsX; i++)
+			columns[(size_t)x * tapsX + i] = (std::min)((int)((x + (i + 0.5f) / tapsX) * scaleX), width - 1) * 4;
+	}
+
+	const float norm = 1.0f / (255.0f * tapsX * tapsY);
+	const __m128 mul = _mm_setr_ps(norm / (float)m_Settings.stddev[0], norm / (float)m_Settings.stddev[1], norm / (float)m_Settings.stddev[2], 0.0f);
+	const __m128 add = _mm_setr_ps(-(float)(m_Settings.mean[0] / m_Settings.stddev[0]), -(float)(m_Settings.mean[1] / m_Settings.stddev[1]),
+		-(float)(m_Settings.mean[2] / m_Settings.stddev[2]), 0.0f);
+	const __m128i zero = _mm_setzero_si128();
+
+	float* planes[3];
+	planes[0] = blob.ptr<float>();
+	planes[1] = planes[0] + (size_t)size * size;
+	planes[2] = planes[1] + (size_t)size * size;
+
+	const uint8_t* rows[INFERENCE_MAX_TAPS];
+	for (int y = 0; y < size; y++)
+	{
+		for (int j = 0; j < tapsY; j++)
+			rows[j] = src + (size_t)(std::min)((int)((y + (j + 0.5f) / tapsY) * scaleY), height - 1) * rowPitch;
+
+		const size_t offset = (size_t)y * size;
+		for (int x = 0; x < size; x++)
+		{
+			const int* cols = &columns[(size_t)x * tapsX];
+			__m128i sum = zero;
+			for (int j = 0; j < tapsY; j++)
+			{
+				for (int i = 0; i < tapsX; i++)
+				{
+					int pixel;
+					memcpy(&pixel, rows[j] + cols[i], sizeof(pixel));
+					sum = _mm_add_epi32(sum, _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero));
+				}
+			}
+			alignas(16) float v[4];
+			_mm_store_ps(v, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(sum), mul), add));
+			planes[0][offset + x] = v[0];
+			planes[1][offset + x] = v[1];
+			planes[2][offset + x] = v[2];
+		}
+	}
+}
+
+void InferenceEngine::Submit(const cv::Mat& blob, const FrameTag& tag, cv::Size frameSize)
+{
+	if (!m_Running || blob.empty())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		/* At most one batch waits; the oldest frames are the least useful */
+		while (m_Queue.size() >= (size_t)m_MaxBatch)
+			m_Queue.pop_front();
+		m_Queue.push_back({ blob, tag, frameSize });
+	}
+	m_Cv.notify_one();
+}
+
+bool InferenceEngine::GetLatest(InferenceResults& out) const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	out = m_Latest;
+	return out.valid;
+}
+
+void InferenceEngine::ThreadProc()
+{
+	for (;;)
+	{
+		std::vector<Pending> batch;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Cv.wait(lock, [this] { return !m_Running || !m_Queue.empty(); });
+			if (!m_Running)
+				break;
+
+			/* Frames that already missed the budget can't make it up; the newest one is kept
+			   so a model slower than the budget still produces results */
+			const uint64_t now = FrameTiming_Now();
+			while (m_Queue.size() > 1
+				&& FrameTiming_ToMs((int64_t)(now - m_Queue.front().tag.captureTicks)) > m_Settings.latencyBudgetMs)
+				m_Queue.pop_front();
+
+			/* Frames that piled up while the last batch ran go together, as far as the budget allows:
+			   the newest frame's result must be ready within latencyBudgetMs of its capture */
+			const float newestAgeMs = (float)FrameTiming_ToMs((int64_t)(now - m_Queue.back().tag.captureTicks));
+			size_t count = m_Queue.size();
+			if (m_FrameMs > 0.0f)
+			{
+				const int affordable = (int)((m_Settings.latencyBudgetMs - newestAgeMs) / m_FrameMs);
+				count = (std::min)(count, (size_t)(std::max)(affordable, 1));
+			}
+			batch.assign(m_Queue.end() - (ptrdiff_t)count, m_Queue.end());
+			m_Queue.clear();
+		}
+		RunBatch(batch);
+	}
+}
+
+void InferenceEngine::RunBatch(std::vector<Pending>& batch)
+{
+	const int count = (int)batch.size();
+	const int size = m_Settings.inputSize;
+	const size_t frameFloats = (size_t)3 * size * size;
+
+	cv::Mat input;
+	if (count == 1)
+		input = batch[0].blob;
+	else
+	{
+		const int dims[] = { count, 3, size, size };
+		input.create(4, dims, CV_32F);
+		for (int i = 0; i < count; i++)
+			memcpy(input.ptr<float>() + i * frameFloats, batch[(size_t)i].blob.ptr<float>(), frameFloats * sizeof(float));
+	}
+
+	cv::Mat output;
+	const uint64_t start = FrameTiming_Now();
+	try
+	{
+		m_Net.setInput(input);
+		output = m_Net.forward();
+	}
+	catch (const cv::Exception& ex)
+	{
+		if (count > 1)
+		{
+			HydraHookEngineLogWarning("HydraHook-OpenCV: Batched inference failed (%s), running single frames", ex.what());
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_MaxBatch = 1;
+			}
+			std::vector<Pending> newest(1, batch.back());
+			RunBatch(newest);
+		}
+		else
+			HydraHookEngineLogError("HydraHook-OpenCV: Inference failed: %s", ex.what());
+		return;
+	}
+	const uint64_t end = FrameTiming_Now();
+
+	const float frameMs = (float)FrameTiming_ToMs((int64_t)(end - start)) / count;
+	m_FrameMs = m_FrameMs > 0.0f ? m_FrameMs * 0.9f + frameMs * 0.1f : frameMs;
+
+	if (output.dims < 3 || output.size[0] != count)
+	{
+		HydraHookEngineLogError("HydraHook-OpenCV: Unexpected inference output (%d dims)", output.dims);
+		return;
+	}
+
+	InferenceResults result;
+	result.valid = true;
+	result.tag = batch.back().tag;
+	result.batchSize = count;
+
+	if (m_Settings.task == InferenceTaskSegmentation)
+		ParseSegmentation(output, count - 1, result);
+	else
+	{
+		ParseDetections(output, count - 1, batch.back(), result.detections);
+
+		/* The older frames of the batch vote: newest-frame detections nobody else saw are flicker */
+		if (count > 1)
+		{
+			std::vector<std::vector<InferenceDetection>> older((size_t)count - 1);
+			for (int i = 0; i + 1 < count; i++)
+				ParseDetections(output, i, batch[(size_t)i], older[(size_t)i]);
+
+			const int required = (std::max)((int)std::ceil(count * INFERENCE_VOTE_SHARE), 1);
+			result.detections.erase(std::remove_if(result.detections.begin(), result.detections.end(), [&](const InferenceDetection& d)
+			{
+				int seen = 1;
+				for (const auto& frame : older)
+				{
+					seen += std::any_of(frame.begin(), frame.end(), [&](const InferenceDetection& o)
+					{
+						const float overlap = (d.box & o.box).area();
+						return o.classId == d.classId && overlap > INFERENCE_VOTE_IOU * (d.box.area() + o.box.area() - overlap);
+					});
+				}
+				return seen < required;
+			}), result.detections.end());
+		}
+	}
+
+	result.latencyMs = (float)FrameTiming_ToMs((int64_t)(FrameTiming_Now() - result.tag.captureTicks));
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Latest = std::move(result);
+}
+
+/**
+ * @brief Decodes YOLO-style rows (cx, cy, w, h[, objectness], class scores...) and applies NMS.
+ */
+void InferenceEngine::ParseDetections(const cv::Mat& output, int index, const Pending& frame, std::vector<InferenceDetection>& out) const
+{
+	const int a = output.size[1];
+	const int b = output.size[2];
+	/* YOLOv8 and later emit attributes x boxes and drop the objectness column */
+	const bool transposed = a < b;
+	cv::Mat rows(a, b, CV_32F, (void*)output.ptr<float>(index));
+	if (transposed)
+		rows = rows.t();
+	const int classOffset = transposed ? 4 : 5;
+	if (rows.cols <= classOffset)
+		return;
+
+	const float sx = (float)frame.frameSize.width / m_Settings.inputSize;
+	const float sy = (float)frame.frameSize.height / m_Settings.inputSize;
+
+	std::vector<cv::Rect2d> boxes;
+	std::vector<float> scores;
+	std::vector<int> classes;
+	for (int r = 0; r < rows.rows; r++)
+	{
+		const float* p = rows.ptr<float>(r);
+		const float* best = std::max_element(p + classOffset, p + rows.cols);
+		const float score = *best * (transposed ? 1.0f : p[4]);
+		if (score < m_Settings.scoreThreshold)
+			continue;
+		boxes.emplace_back((p[0] - p[2] * 0.5f) * sx, (p[1] - p[3] * 0.5f) * sy, p[2] * sx, p[3] * sy);
+		scores.push_back(score);
+		classes.push_back((int)(best - (p + classOffset)));
+	}
+
+	std::vector<int> keep;
+	cv::dnn::NMSBoxes(boxes, scores, m_Settings.scoreThreshold, m_Settings.nmsThreshold, keep);
+	out.clear();
+	for (const int i : keep)
+	{
+		InferenceDetection d;
+		d.classId = classes[(size_t)i];
+		d.score = scores[(size_t)i];
+		d.box = cv::Rect2f(boxes[(size_t)i]);
+		out.push_back(d);
+	}
+}
+
+/**
+ * @brief Per-pixel argmax over class score planes; a single plane is thresholded at 0.5.
+ */
+void InferenceEngine::ParseSegmentation(const cv::Mat& output, int index, InferenceResults& out) const
+{
+	if (output.dims != 4)
+		return;
+	const int classes = output.size[1];
+	const int h = output.size[2];
+	const int w = output.size[3];
+	const float* planes = output.ptr<float>(index);
+	const size_t planeSize = (size_t)h * w;
+
+	out.segmentation.create(h, w, CV_8UC1);
+	uint8_t* labels = out.segmentation.ptr<uint8_t>();
+	for (size_t i = 0; i < planeSize; i++)
+	{
+		if (classes == 1)
+		{
+			labels[i] = planes[i] > 0.5f ? 1 : 0;
+			continue;
+		}
+		int best = 0;
+		for (int c = 1; c < classes; c++)
+		{
+			if (planes[c * planeSize + i] > planes[best * planeSize + i])
+				best = c;
+		}
+		labels[i] = (uint8_t)(std::min)(best, 255);
+	}
+}
@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Perception.h"
+
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+enum InferenceTask
+{
+	InferenceTaskDetection,		/* YOLO-style [N, boxes, 5 + classes] or [N, 4 + classes, boxes] output */
+	InferenceTaskSegmentation	/* [N, classes, H, W] scores, argmax per pixel */
+};
+
+struct InferenceSettings
+{
+	std::string modelPath;		/* ONNX, float or int8 (QDQ / QLinear) quantized */
+	InferenceTask task = InferenceTaskDetection;
+	int inputSize = 320;		/* square network input, frames are stretched to it */
+	int threads = 2;			/* OpenCV pool size while inference runs */
+	int maxBatch = 4;
+	float latencyBudgetMs = 66.0f;	/* queued frames older than this are dropped (never the newest), batches sized to stay within it */
+	float scoreThreshold = 0.4f;
+	float nmsThreshold = 0.45f;
+	cv::Scalar mean = cv::Scalar(0.0, 0.0, 0.0);	/* RGB, applied after scaling to [0, 1] */
+	cv::Scalar stddev = cv::Scalar(1.0, 1.0, 1.0);
+};
+
+/**
+ * @brief Runs an ONNX model through OpenCV's DNN module on the CPU, off the capture worker.
+ *
+ * The readback is converted straight into the NCHW float input (Preprocess) while it is mapped,
+ * which for D3D11 is on the render thread.
+ * Submitted frames queue on a dedicated thread; whatever piled up while the previous batch ran is
+ * forwarded as one batch, as long as the measured per-frame cost keeps the batch within the latency
+ * budget. Models with a fixed batch dimension fall back to single frames.
+ */
+class InferenceEngine
+{
+public:
+	~InferenceEngine() { Stop(); }
+
+	bool Start(const InferenceSettings& settings);
+	void Stop();
+	bool IsRunning() const { return m_Running; }
+
+	/* Thread-safe once running; blob is [1, 3, inputSize, inputSize] CV_32F */
+	void Preprocess(const uint8_t* src, size_t rowPitch, int width, int height, cv::Mat& blob) const;
+	void Submit(const cv::Mat& blob, const FrameTag& tag, cv::Size frameSize);
+	bool GetLatest(InferenceResults& out) const;
+
+private:
+	struct Pending
+	{
+		cv::Mat blob;
+		FrameTag tag;
+		cv::Size frameSize;
+	};
+
+	void ThreadProc();
+	void RunBatch(std::vector<Pending>& batch);
+	void ParseDetections(const cv::Mat& output, int index, const Pending& frame, std::vector<InferenceDetection>& out) const;
+	void ParseSegmentation(const cv::Mat& output, int index, InferenceResults& out) const;
+
+	InferenceSettings m_Settings;
+	cv::dnn::Net m_Net;
+	std::atomic<bool> m_Running{ false };
+	std::thread m_Thread;
+
+	mutable std::mutex m_Mutex;
+	std::condition_variable m_Cv;
+	std::deque<Pending> m_Queue;
+	InferenceResults m_Latest;
+	int m_MaxBatch = 1;
+	float m_FrameMs = 0.0f;		/* running average forward time per frame */
+};
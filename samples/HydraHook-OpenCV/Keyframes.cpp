@@ -0,0 +1,168 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "Keyframes.h"
+#include <HydraHook/Engine/HydraHookCore.h>
+
+#include <opencv2/calib3d.hpp>
+
+#include <algorithm>
+
+static constexpr size_t KEYFRAME_CAPACITY = 64;
+static constexpr size_t KEYFRAME_MIH_MIN_DESCRIPTORS = 8192;
+static constexpr int KEYFRAME_MAX_DISTANCE = 50;
+static constexpr float KEYFRAME_RATIO = 0.8f;
+static constexpr int KEYFRAME_MIN_MATCHES = 30;
+static constexpr int KEYFRAME_MIN_INLIERS = 20;
+
+void KeyframeDatabase::Add(const std::vector<cv::Point2f>& points, const cv::Mat& descriptors, const cv::Matx33d& rotation, const cv::Vec3d& position)
+{
+	if (points.empty() || descriptors.rows != (int)points.size())
+		return;
+
+	if (m_Keyframes.size() >= KEYFRAME_CAPACITY)
+	{
+		m_DescriptorCount -= m_Keyframes.front().points.size();
+		m_Keyframes.pop_front();
+	}
+
+	Keyframe kf;
+	kf.id = m_NextId++;
+	kf.points = points;
+	kf.descriptors = descriptors.clone();
+	kf.rotation = rotation;
+	kf.position = position;
+	m_DescriptorCount += points.size();
+	m_Keyframes.push_back(std::move(kf));
+	m_IndexDirty = true;
+}
+
+void KeyframeDatabase::Clear()
+{
+	m_Keyframes.clear();
+	m_DescriptorCount = 0;
+	m_IndexDirty = true;
+}
+
+void KeyframeDatabase::RebuildIndex()
+{
+	cv::Mat all((int)m_DescriptorCount, HAMMING_DESCRIPTOR_BYTES, CV_8UC1);
+	m_IndexKeyframe.resize(m_DescriptorCount);
+	m_IndexPoint.resize(m_DescriptorCount);
+
+	int row = 0;
+	for (size_t k = 0; k < m_Keyframes.size(); k++)
+	{
+		const Keyframe& kf = m_Keyframes[k];
+		kf.descriptors.copyTo(all.rowRange(row, row + kf.descriptors.rows));
+		for (int i = 0; i < kf.descriptors.rows; i++, row++)
+		{
+			m_IndexKeyframe[(size_t)row] = (int)k;
+			m_IndexPoint[(size_t)row] = i;
+		}
+	}
+	m_Index.Build(all);
+	m_IndexDirty = false;
+}
+
+bool KeyframeDatabase::Relocalize(const std::vector<cv::Point2f>& points, const cv::Mat& descriptors, const cv::Mat& K, Relocalization& out)
+{
+	if (m_Keyframes.empty() || descriptors.empty() || descriptors.rows != (int)points.size())
+		return false;
+
+	/* per keyframe: (keyframe point, query point) correspondences */
+	std::vector<std::vector<std::pair<int, int>>> correspondences(m_Keyframes.size());
+
+	if (m_DescriptorCount >= KEYFRAME_MIH_MIN_DESCRIPTORS)
+	{
+		if (m_IndexDirty)
+			RebuildIndex();
+		HammingMatch m;
+		for (int i = 0; i < descriptors.rows; i++)
+		{
+			m_Index.Match(descriptors.ptr<uint8_t>(i), KEYFRAME_MAX_DISTANCE, m);
+			if (m.trainIdx >= 0)
+				correspondences[(size_t)m_IndexKeyframe[(size_t)m.trainIdx]].emplace_back(m_IndexPoint[(size_t)m.trainIdx], i);
+		}
+	}
+	else
+	{
+		std::vector<HammingMatch> matches;
+		for (size_t k = 0; k < m_Keyframes.size(); k++)
+		{
+			Hamming_MatchBruteForce(descriptors, m_Keyframes[k].descriptors, matches);
+			for (int i = 0; i < (int)matches.size(); i++)
+			{
+				const HammingMatch& m = matches[(size_t)i];
+				if (m.trainIdx >= 0 && m.distance <= KEYFRAME_MAX_DISTANCE && m.distance < KEYFRAME_RATIO * m.secondDistance)
+					correspondences[k].emplace_back(m.trainIdx, i);
+			}
+		}
+	}
+
+	size_t best = 0;
+	for (size_t k = 1; k < correspondences.size(); k++)
+	{
+		if (correspondences[k].size() > correspondences[best].size())
+			best = k;
+	}
+	if ((int)correspondences[best].size() < KEYFRAME_MIN_MATCHES)
+		return false;
+
+	const Keyframe& kf = m_Keyframes[best];
+	std::vector<cv::Point2f> kfPts, curPts;
+	for (const auto& c : correspondences[best])
+	{
+		kfPts.push_back(kf.points[(size_t)c.first]);
+		curPts.push_back(points[(size_t)c.second]);
+	}
+
+	cv::Mat E, R, t, mask;
+	try
+	{
+		E = cv::findEssentialMat(kfPts, curPts, K, cv::RANSAC, 0.999, 1.0, mask);
+		if (E.empty() || E.rows != 3)
+			return false;
+		const int inliers = cv::recoverPose(E, kfPts, curPts, K, R, t, mask);
+		if (inliers < KEYFRAME_MIN_INLIERS)
+			return false;
+		out.inliers = inliers;
+	}
+	catch (const cv::Exception& ex)
+	{
+		HydraHookEngineLogError("HydraHook-OpenCV: Relocalization pose failed: %s", ex.what());
+		return false;
+	}
+
+	/* Monocular: the keyframe->current translation has no scale, so the position snaps to the
+	   keyframe and only the rotation is composed. */
+	out.keyframeId = kf.id;
+	out.matches = (int)correspondences[best].size();
+	out.rotation = kf.rotation * cv::Matx33d(R).t();
+	out.position = kf.position;
+	return true;
+}
@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Hamming.h"
+
+#include <opencv2/core.hpp>
+#include <deque>
+#include <vector>
+
+struct Keyframe
+{
+	int id = 0;
+	std::vector<cv::Point2f> points;
+	cv::Mat descriptors;		/* ORB, one row per point */
+	cv::Matx33d rotation;		/* camera-to-world */
+	cv::Vec3d position;
+};
+
+struct Relocalization
+{
+	int keyframeId = -1;
+	int matches = 0;
+	int inliers = 0;
+	cv::Matx33d rotation;		/* re-anchored camera-to-world rotation */
+	cv::Vec3d position;
+};
+
+/**
+ * @brief Bounded FIFO of ORB keyframes the perception pipeline relocalizes against after tracking loss.
+ *
+ * Small maps are matched brute force per keyframe (with the ratio test). Once the map holds
+ * KEYFRAME_MIH_MIN_DESCRIPTORS descriptors, candidates come from one multi-index-hashing table
+ * over all keyframes and vote for their keyframe.
+ */
+class KeyframeDatabase
+{
+public:
+	void Add(const std::vector<cv::Point2f>& points, const cv::Mat& descriptors, const cv::Matx33d& rotation, const cv::Vec3d& position);
+	void Clear();
+	size_t Size() const { return m_Keyframes.size(); }
+	size_t DescriptorCount() const { return m_DescriptorCount; }
+	bool Relocalize(const std::vector<cv::Point2f>& points, const cv::Mat& descriptors, const cv::Mat& K, Relocalization& out);
+
+private:
+	void RebuildIndex();
+
+	std::deque<Keyframe> m_Keyframes;
+	size_t m_DescriptorCount = 0;
+	int m_NextId = 1;
+
+	HammingIndex m_Index;
+	std::vector<int> m_IndexKeyframe;	/* index row -> position in m_Keyframes */
+	std::vector<int> m_IndexPoint;		/* index row -> point in that keyframe */
+	bool m_IndexDirty = true;
+};
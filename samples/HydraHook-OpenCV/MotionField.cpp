@@ -0,0 +1,203 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "MotionField.h"
+
+#include <opencv2/core/utility.hpp>
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+static constexpr int MOTION_SEARCH_RANGE = 16;
+static constexpr int MOTION_MAX_REFINE_STEPS = 8;
+/* A non-zero vector must beat zero motion by a quarter level per pixel; keeps flat and noisy blocks still */
+static constexpr int MOTION_ZERO_BIAS_SHIFT = 2;
+
+/**
+ * @brief SAD of two size x size blocks with their own row steps; 8-pixel rows are packed two per register.
+ */
+static inline int Motion_Sad(const uint8_t* a, size_t stepA, const uint8_t* b, size_t stepB, int size)
+{
+	__m128i acc = _mm_setzero_si128();
+	if (size == 8)
+	{
+		for (int y = 0; y < 8; y += 2)
+		{
+			const __m128i ra = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(a + y * stepA)), _mm_loadl_epi64((const __m128i*)(a + (y + 1) * stepA)));
+			const __m128i rb = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(b + y * stepB)), _mm_loadl_epi64((const __m128i*)(b + (y + 1) * stepB)));
+			acc = _mm_add_epi32(acc, _mm_sad_epu8(ra, rb));
+		}
+	}
+	else
+	{
+		for (int y = 0; y < size; y++)
+		{
+			for (int x = 0; x < size; x += 16)
+				acc = _mm_add_epi32(acc, _mm_sad_epu8(_mm_loadu_si128((const __m128i*)(a + y * stepA + x)), _mm_loadu_si128((const __m128i*)(b + y * stepB + x))));
+		}
+	}
+	return _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(acc, acc));
+}
+
+void MotionEstimator::Reset()
+{
+	m_Prev.release();
+	m_PrevField.release();
+	m_BlockSize = 0;
+}
+
+bool MotionEstimator::Estimate(const cv::Mat& gray, int blockSize, MotionSearch search, cv::Mat& field)
+{
+	const int size = blockSize <= 8 ? 8 : blockSize <= 16 ? 16 : 32;
+	const cv::Size grid(gray.cols / size, gray.rows / size);
+
+	if (m_Prev.empty() || m_Prev.size() != gray.size() || grid.area() == 0)
+	{
+		m_Prev = gray;
+		m_PrevField.release();
+		field.release();
+		return false;
+	}
+
+	if (m_BlockSize != size || m_PrevField.size() != grid)
+		m_PrevField = cv::Mat::zeros(grid, CV_16SC2);
+	m_BlockSize = size;
+
+	field.create(grid, CV_16SC2);
+	const cv::Mat& prev = m_Prev;
+	const cv::Mat& prevField = m_PrevField;
+	const size_t step = gray.step;
+	/* m_Prev is an earlier frame's buffer, its step need not match (e.g. a ROI or a differently pooled Mat) */
+	const size_t prevStep = prev.step;
+	const int bias = (size * size) >> MOTION_ZERO_BIAS_SHIFT;
+	const int maxX = gray.cols - size;
+	const int maxY = gray.rows - size;
+
+	/* Rows are independent: spatial prediction only uses the left neighbour, the rest comes from the previous field */
+	cv::parallel_for_(cv::Range(0, grid.height), [&](const cv::Range& range)
+	{
+		for (int by = range.start; by < range.end; by++)
+		{
+			cv::Vec2s* out = field.ptr<cv::Vec2s>(by);
+			for (int bx = 0; bx < grid.width; bx++)
+			{
+				const int x = bx * size;
+				const int y = by * size;
+				const uint8_t* curr = gray.ptr<uint8_t>(y) + x;
+				int bestCost = INT_MAX;
+				cv::Vec2s best(0, 0);
+
+				/* motion m: the block came from (x - mx, y - my) in the previous frame */
+				const auto test = [&](int mx, int my)
+				{
+					if (std::abs(mx) > MOTION_SEARCH_RANGE || std::abs(my) > MOTION_SEARCH_RANGE)
+						return;
+					const int px = x - mx;
+					const int py = y - my;
+					if (px < 0 || py < 0 || px > maxX || py > maxY)
+						return;
+					const int cost = Motion_Sad(curr, step, prev.ptr<uint8_t>(py) + px, prevStep, size) + ((mx | my) ? bias : 0);
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						best = cv::Vec2s((short)mx, (short)my);
+					}
+				};
+
+				test(0, 0);
+
+				if (search == MotionSearchExhaustive)
+				{
+					for (int my = -MOTION_SEARCH_RANGE; my <= MOTION_SEARCH_RANGE; my++)
+					{
+						for (int mx = -MOTION_SEARCH_RANGE; mx <= MOTION_SEARCH_RANGE; mx++)
+							test(mx, my);
+					}
+				}
+				else
+				{
+					const cv::Vec2s& same = prevField.at<cv::Vec2s>(by, bx);
+					test(same[0], same[1]);
+					if (bx > 0)
+						test(out[bx - 1][0], out[bx - 1][1]);
+					if (bx + 1 < grid.width)
+						test(prevField.at<cv::Vec2s>(by, bx + 1)[0], prevField.at<cv::Vec2s>(by, bx + 1)[1]);
+					if (by > 0)
+						test(prevField.at<cv::Vec2s>(by - 1, bx)[0], prevField.at<cv::Vec2s>(by - 1, bx)[1]);
+					if (by + 1 < grid.height)
+						test(prevField.at<cv::Vec2s>(by + 1, bx)[0], prevField.at<cv::Vec2s>(by + 1, bx)[1]);
+
+					for (int i = 0; i < MOTION_MAX_REFINE_STEPS; i++)
+					{
+						const cv::Vec2s center = best;
+						test(center[0] - 1, center[1]);
+						test(center[0] + 1, center[1]);
+						test(center[0], center[1] - 1);
+						test(center[0], center[1] + 1);
+						if (best == center)
+							break;
+					}
+				}
+
+				out[bx] = best;
+			}
+		}
+	});
+
+	m_Prev = gray;
+	field.copyTo(m_PrevField);
+	return true;
+}
+
+/**
+ * @brief Marks moving blocks and their neighbours in a frame-sized mask; returns the moving fraction.
+ */
+float MotionField_MovingMask(const cv::Mat& field, int blockSize, cv::Size frameSize, cv::Mat& mask)
+{
+	mask = cv::Mat::zeros(frameSize, CV_8UC1);
+	if (field.empty())
+		return 0.0f;
+
+	int moving = 0;
+	const cv::Rect frame(0, 0, frameSize.width, frameSize.height);
+	for (int by = 0; by < field.rows; by++)
+	{
+		const cv::Vec2s* row = field.ptr<cv::Vec2s>(by);
+		for (int bx = 0; bx < field.cols; bx++)
+		{
+			if (!row[bx][0] && !row[bx][1])
+				continue;
+			moving++;
+			const cv::Rect block((bx - 1) * blockSize, (by - 1) * blockSize, blockSize * 3, blockSize * 3);
+			mask(block & frame).setTo(255);
+		}
+	}
+	return (float)moving / (float)field.total();
+}
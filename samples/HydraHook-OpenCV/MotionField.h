@@ -0,0 +1,59 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+enum MotionSearch
+{
+	MotionSearchPredictive,		/* previous-field and neighbour candidates, then small diamond refinement */
+	MotionSearchExhaustive		/* every vector in the search window; reference for the benchmark */
+};
+
+/**
+ * @brief Dense block-matching motion field between consecutive gray frames.
+ *
+ * Every blockSize x blockSize block (8, 16 or 32) of the current frame is matched against the
+ * previous frame by sum of absolute differences (psadbw). The predictive search only evaluates
+ * the vectors the same and adjacent blocks had in the previous field plus the block to the left,
+ * and refines the best one, so a typical frame costs a handful of SADs per block. Block rows run
+ * in parallel on OpenCV's pool.
+ */
+class MotionEstimator
+{
+public:
+	void Reset();
+
+	/* Fills field (CV_16SC2, one motion vector in pixels per block, current minus previous position);
+	   returns false and leaves field empty when there is no previous frame of the same size */
+	bool Estimate(const cv::Mat& gray, int blockSize, MotionSearch search, cv::Mat& field);
+
+private:
+	cv::Mat m_Prev;
+	cv::Mat m_PrevField;
+	int m_BlockSize = 0;
+};
+
+float MotionField_MovingMask(const cv::Mat& field, int blockSize, cv::Size frameSize, cv::Mat& mask);
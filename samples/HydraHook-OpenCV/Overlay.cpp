@@ -26,6 +26,11 @@ SOFTWARE.
 #include <Windows.h>
 
 #include "Overlay.h"
+#include "Capture.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
 #include <unordered_map>
 #include <imgui.h>
 #include <imgui_impl_win32.h>
@@ -39,6 +44,13 @@ typedef LRESULT(CALLBACK* WndProc_t)(HWND, UINT, WPARAM, LPARAM);
 static WndProc_t g_originalWndProc = nullptr;
 static HWND g_hookedWindow = nullptr;
 
+/* Cap on linear extrapolation, in analyzed frames; beyond this the prediction is worse than the stale result */
+static constexpr float OVERLAY_MAX_EXTRAPOLATION_FRAMES = 3.0f;
+/* Block motion (analysis pixels per frame) drawn at full heat */
+static constexpr float OVERLAY_MOTION_FULL_SCALE = 8.0f;
+
+static bool g_showMotionField = true;
+
 static LRESULT CALLBACK OverlayWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	if (ImGui_ImplWin32_WndProcHandler(hWnd, msg, wParam, lParam))
@@ -88,35 +100,136 @@ void Overlay_ToggleState(int key, bool& toggle)
 	}
 }
 
-void Overlay_Render(float displayWidth, float displayHeight, const PerceptionResults& res)
+void Overlay_Render(float displayWidth, float displayHeight, const PerceptionResults& res, float aheadMs)
 {
 	ImDrawList* draw = ImGui::GetBackgroundDrawList();
 	if (!draw)
 		return;
 
-	if (!res.valid || res.currPts.empty())
-		return;
-
 	const ImU32 colPoint = IM_COL32(0, 255, 0, 255);
 	const ImU32 colVector = IM_COL32(255, 200, 0, 200);
 	const ImU32 colTrail = IM_COL32(255, 100, 255, 200);
+	const ImU32 colTemplate = IM_COL32(0, 160, 255, 255);
+	const ImU32 colTracked = IM_COL32(255, 255, 0, 255);
+	const ImU32 colOccluded = IM_COL32(255, 60, 60, 200);
+	const ImU32 colDetection = IM_COL32(255, 140, 0, 255);
+	const ImU32 colBlob = IM_COL32(255, 255, 255, 200);
+
+	const float s = res.frameScale;
+
+	/* Analyzed frames elapsed between capture and this Present; motion is extrapolated linearly */
+	const float ahead = res.frameIntervalMs > 0.0f
+		? (std::min)(aheadMs / res.frameIntervalMs, OVERLAY_MAX_EXTRAPOLATION_FRAMES) : 0.0f;
+
+	if (g_showMotionField && !res.motionField.empty())
+	{
+		/* Heatmap below everything else; still blocks stay transparent */
+		const float b = res.motionBlockSize * s;
+		for (int by = 0; by < res.motionField.rows; by++)
+		{
+			const cv::Vec2s* row = res.motionField.ptr<cv::Vec2s>(by);
+			for (int bx = 0; bx < res.motionField.cols; bx++)
+			{
+				if (!row[bx][0] && !row[bx][1])
+					continue;
+				const float heat = (std::min)(std::sqrt((float)(row[bx][0] * row[bx][0] + row[bx][1] * row[bx][1])) / OVERLAY_MOTION_FULL_SCALE, 1.0f);
+				const ImU32 col = IM_COL32((int)(255 * heat), 64, (int)(255 * (1.0f - heat)), 40 + (int)(80 * heat));
+				draw->AddRectFilled(ImVec2(bx * b, by * b), ImVec2((bx + 1) * b, (by + 1) * b), col);
+			}
+		}
+	}
+
+	for (const auto& match : res.templateMatches)
+	{
+		if (!match.found)
+			continue;
+		const ImVec2 tl(match.box.x * s, match.box.y * s);
+		draw->AddRect(tl, ImVec2((match.box.x + match.box.width) * s, (match.box.y + match.box.height) * s), colTemplate, 0.0f, 0, 2.0f);
+		char label[96];
+		snprintf(label, sizeof(label), "%s %.2f", match.name.c_str(), match.score);
+		draw->AddText(ImVec2(tl.x, tl.y - ImGui::GetFontSize()), colTemplate, label);
+	}
+
+	/* Blobs come from the full-resolution readback, already in display coordinates */
+	for (const auto& group : res.colorBlobs)
+	{
+		for (const auto& blob : group.blobs)
+			draw->AddRect(ImVec2((float)blob.box.x, (float)blob.box.y), ImVec2((float)blob.box.br().x, (float)blob.box.br().y), colBlob);
+		if (!group.blobs.empty())
+		{
+			const ColorBlob& largest = group.blobs.front();
+			char label[64];
+			snprintf(label, sizeof(label), "%s %dx%d", group.name.c_str(), largest.box.width, largest.box.height);
+			draw->AddText(ImVec2((float)largest.box.x, (float)largest.box.y - ImGui::GetFontSize()), colBlob, label);
+		}
+	}
+
+	for (const auto& det : res.inference.detections)
+	{
+		const ImVec2 tl(det.box.x * s, det.box.y * s);
+		draw->AddRect(tl, ImVec2((det.box.x + det.box.width) * s, (det.box.y + det.box.height) * s), colDetection, 0.0f, 0, 2.0f);
+		char label[32];
+		snprintf(label, sizeof(label), "class %d %.2f", det.classId, det.score);
+		draw->AddText(ImVec2(tl.x, tl.y - ImGui::GetFontSize()), colDetection, label);
+	}
 
-	for (const auto& pt : res.currPts)
-		draw->AddCircle(ImVec2(pt.x, pt.y), 3.0f, colPoint, 0, 2.0f);
+	for (const auto& obj : res.trackedObjects)
+	{
+		const cv::Point2f shift = obj.velocity * ahead;
+		const ImVec2 tl((obj.box.x + shift.x) * s, (obj.box.y + shift.y) * s);
+		const ImU32 col = obj.occluded ? colOccluded : colTracked;
+		draw->AddRect(tl, ImVec2(tl.x + obj.box.width * s, tl.y + obj.box.height * s), col, 0.0f, 0, 2.0f);
+		char label[48];
+		snprintf(label, sizeof(label), "#%d psr %.1f", obj.id, obj.psr);
+		draw->AddText(ImVec2(tl.x, tl.y - ImGui::GetFontSize()), col, label);
+	}
+
+	/* Shift + left drag selects an object to track */
+	static bool selecting = false;
+	static ImVec2 selectStart;
+	const ImGuiIO& io = ImGui::GetIO();
+	if (!selecting && io.KeyShift && !io.WantCaptureMouse && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+	{
+		selecting = true;
+		selectStart = io.MousePos;
+	}
+	if (selecting)
+	{
+		draw->AddRect(selectStart, io.MousePos, colTracked, 0.0f, 0, 1.0f);
+		if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
+		{
+			selecting = false;
+			const float x0 = (std::min)(selectStart.x, io.MousePos.x), y0 = (std::min)(selectStart.y, io.MousePos.y);
+			const float x1 = (std::max)(selectStart.x, io.MousePos.x), y1 = (std::max)(selectStart.y, io.MousePos.y);
+			Capture_AddTrackTarget(cv::Rect2f(x0, y0, x1 - x0, y1 - y0));
+		}
+	}
 
-	for (size_t i = 0; i < res.prevPts.size() && i < res.currPts.size(); i++)
-		draw->AddLine(ImVec2(res.prevPts[i].x, res.prevPts[i].y),
-			ImVec2(res.currPts[i].x, res.currPts[i].y), colVector, 1.5f);
+	if (!res.valid || res.currPts.empty())
+		return;
+
+	const bool hasFlow = res.prevPts.size() == res.currPts.size();
+	for (size_t i = 0; i < res.currPts.size(); i++)
+	{
+		const cv::Point2f& curr = res.currPts[i];
+		const cv::Point2f shift = hasFlow ? (curr - res.prevPts[i]) * ahead : cv::Point2f();
+		draw->AddCircle(ImVec2((curr.x + shift.x) * s, (curr.y + shift.y) * s), 3.0f, colPoint, 0, 2.0f);
+		if (hasFlow)
+			draw->AddLine(ImVec2((res.prevPts[i].x + shift.x) * s, (res.prevPts[i].y + shift.y) * s),
+				ImVec2((curr.x + shift.x) * s, (curr.y + shift.y) * s), colVector, 1.5f);
+	}
 
 	if (res.poseTrail.size() >= 2)
 	{
+		/* Trail is in world units; draw it relative to the current position so it stays on screen */
 		float scale = 50.0f;
 		float ox = displayWidth * 0.5f;
 		float oy = displayHeight * 0.8f;
+		const cv::Vec3f last = res.poseTrail.back() + res.poseVelocity * ahead;
 		for (size_t i = 1; i < res.poseTrail.size(); i++)
 		{
-			const auto& a = res.poseTrail[i - 1];
-			const auto& b = res.poseTrail[i];
+			const auto a = res.poseTrail[i - 1] - last;
+			const auto b = res.poseTrail[i] - last;
 			draw->AddLine(
 				ImVec2(ox + a[0] * scale, oy - a[2] * scale),
 				ImVec2(ox + b[0] * scale, oy - b[2] * scale),
@@ -125,6 +238,11 @@ void Overlay_Render(float displayWidth, float displayHeight, const PerceptionRes
 	}
 }
 
+static float Overlay_HistogramBin(void* data, int idx)
+{
+	return (float)static_cast<const uint32_t*>(data)[idx];
+}
+
 void Overlay_DrawDebugHUD(const PerceptionResults& res)
 {
 	ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_FirstUseEver);
@@ -138,5 +256,40 @@ void Overlay_DrawDebugHUD(const PerceptionResults& res)
 			ImGui::Text("t: [%.3f %.3f %.3f]", res.t.at<double>(0), res.t.at<double>(1), res.t.at<double>(2));
 	}
 	ImGui::Text("Trail: %zu pts", res.poseTrail.size());
+	ImGui::Text("Keyframes: %zu%s", res.keyframeCount, res.relocalizedKeyframe >= 0 ? " (relocalized)" : "");
+	if (!res.templateMatches.empty())
+	{
+		size_t found = 0;
+		for (const auto& match : res.templateMatches)
+			found += match.found;
+		ImGui::Text("Templates: %zu/%zu found", found, res.templateMatches.size());
+	}
+	ImGui::Text("Tracked: %zu (Shift+drag to add)", res.trackedObjects.size());
+	if (!res.trackedObjects.empty())
+	{
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Clear"))
+			Capture_ClearTrackTargets();
+	}
+	float latencyMs = 0.0f, latencyPresents = 0.0f;
+	FrameTiming_GetLatency(latencyMs, latencyPresents);
+	ImGui::Text("Latency: %.1f ms / %.1f presents, compensation %s (F8)", latencyMs, latencyPresents,
+		Capture_GetLatencyCompensation() ? "on" : "off");
+	if (res.inference.valid)
+		ImGui::Text("Inference: %zu detections%s, batch %d, %.0f ms behind capture", res.inference.detections.size(),
+			res.inference.segmentation.empty() ? "" : " + mask", res.inference.batchSize, res.inference.latencyMs);
+	for (const auto& group : res.colorBlobs)
+		ImGui::Text("Blobs %s: %zu", group.name.c_str(), group.blobs.size());
+	if (res.motionBlockSize)
+		ImGui::Checkbox("Motion heatmap", &g_showMotionField);
+	if (res.frameStats.valid)
+	{
+		ImGui::Text("Luma: mean %.0f sd %.1f, cut score %.2f%s", res.frameStats.lumaMean, res.frameStats.lumaStddev,
+			res.sceneCutScore, res.blankFrame ? " (blank)" : res.sceneCut ? " (scene cut)" : "");
+		ImGui::PlotHistogram("##luma", Overlay_HistogramBin, (void*)res.frameStats.histogram, 256, 0, nullptr,
+			0.0f, FLT_MAX, ImVec2(256.0f, 48.0f));
+	}
+	ImGui::Text("Hash: %016llx %s (%zu stored)", (unsigned long long)res.frameHash,
+		res.duplicateFrame ? "duplicate" : "unique", res.dedupStored);
 	ImGui::End();
 }
@@ -29,7 +29,7 @@ SOFTWARE.
 
 #include "Perception.h"
 
-void Overlay_Render(float displayWidth, float displayHeight, const PerceptionResults& res);
+void Overlay_Render(float displayWidth, float displayHeight, const PerceptionResults& res, float aheadMs);
 void Overlay_DrawDebugHUD(const PerceptionResults& res);
 void Overlay_HookWindowProc(HWND hWnd);
 void Overlay_UnhookWindowProc(void);
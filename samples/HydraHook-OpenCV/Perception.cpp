@@ -26,6 +26,8 @@ SOFTWARE.
 #include <Windows.h>
 
 #include "Perception.h"
+#include "Keyframes.h"
+#include "MotionField.h"
 #include <HydraHook/Engine/HydraHookCore.h>
 
 #include <opencv2/features2d.hpp>
@@ -35,24 +37,45 @@ SOFTWARE.
 
 #include <algorithm>
 
-void RunPerceptionPipeline(cv::Mat& frame, PerceptionResults& out)
+static cv::Mat CameraMatrix(int w, int h)
+{
+	return (cv::Mat_<double>(3, 3) << (double)w, 0, w / 2.0, 0, (double)h, h / 2.0, 0, 0, 1);
+}
+
+void RunPerceptionPipeline(const cv::Mat& frame, PerceptionResults& out, bool sceneCut)
 {
 	const int minFeatures = 8;
 	const int maxPoseTrailLen = 100;
+	const int keyframeInterval = 30;
+	const int keyframeMinInliers = 40;
+	/* median inlier flow (analysis px) below which the essential matrix is treated as pure noise */
+	const float minParallax = 1.0f;
+	const int motionBlockSize = 16;
+	/* share of moving blocks above which static blocks are taken for HUD and kept out of re-detection */
+	const float minMovingFraction = 0.5f;
 
 	out.valid = false;
 
-	/* Static locals (prevGray, currGray, prevPts, currPts, orb, poseTrail, needReinit) are intentionally
-	   non-reentrant; RunPerceptionPipeline must only be called from the single Capture worker thread. */
+	/* Static locals (prevGray, currGray, prevPts, currPts, orb, poseTrail, needReinit, keyframes, world pose)
+	   are intentionally non-reentrant; RunPerceptionPipeline must only be called from the single Capture
+	   worker thread. */
 	static cv::Mat prevGray, currGray;
 	static std::vector<cv::Point2f> prevPts, currPts;
 	static cv::Ptr<cv::ORB> orb = cv::ORB::create(500);
 	static std::vector<cv::Vec3f> poseTrail;
 	static bool needReinit = true;
+	static KeyframeDatabase keyframes;
+	static cv::Matx33d worldR = cv::Matx33d::eye();
+	static cv::Vec3d worldC(0.0, 0.0, 0.0);
+	static int framesSinceKeyframe = 0;
+	static MotionEstimator motion;
 
-	if (frame.empty() || !frame.isContinuous())
+	out.keyframeCount = keyframes.Size();
+
+	/* Pooled frames may have padded rows; every stage below honours the row step */
+	if (frame.empty())
 	{
-		HydraHookEngineLogError("HydraHook-OpenCV: RunPerceptionPipeline received empty or non-continuous frame");
+		HydraHookEngineLogError("HydraHook-OpenCV: RunPerceptionPipeline received empty frame");
 		return;
 	}
 
@@ -72,13 +95,34 @@ void RunPerceptionPipeline(cv::Mat& frame, PerceptionResults& out)
 
 	currGray = gray;
 
+	/* Keyframe points are in analysis pixels; a new analysis size (ResizeBuffers) invalidates them */
+	static cv::Size keyframeSize;
+	if (currGray.size() != keyframeSize)
+	{
+		keyframes.Clear();
+		keyframeSize = currGray.size();
+	}
+
+	/* Points tracked into a different scene would only yield garbage flow */
+	if (sceneCut)
+	{
+		needReinit = true;
+		motion.Reset();
+	}
+
+	if (motion.Estimate(currGray, motionBlockSize, MotionSearchPredictive, out.motionField))
+		out.motionBlockSize = motionBlockSize;
+
 	if (needReinit || prevPts.size() < (size_t)minFeatures)
 	{
 		std::vector<cv::KeyPoint> kps;
 		cv::Mat desc;
 		try
 		{
-			orb->detectAndCompute(currGray, cv::noArray(), kps, desc);
+			cv::Mat detectMask;
+			if (MotionField_MovingMask(out.motionField, motionBlockSize, currGray.size(), detectMask) < minMovingFraction)
+				detectMask.release();
+			orb->detectAndCompute(currGray, detectMask, kps, desc);
 		}
 		catch (const cv::Exception& ex)
 		{
@@ -90,7 +134,27 @@ void RunPerceptionPipeline(cv::Mat& frame, PerceptionResults& out)
 		prevPts.clear();
 		for (const auto& kp : kps)
 			prevPts.push_back(kp.pt);
-		prevGray = currGray.clone();
+
+		/* Tracking was lost: re-anchor the pose on a stored keyframe instead of continuing blind */
+		if (keyframes.Size() && !prevGray.empty())
+		{
+			Relocalization reloc;
+			if (keyframes.Relocalize(prevPts, desc, CameraMatrix(currGray.cols, currGray.rows), reloc))
+			{
+				worldR = reloc.rotation;
+				worldC = reloc.position;
+				out.relocalizedKeyframe = reloc.keyframeId;
+				HydraHookEngineLogInfo("HydraHook-OpenCV: Relocalized on keyframe %d (%d matches, %d inliers)",
+					reloc.keyframeId, reloc.matches, reloc.inliers);
+			}
+		}
+		else if (!keyframes.Size() && prevPts.size() >= (size_t)minFeatures)
+		{
+			keyframes.Add(prevPts, desc, worldR, worldC);
+			framesSinceKeyframe = 0;
+		}
+		/* Captured frames are never written after the readback, holding a reference is enough */
+		prevGray = currGray;
 		needReinit = false;
 		out.prevPts = prevPts;
 		out.currPts = prevPts;
@@ -161,11 +225,7 @@ void RunPerceptionPipeline(cv::Mat& frame, PerceptionResults& out)
 			}
 			else
 			{
-				double fx = (double)w;
-				double fy = (double)h;
-				double cx = w / 2.0;
-				double cy = h / 2.0;
-				cv::Mat K = (cv::Mat_<double>(3, 3) << fx, 0, cx, 0, fy, cy, 0, 0, 1);
+				cv::Mat K = CameraMatrix(w, h);
 
 				cv::Mat E, R, t;
 				std::vector<int> inlierMask;
@@ -210,9 +270,36 @@ void RunPerceptionPipeline(cv::Mat& frame, PerceptionResults& out)
 							int recovered = cv::recoverPose(E, inlierPrev, inlierCurr, K, R, t);
 							if (recovered > 0 && !t.empty() && t.rows >= 3 && t.cols >= 1)
 							{
-								poseTrail.push_back(cv::Vec3f((float)t.at<double>(0), (float)t.at<double>(1), (float)t.at<double>(2)));
-								if (poseTrail.size() > (size_t)maxPoseTrailLen)
-									poseTrail.erase(poseTrail.begin());
+								std::vector<float> flow(inlierPrev.size());
+								for (size_t i = 0; i < inlierPrev.size(); i++)
+									flow[i] = (float)cv::norm(inlierCurr[i] - inlierPrev[i]);
+								std::nth_element(flow.begin(), flow.begin() + flow.size() / 2, flow.end());
+
+								/* Accumulate the camera pose (unit step per moving frame, monocular scale is unknown) */
+								if (flow[flow.size() / 2] >= minParallax)
+								{
+									const cv::Matx33d Rm(R);
+									const cv::Vec3d tv(t.at<double>(0), t.at<double>(1), t.at<double>(2));
+									const cv::Vec3d step = worldR * (Rm.t() * -tv);
+									worldC += step;
+									worldR = worldR * Rm.t();
+									out.poseVelocity = cv::Vec3f((float)step[0], (float)step[1], (float)step[2]);
+									poseTrail.push_back(cv::Vec3f((float)worldC[0], (float)worldC[1], (float)worldC[2]));
+									if (poseTrail.size() > (size_t)maxPoseTrailLen)
+										poseTrail.erase(poseTrail.begin());
+								}
+
+								if (++framesSinceKeyframe >= keyframeInterval && inliers >= keyframeMinInliers)
+								{
+									std::vector<cv::KeyPoint> kfKps;
+									cv::Mat kfDesc;
+									orb->detectAndCompute(currGray, cv::noArray(), kfKps, kfDesc);
+									std::vector<cv::Point2f> kfPts;
+									for (const auto& kp : kfKps)
+										kfPts.push_back(kp.pt);
+									keyframes.Add(kfPts, kfDesc, worldR, worldC);
+									framesSinceKeyframe = 0;
+								}
 								out.R = R;
 								out.t = t;
 								out.poseTrail = poseTrail;
@@ -228,7 +315,7 @@ void RunPerceptionPipeline(cv::Mat& frame, PerceptionResults& out)
 
 			skip_essential:
 				prevPts = goodCurr;
-				prevGray = currGray.clone();
+				prevGray = currGray;
 				out.prevPts = goodPrev;
 				out.currPts = goodCurr;
 				out.featureCount = (int)goodCurr.size();
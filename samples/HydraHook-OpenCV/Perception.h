@@ -24,9 +24,60 @@ SOFTWARE.
 
 #pragma once
 
+#include "FrameStats.h"
+#include "FrameTiming.h"
+
 #include <opencv2/core.hpp>
+#include <string>
 #include <vector>
 
+struct TemplateMatchResult
+{
+	std::string name;
+	cv::Rect2f box;			/* analysis-frame coordinates */
+	float score = 0.0f;		/* normalized cross-correlation at full analysis resolution */
+	bool found = false;
+};
+
+struct TrackedObject
+{
+	int id = 0;
+	cv::Rect2f box;			/* analysis-frame coordinates */
+	float psr = 0.0f;		/* peak-to-sidelobe ratio of the last correlation response */
+	bool occluded = false;	/* PSR below threshold, box held at the last confident position */
+	cv::Point2f velocity;	/* analysis pixels per analyzed frame */
+};
+
+struct ColorBlob
+{
+	cv::Rect box;			/* swap chain coordinates */
+	int area = 0;			/* pixels */
+	cv::Point2f centroid;	/* swap chain coordinates */
+};
+
+struct ColorBlobGroup
+{
+	std::string name;				/* color rule the blobs matched */
+	std::vector<ColorBlob> blobs;	/* largest first */
+};
+
+struct InferenceDetection
+{
+	int classId = 0;
+	float score = 0.0f;
+	cv::Rect2f box;			/* analysis-frame coordinates */
+};
+
+struct InferenceResults
+{
+	bool valid = false;
+	FrameTag tag;			/* frame the model saw; usually a few frames behind the rest of the results */
+	std::vector<InferenceDetection> detections;
+	cv::Mat segmentation;	/* CV_8UC1 class per pixel at model output resolution (segmentation models) */
+	int batchSize = 0;		/* frames in the batch this one was part of */
+	float latencyMs = 0.0f;	/* capture to result */
+};
+
 struct PerceptionResults
 {
 	std::vector<cv::Point2f> prevPts;
@@ -37,6 +88,26 @@ struct PerceptionResults
 	bool valid = false;
 	int featureCount = 0;
 	int inliers = 0;
+	float frameScale = 1.0f;	/* display pixels per analysis-frame pixel */
+	uint64_t frameHash = 0;
+	int dedupDistance = -1;		/* distance to the closest stored fingerprint, -1 if none in range */
+	bool duplicateFrame = false;
+	size_t dedupStored = 0;
+	std::vector<TemplateMatchResult> templateMatches;
+	std::vector<TrackedObject> trackedObjects;
+	size_t keyframeCount = 0;
+	int relocalizedKeyframe = -1;	/* keyframe the pose was re-anchored on this frame, -1 if none */
+	cv::Vec3f poseVelocity;			/* world step of this frame */
+	FrameTag tag;					/* captured frame these results belong to */
+	float frameIntervalMs = 0.0f;	/* capture time between this and the previously analyzed frame */
+	FrameStats frameStats;
+	float sceneCutScore = 0.0f;		/* max of histogram and tile color distance to the previous frame */
+	bool sceneCut = false;
+	bool blankFrame = false;		/* flat frame (fade, loading screen); perception stages were skipped */
+	cv::Mat motionField;			/* CV_16SC2 block motion in analysis pixels, empty if unavailable */
+	int motionBlockSize = 0;
+	InferenceResults inference;
+	std::vector<ColorBlobGroup> colorBlobs;
 };
 
-void RunPerceptionPipeline(cv::Mat& frame, PerceptionResults& out);
+void RunPerceptionPipeline(const cv::Mat& frame, PerceptionResults& out, bool sceneCut);
@@ -0,0 +1,259 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "TemplateMatch.h"
+#include <HydraHook/Engine/HydraHookCore.h>
+
+#include <opencv2/core/utility.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr float TEMPLATE_MATCH_THRESHOLD = 0.8f;
+static constexpr int TEMPLATE_MAX_PYRAMID_LEVELS = 3;
+/* a template is not searched at a level where its smaller side drops below this */
+static constexpr int TEMPLATE_MIN_COARSE_SIZE = 12;
+static constexpr int TEMPLATE_COARSE_CANDIDATES = 3;
+/* refinement window radius per level, in pixels of that level */
+static constexpr int TEMPLATE_REFINE_RADIUS = 2;
+/* minimum search margin around the last box of a tracked template, analysis pixels */
+static constexpr int TEMPLATE_TRACK_MARGIN = 16;
+
+bool TemplateMatcher::Add(const std::string& name, const cv::Mat& gray)
+{
+	if (gray.empty() || gray.type() != CV_8UC1)
+		return false;
+
+	cv::Scalar mean, stddev;
+	cv::meanStdDev(gray, mean, stddev);
+	if (stddev[0] < 2.0)
+	{
+		HydraHookEngineLogWarning("HydraHook-OpenCV: Template %s is flat, NCC is undefined for it", name.c_str());
+		return false;
+	}
+
+	Template t;
+	t.name = name;
+	t.source = gray.clone();
+	m_Templates.push_back(std::move(t));
+	return true;
+}
+
+size_t TemplateMatcher::LoadDirectory(const char* directory)
+{
+	const std::string dir(directory);
+	WIN32_FIND_DATAA data;
+	const HANDLE find = FindFirstFileA((dir + "\\*.png").c_str(), &data);
+	if (find == INVALID_HANDLE_VALUE)
+		return 0;
+
+	size_t loaded = 0;
+	do
+	{
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			continue;
+		const std::string file = data.cFileName;
+		const cv::Mat image = cv::imread(dir + "\\" + file, cv::IMREAD_GRAYSCALE);
+		if (image.empty())
+		{
+			HydraHookEngineLogWarning("HydraHook-OpenCV: Failed to load template %s", file.c_str());
+			continue;
+		}
+		if (Add(file.substr(0, file.find_last_of('.')), image))
+			loaded++;
+	}
+	while (FindNextFileA(find, &data));
+
+	FindClose(find);
+	return loaded;
+}
+
+void TemplateMatcher::ResetTracking()
+{
+	for (Template& t : m_Templates)
+		t.tracked = false;
+}
+
+/**
+ * @brief Best match of a template inside region (level-0 coordinates), coarse level first.
+ */
+bool TemplateMatcher::Search(const Template& t, cv::Rect region, cv::Point& position, float& score) const
+{
+	static thread_local cv::Mat response;
+
+	const int top = (int)t.pyramid.size() - 1;
+	const cv::Mat& coarseImage = m_FramePyramid[top];
+	const cv::Mat& coarseTemplate = t.pyramid[top];
+	const int cell = 1 << top;
+
+	cv::Rect roi(region.x / cell, region.y / cell,
+		(region.x + region.width + cell - 1) / cell - region.x / cell,
+		(region.y + region.height + cell - 1) / cell - region.y / cell);
+	roi &= cv::Rect(0, 0, coarseImage.cols, coarseImage.rows);
+	if (roi.width < coarseTemplate.cols || roi.height < coarseTemplate.rows)
+		return false;
+
+	cv::matchTemplate(coarseImage(roi), coarseTemplate, response, cv::TM_CCOEFF_NORMED);
+
+	/* Refine the strongest few coarse peaks; the best coarse peak is not always the best full-res one */
+	bool found = false;
+	for (int candidate = 0; candidate < TEMPLATE_COARSE_CANDIDATES; candidate++)
+	{
+		double peak = 0.0;
+		cv::Point peakLoc;
+		cv::minMaxLoc(response, nullptr, &peak, nullptr, &peakLoc);
+		if (candidate > 0 && peak < TEMPLATE_MATCH_THRESHOLD * 0.5)
+			break;
+
+		const cv::Rect suppress(peakLoc.x - coarseTemplate.cols / 2, peakLoc.y - coarseTemplate.rows / 2,
+			coarseTemplate.cols, coarseTemplate.rows);
+		response(suppress & cv::Rect(0, 0, response.cols, response.rows)).setTo(-1.0f);
+
+		cv::Point pos = roi.tl() + peakLoc;
+		double levelScore = peak;
+		bool valid = true;
+		for (int level = top - 1; level >= 0 && valid; level--)
+		{
+			const cv::Mat& image = m_FramePyramid[level];
+			const cv::Mat& tpl = t.pyramid[level];
+			cv::Rect window(pos.x * 2 - TEMPLATE_REFINE_RADIUS, pos.y * 2 - TEMPLATE_REFINE_RADIUS,
+				tpl.cols + 2 * TEMPLATE_REFINE_RADIUS, tpl.rows + 2 * TEMPLATE_REFINE_RADIUS);
+			window &= cv::Rect(0, 0, image.cols, image.rows);
+			if (window.width < tpl.cols || window.height < tpl.rows)
+			{
+				valid = false;
+				break;
+			}
+
+			cv::Mat refine;
+			cv::matchTemplate(image(window), tpl, refine, cv::TM_CCOEFF_NORMED);
+			cv::Point refineLoc;
+			cv::minMaxLoc(refine, nullptr, &levelScore, nullptr, &refineLoc);
+			pos = window.tl() + refineLoc;
+		}
+
+		if (valid && (!found || levelScore > score))
+		{
+			found = true;
+			score = (float)levelScore;
+			position = pos;
+		}
+	}
+	return found;
+}
+
+void TemplateMatcher::MatchTemplate(Template& t, TemplateMatchResult& result) const
+{
+	result.name = t.name;
+	result.found = false;
+	result.score = 0.0f;
+	if (t.pyramid.empty())
+		return;
+
+	const cv::Mat& tpl = t.pyramid[0];
+	const cv::Rect full(0, 0, m_FramePyramid[0].cols, m_FramePyramid[0].rows);
+	cv::Point pos;
+	float score = 0.0f;
+	bool found = false;
+
+	if (t.tracked)
+	{
+		const int mx = (std::max)(TEMPLATE_TRACK_MARGIN, tpl.cols / 2);
+		const int my = (std::max)(TEMPLATE_TRACK_MARGIN, tpl.rows / 2);
+		const cv::Rect region(t.lastBox.x - mx, t.lastBox.y - my, t.lastBox.width + 2 * mx, t.lastBox.height + 2 * my);
+		found = Search(t, region & full, pos, score) && score >= TEMPLATE_MATCH_THRESHOLD;
+	}
+	if (!found)
+		found = Search(t, full, pos, score) && score >= TEMPLATE_MATCH_THRESHOLD;
+
+	t.tracked = found;
+	if (found)
+		t.lastBox = cv::Rect(pos, tpl.size());
+
+	result.box = cv::Rect2f((float)pos.x, (float)pos.y, (float)tpl.cols, (float)tpl.rows);
+	result.score = score;
+	result.found = found;
+}
+
+void TemplateMatcher::Match(const cv::Mat& gray, float frameScale, std::vector<TemplateMatchResult>& out)
+{
+	if (gray.empty() || gray.type() != CV_8UC1 || m_Templates.empty() || frameScale <= 0.0f)
+	{
+		out.clear();
+		return;
+	}
+
+	/* (Re)build template pyramids when the analysis scale changes, e.g. after ResizeBuffers */
+	size_t levels = 1;
+	for (Template& t : m_Templates)
+	{
+		if (t.pyramidScale != frameScale)
+		{
+			t.pyramid.clear();
+			t.tracked = false;
+			t.pyramidScale = frameScale;
+
+			const cv::Size size((int)std::lround(t.source.cols / frameScale), (int)std::lround(t.source.rows / frameScale));
+			if (size.width >= 4 && size.height >= 4)
+			{
+				cv::Mat scaled;
+				if (size == t.source.size())
+					scaled = t.source;
+				else
+					cv::resize(t.source, scaled, size, 0, 0, cv::INTER_AREA);
+				t.pyramid.push_back(scaled);
+
+				while ((int)t.pyramid.size() < TEMPLATE_MAX_PYRAMID_LEVELS
+					&& (std::min)(t.pyramid.back().cols, t.pyramid.back().rows) / 2 >= TEMPLATE_MIN_COARSE_SIZE)
+				{
+					cv::Mat down;
+					cv::pyrDown(t.pyramid.back(), down);
+					t.pyramid.push_back(down);
+				}
+			}
+			else
+			{
+				HydraHookEngineLogWarning("HydraHook-OpenCV: Template %s is too small at analysis scale %.2f", t.name.c_str(), frameScale);
+			}
+		}
+		levels = (std::max)(levels, t.pyramid.size());
+	}
+
+	m_FramePyramid.resize(levels);
+	m_FramePyramid[0] = gray;
+	for (size_t level = 1; level < levels; level++)
+		cv::pyrDown(m_FramePyramid[level - 1], m_FramePyramid[level]);
+
+	out.resize(m_Templates.size());
+	cv::parallel_for_(cv::Range(0, (int)m_Templates.size()), [&](const cv::Range& range)
+	{
+		for (int i = range.start; i < range.end; i++)
+			MatchTemplate(m_Templates[(size_t)i], out[(size_t)i]);
+	});
+}
@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Perception.h"
+
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Locates known UI elements with coarse-to-fine normalized cross-correlation.
+ *
+ * Templates are given at swap chain resolution and rescaled to the analysis frame. Each template
+ * is searched at the coarsest pyramid level it still has detail at, then refined level by level in
+ * a small window. A template found in the previous frame is only searched around its last box;
+ * templates run in parallel on OpenCV's thread pool.
+ */
+class TemplateMatcher
+{
+public:
+	bool Add(const std::string& name, const cv::Mat& gray);
+	size_t LoadDirectory(const char* directory);
+	size_t Size() const { return m_Templates.size(); }
+	void ResetTracking();
+	void Match(const cv::Mat& gray, float frameScale, std::vector<TemplateMatchResult>& out);
+
+private:
+	struct Template
+	{
+		std::string name;
+		cv::Mat source;					/* as loaded, swap chain resolution */
+		std::vector<cv::Mat> pyramid;	/* rescaled to the analysis frame, level 0 = full */
+		float pyramidScale = 0.0f;
+		cv::Rect lastBox;
+		bool tracked = false;
+	};
+
+	void MatchTemplate(Template& t, TemplateMatchResult& result) const;
+	bool Search(const Template& t, cv::Rect region, cv::Point& position, float& score) const;
+
+	std::vector<Template> m_Templates;
+	std::vector<cv::Mat> m_FramePyramid;
+};
@@ -0,0 +1,215 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "Tracker.h"
+#include <HydraHook/Engine/HydraHookCore.h>
+
+#include <opencv2/core/utility.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/* object window = box * padding, rounded up to a fast DFT size */
+static constexpr float TRACKER_PADDING = 1.5f;
+static constexpr int TRACKER_MIN_BOX_SIZE = 8;
+static constexpr double TRACKER_GOAL_SIGMA = 2.0;
+static constexpr int TRACKER_INIT_SAMPLES = 8;
+static constexpr float TRACKER_LEARNING_RATE = 0.125f;
+static constexpr float TRACKER_REGULARIZATION = 0.01f;
+/* MOSSE paper: PSR of a good track is 20-60, below ~7 the object is occluded or lost */
+static constexpr float TRACKER_MIN_PSR = 7.0f;
+static constexpr int TRACKER_PSR_EXCLUDE = 11;
+static constexpr int TRACKER_MAX_OCCLUDED_FRAMES = 90;
+
+/**
+ * @brief log, zero-mean/unit-variance and Hann window, then forward DFT.
+ */
+void CorrelationTracker::Spectrum(const cv::Mat& patch, const cv::Mat& cosine, cv::Mat& spectrum)
+{
+	cv::Mat f;
+	patch.convertTo(f, CV_32F, 1.0, 1.0);
+	cv::log(f, f);
+	cv::Scalar mean, stddev;
+	cv::meanStdDev(f, mean, stddev);
+	f = (f - mean[0]) / (stddev[0] + 1e-5);
+	cv::multiply(f, cosine, f);
+	cv::dft(f, spectrum, cv::DFT_COMPLEX_OUTPUT);
+}
+
+/**
+ * @brief Blends the sample spectrum into the filter; rate 1 replaces it.
+ */
+void CorrelationTracker::Train(Target& t, const cv::Mat& spectrum, float rate)
+{
+	cv::Mat num, energy;
+	cv::mulSpectrums(t.goal, spectrum, num, 0, true);
+	cv::mulSpectrums(spectrum, spectrum, energy, 0, true);
+	cv::Mat den;
+	cv::extractChannel(energy, den, 0);
+
+	if (t.numerator.empty() || rate >= 1.0f)
+	{
+		t.numerator = num;
+		t.denominator = den;
+	}
+	else
+	{
+		cv::addWeighted(num, rate, t.numerator, 1.0f - rate, 0.0, t.numerator);
+		cv::addWeighted(den, rate, t.denominator, 1.0f - rate, 0.0, t.denominator);
+	}
+}
+
+int CorrelationTracker::Add(const cv::Mat& gray, const cv::Rect2f& box)
+{
+	if (gray.empty() || gray.type() != CV_8UC1 || box.width < TRACKER_MIN_BOX_SIZE || box.height < TRACKER_MIN_BOX_SIZE)
+		return -1;
+
+	Target t;
+	t.id = m_NextId++;
+	t.center = cv::Point2f(box.x + box.width * 0.5f, box.y + box.height * 0.5f);
+	t.boxSize = box.size();
+	t.window = cv::Size(
+		cv::getOptimalDFTSize((int)std::ceil(box.width * TRACKER_PADDING)),
+		cv::getOptimalDFTSize((int)std::ceil(box.height * TRACKER_PADDING)));
+	cv::createHanningWindow(t.cosine, t.window, CV_32F);
+
+	cv::Mat goal(t.window, CV_32F);
+	const float cx = t.window.width * 0.5f, cy = t.window.height * 0.5f;
+	for (int y = 0; y < goal.rows; y++)
+	{
+		float* row = goal.ptr<float>(y);
+		for (int x = 0; x < goal.cols; x++)
+			row[x] = (float)std::exp(-((x - cx) * (x - cx) + (y - cy) * (y - cy)) / (2.0 * TRACKER_GOAL_SIGMA * TRACKER_GOAL_SIGMA));
+	}
+	cv::dft(goal, t.goal, cv::DFT_COMPLEX_OUTPUT);
+
+	/* Initial filter from small random rotations/scales of the first patch */
+	cv::Mat patch, warped, spectrum;
+	cv::getRectSubPix(gray, t.window, t.center, patch);
+	cv::RNG rng((uint64)t.id);
+	for (int i = 0; i < TRACKER_INIT_SAMPLES; i++)
+	{
+		if (i == 0)
+		{
+			warped = patch;
+		}
+		else
+		{
+			const cv::Mat m = cv::getRotationMatrix2D(cv::Point2f(cx, cy), rng.uniform(-10.0, 10.0), rng.uniform(0.95, 1.05));
+			cv::warpAffine(patch, warped, m, t.window, cv::INTER_LINEAR, cv::BORDER_REFLECT);
+		}
+		Spectrum(warped, t.cosine, spectrum);
+		Train(t, spectrum, i == 0 ? 1.0f : 1.0f / (i + 1));
+	}
+
+	m_Targets.push_back(std::move(t));
+	return m_Targets.back().id;
+}
+
+void CorrelationTracker::Clear()
+{
+	m_Targets.clear();
+}
+
+void CorrelationTracker::UpdateTarget(Target& t, const cv::Mat& gray)
+{
+	cv::Mat patch, spectrum, filter, product, response;
+	cv::getRectSubPix(gray, t.window, t.center, patch);
+	Spectrum(patch, t.cosine, spectrum);
+
+	/* H* = numerator / denominator, response = IDFT(F * H*) */
+	cv::Mat channels[2];
+	cv::split(t.numerator, channels);
+	const cv::Mat den = t.denominator + TRACKER_REGULARIZATION;
+	cv::divide(channels[0], den, channels[0]);
+	cv::divide(channels[1], den, channels[1]);
+	cv::merge(channels, 2, filter);
+	cv::mulSpectrums(spectrum, filter, product, 0);
+	cv::idft(product, response, cv::DFT_SCALE | cv::DFT_REAL_OUTPUT);
+
+	double peak = 0.0;
+	cv::Point peakLoc;
+	cv::minMaxLoc(response, nullptr, &peak, nullptr, &peakLoc);
+
+	cv::Mat sidelobe(response.size(), CV_8UC1, cv::Scalar(255));
+	cv::rectangle(sidelobe, cv::Rect(peakLoc.x - TRACKER_PSR_EXCLUDE / 2, peakLoc.y - TRACKER_PSR_EXCLUDE / 2,
+		TRACKER_PSR_EXCLUDE, TRACKER_PSR_EXCLUDE), cv::Scalar(0), cv::FILLED);
+	cv::Scalar mean, stddev;
+	cv::meanStdDev(response, mean, stddev, sidelobe);
+	t.psr = (float)((peak - mean[0]) / (stddev[0] + 1e-5));
+
+	if (t.psr < TRACKER_MIN_PSR)
+	{
+		t.occludedFrames++;
+		t.velocity = cv::Point2f();
+		return;
+	}
+	t.occludedFrames = 0;
+
+	t.velocity = cv::Point2f(peakLoc.x - t.window.width * 0.5f, peakLoc.y - t.window.height * 0.5f);
+	t.center += t.velocity;
+	t.center.x = (std::min)((std::max)(t.center.x, 0.0f), (float)gray.cols - 1);
+	t.center.y = (std::min)((std::max)(t.center.y, 0.0f), (float)gray.rows - 1);
+
+	cv::getRectSubPix(gray, t.window, t.center, patch);
+	Spectrum(patch, t.cosine, spectrum);
+	Train(t, spectrum, TRACKER_LEARNING_RATE);
+}
+
+void CorrelationTracker::Update(const cv::Mat& gray, std::vector<TrackedObject>& out)
+{
+	out.clear();
+	if (gray.empty() || gray.type() != CV_8UC1 || m_Targets.empty())
+		return;
+
+	cv::parallel_for_(cv::Range(0, (int)m_Targets.size()), [&](const cv::Range& range)
+	{
+		for (int i = range.start; i < range.end; i++)
+			UpdateTarget(m_Targets[(size_t)i], gray);
+	});
+
+	m_Targets.erase(std::remove_if(m_Targets.begin(), m_Targets.end(), [](const Target& t)
+	{
+		if (t.occludedFrames <= TRACKER_MAX_OCCLUDED_FRAMES)
+			return false;
+		HydraHookEngineLogInfo("HydraHook-OpenCV: Tracked object %d lost", t.id);
+		return true;
+	}), m_Targets.end());
+
+	out.reserve(m_Targets.size());
+	for (const Target& t : m_Targets)
+	{
+		TrackedObject obj;
+		obj.id = t.id;
+		obj.box = cv::Rect2f(t.center.x - t.boxSize.width * 0.5f, t.center.y - t.boxSize.height * 0.5f, t.boxSize.width, t.boxSize.height);
+		obj.psr = t.psr;
+		obj.occluded = t.occludedFrames > 0;
+		obj.velocity = t.velocity;
+		out.push_back(obj);
+	}
+}
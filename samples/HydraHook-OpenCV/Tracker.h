@@ -0,0 +1,70 @@
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Perception.h"
+
+#include <opencv2/core.hpp>
+#include <vector>
+
+/**
+ * @brief MOSSE correlation-filter tracker for a set of on-screen objects.
+ *
+ * Each object keeps an adaptive filter in the frequency domain; an update is two forward
+ * FFTs and one inverse FFT of the padded object window, so cost depends on box size only.
+ * A peak-to-sidelobe ratio below threshold marks the object occluded and freezes its filter
+ * instead of letting it drift onto the occluder. Objects update in parallel on OpenCV's pool.
+ */
+class CorrelationTracker
+{
+public:
+	int Add(const cv::Mat& gray, const cv::Rect2f& box);
+	void Clear();
+	size_t Size() const { return m_Targets.size(); }
+	void Update(const cv::Mat& gray, std::vector<TrackedObject>& out);
+
+private:
+	struct Target
+	{
+		int id = 0;
+		cv::Point2f center;
+		cv::Size2f boxSize;
+		cv::Size window;
+		cv::Mat cosine;			/* Hann window, CV_32F */
+		cv::Mat goal;			/* spectrum of the desired Gaussian response */
+		cv::Mat numerator;		/* running sum of goal * conj(F) */
+		cv::Mat denominator;	/* running sum of |F|^2, real */
+		cv::Point2f velocity;
+		float psr = 0.0f;
+		int occludedFrames = 0;
+	};
+
+	static void Spectrum(const cv::Mat& patch, const cv::Mat& cosine, cv::Mat& spectrum);
+	static void Train(Target& t, const cv::Mat& spectrum, float rate);
+	static void UpdateTarget(Target& t, const cv::Mat& gray);
+
+	std::vector<Target> m_Targets;
+	int m_NextId = 1;
+};
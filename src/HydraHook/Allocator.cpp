@@ -0,0 +1,766 @@
+/**
+ * @file Allocator.cpp
+ * @brief Thread-caching size-class slab allocator and its C API exports.
+ *
+ * Every block carries a 16-byte header recording its origin (size class,
+ * large allocation, or process heap fallback) and its accounting tag. Free
+ * blocks are kept in intrusive singly linked lists: one per size class per
+ * thread, backed by a lock-protected central list that is refilled from
+ * 64 KiB+ slabs. Per-tag usage is a plain counter per thread cache, summed
+ * only when queried.
+ *
+ * @internal
+ */
+
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <intrin.h>
+
+//
+// Public
+//
+#include "HydraHook/Engine/HydraHookCore.h"
+
+//
+// Internal
+//
+#include "Allocator.h"
+
+//
+// STL
+//
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+//
+// Construct before and destroy after all user-level statics so that objects
+// released during CRT teardown can still return their memory.
+//
+#pragma warning(disable: 4073)
+#pragma init_seg(lib)
+
+namespace
+{
+	constexpr size_t kHeaderSize = 16;
+	constexpr size_t kMaxSmallSize = 32 * 1024;
+	constexpr uint32_t kNumSizeClasses = 40;
+	constexpr size_t kMinSlabSize = 64 * 1024;
+	constexpr size_t kBatchBytes = 16 * 1024;
+
+	constexpr uint32_t kMagicSmall = 0x48484B53;       // 'HHKS'
+	constexpr uint32_t kMagicLarge = 0x48484B4C;       // 'HHKL'
+	constexpr uint32_t kMagicProcessHeap = 0x48484B50; // 'HHKP'
+
+	/**
+	 * @brief Prefix of every block; overlaid by FreeBlock while cached.
+	 */
+	struct alignas(16) BlockHeader
+	{
+		uint16_t SizeClass;
+		uint16_t Tag;
+		uint32_t Magic;
+		size_t Size;
+	};
+
+	static_assert(sizeof(BlockHeader) == kHeaderSize, "block header must stay 16 bytes");
+
+	struct FreeBlock
+	{
+		FreeBlock* Next;
+	};
+
+	struct alignas(64) CentralList
+	{
+		SRWLOCK Lock;
+		FreeBlock* Head;
+		size_t Count;
+	};
+
+	struct ThreadCache
+	{
+		struct
+		{
+			FreeBlock* Head;
+			uint32_t Count;
+		} Bins[kNumSizeClasses];
+
+		// Owner-written only (relaxed load + store, no lock prefix); may go
+		// negative when this thread frees blocks allocated elsewhere
+		std::atomic<int64_t> TagBytes[HydraHookMemoryTagCount];
+
+		ThreadCache* NextCache;       // registry link, never unlinked
+		std::atomic<bool> InUse;      // false once the owning thread exited
+	};
+
+	FORCEINLINE void Charge(ThreadCache* tc, uint32_t tag, int64_t bytes)
+	{
+		auto& counter = tc->TagBytes[tag];
+		counter.store(counter.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Maps a request size to its size class index.
+	 *
+	 * 16-byte steps up to 128 bytes, then four classes per power of two up
+	 * to 32 KiB (160, 192, 224, 256, 320, ...).
+	 */
+	FORCEINLINE uint32_t SizeToClass(size_t size)
+	{
+		if (size <= 128)
+		{
+			return size ? static_cast<uint32_t>((size + 15) / 16 - 1) : 0;
+		}
+
+		const auto v = static_cast<unsigned long>(size - 1);
+		unsigned long msb;
+		_BitScanReverse(&msb, v);
+
+		return 8 + (msb - 7) * 4 + ((v >> (msb - 2)) & 3);
+	}
+
+	constexpr size_t ClassToSize(uint32_t cls)
+	{
+		if (cls < 8)
+		{
+			return (static_cast<size_t>(cls) + 1) * 16;
+		}
+
+		const size_t base = size_t{ 128 } << ((cls - 8) / 4);
+		return base + ((cls - 8) % 4 + 1) * (base / 4);
+	}
+
+	static_assert(ClassToSize(kNumSizeClasses - 1) == kMaxSmallSize, "size class table mismatch");
+
+	/**
+	 * @brief Bytes charged to the tag of a live block.
+	 */
+	FORCEINLINE int64_t BlockBytes(const BlockHeader* hdr)
+	{
+		return static_cast<int64_t>(hdr->Magic == kMagicSmall ? ClassToSize(hdr->SizeClass) : hdr->Size);
+	}
+
+	constexpr uint32_t BatchCount(uint32_t cls)
+	{
+		const size_t n = kBatchBytes / ClassToSize(cls);
+		return static_cast<uint32_t>(n < 2 ? 2 : (n > 64 ? 64 : n));
+	}
+
+	/**
+	 * @brief Process-wide allocator state; constant-initialized.
+	 */
+	class SlabAllocator
+	{
+		std::atomic<HANDLE> m_Heap{ nullptr };
+		std::atomic<bool> m_TornDown{ false };
+		CentralList m_Central[kNumSizeClasses]{};
+		SRWLOCK m_RegistryLock = SRWLOCK_INIT;
+		ThreadCache* m_Caches = nullptr;
+		std::atomic<int64_t> m_UntrackedBytes[HydraHookMemoryTagCount]{};
+		std::atomic<int64_t> m_PeakBytes[HydraHookMemoryTagCount]{};
+		std::atomic<size_t> m_HeapBytes{ 0 };
+
+	public:
+		constexpr SlabAllocator() = default;
+
+		~SlabAllocator()
+		{
+			m_TornDown.store(true, std::memory_order_release);
+
+			if (const HANDLE heap = m_Heap.exchange(nullptr))
+			{
+				HeapDestroy(heap);
+			}
+		}
+
+		SlabAllocator(const SlabAllocator&) = delete;
+		SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+		bool IsTornDown() const noexcept
+		{
+			return m_TornDown.load(std::memory_order_acquire);
+		}
+
+		HANDLE Heap() noexcept
+		{
+			HANDLE heap = m_Heap.load(std::memory_order_acquire);
+			if (heap || IsTornDown())
+			{
+				return heap;
+			}
+
+			HANDLE created = HeapCreate(0, 0, 0);
+			if (!created)
+			{
+				return nullptr;
+			}
+
+			// Low-fragmentation front end for the large-block path
+			ULONG lfh = 2;
+			(void)HeapSetInformation(created, HeapCompatibilityInformation, &lfh, sizeof(lfh));
+
+			if (!m_Heap.compare_exchange_strong(heap, created, std::memory_order_acq_rel))
+			{
+				HeapDestroy(created);
+				return heap;
+			}
+
+			return created;
+		}
+
+		ThreadCache* AcquireCache() noexcept
+		{
+			//
+			// Recycle a cache left behind by an exited thread first
+			//
+			AcquireSRWLockShared(&m_RegistryLock);
+			for (auto tc = m_Caches; tc; tc = tc->NextCache)
+			{
+				bool expected = false;
+				if (tc->InUse.compare_exchange_strong(expected, true))
+				{
+					ReleaseSRWLockShared(&m_RegistryLock);
+					return tc;
+				}
+			}
+			ReleaseSRWLockShared(&m_RegistryLock);
+
+			const HANDLE heap = Heap();
+			if (!heap)
+			{
+				return nullptr;
+			}
+
+			auto tc = static_cast<ThreadCache*>(HeapAlloc(heap, HEAP_ZERO_MEMORY, sizeof(ThreadCache)));
+			if (!tc)
+			{
+				return nullptr;
+			}
+
+			new (tc) ThreadCache{};
+			tc->InUse.store(true);
+
+			AcquireSRWLockExclusive(&m_RegistryLock);
+			tc->NextCache = m_Caches;
+			m_Caches = tc;
+			ReleaseSRWLockExclusive(&m_RegistryLock);
+
+			return tc;
+		}
+
+		void ReleaseCache(ThreadCache* tc) noexcept
+		{
+			for (uint32_t cls = 0; cls < kNumSizeClasses; cls++)
+			{
+				auto& bin = tc->Bins[cls];
+				if (bin.Head)
+				{
+					PushCentral(cls, bin.Head, bin.Count);
+					bin.Head = nullptr;
+					bin.Count = 0;
+				}
+			}
+
+			tc->InUse.store(false);
+		}
+
+		/**
+		 * @brief Moves up to one batch of blocks into the thread bin, carving a new slab if needed.
+		 */
+		bool Refill(ThreadCache* tc, uint32_t cls) noexcept
+		{
+			auto& bin = tc->Bins[cls];
+			auto& central = m_Central[cls];
+			const uint32_t batch = BatchCount(cls);
+
+			AcquireSRWLockExclusive(&central.Lock);
+			if (central.Head)
+			{
+				FreeBlock* head = central.Head;
+				FreeBlock* tail = head;
+				uint32_t taken = 1;
+
+				while (taken < batch && tail->Next)
+				{
+					tail = tail->Next;
+					taken++;
+				}
+
+				central.Head = tail->Next;
+				central.Count -= taken;
+				ReleaseSRWLockExclusive(&central.Lock);
+
+				tail->Next = bin.Head;
+				bin.Head = head;
+				bin.Count += taken;
+				return true;
+			}
+			ReleaseSRWLockExclusive(&central.Lock);
+
+			return CarveSlab(tc, cls);
+		}
+
+		/**
+		 * @brief Returns one batch from an overfull thread bin to the central list.
+		 */
+		void Drain(ThreadCache* tc, uint32_t cls) noexcept
+		{
+			auto& bin = tc->Bins[cls];
+			const uint32_t batch = BatchCount(cls);
+
+			FreeBlock* head = bin.Head;
+			FreeBlock* tail = head;
+			for (uint32_t i = 1; i < batch; i++)
+			{
+				tail = tail->Next;
+			}
+
+			bin.Head = tail->Next;
+			bin.Count -= batch;
+			tail->Next = nullptr;
+
+			PushCentral(cls, head, batch);
+		}
+
+		/**
+		 * @brief Charges a thread without a cache (or after teardown) via the shared counters.
+		 */
+		void ChargeUntracked(uint32_t tag, int64_t bytes) noexcept
+		{
+			m_UntrackedBytes[tag].fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		void QueryUsage(uint32_t tag, size_t* current, size_t* peak) noexcept
+		{
+			int64_t sum = m_UntrackedBytes[tag].load(std::memory_order_relaxed);
+
+			AcquireSRWLockShared(&m_RegistryLock);
+			for (auto tc = m_Caches; tc; tc = tc->NextCache)
+			{
+				sum += tc->TagBytes[tag].load(std::memory_order_relaxed);
+			}
+			ReleaseSRWLockShared(&m_RegistryLock);
+
+			// Counters are sampled without a global snapshot; clamp transient skew
+			if (sum < 0)
+			{
+				sum = 0;
+			}
+
+			int64_t prev = m_PeakBytes[tag].load(std::memory_order_relaxed);
+			while (sum > prev && !m_PeakBytes[tag].compare_exchange_weak(prev, sum, std::memory_order_relaxed))
+			{
+			}
+
+			*current = static_cast<size_t>(sum);
+			*peak = static_cast<size_t>(sum > prev ? sum : prev);
+		}
+
+		size_t HeapBytes() const noexcept
+		{
+			return m_HeapBytes.load(std::memory_order_relaxed);
+		}
+
+		void* AllocateLarge(size_t size) noexcept
+		{
+			if (size > SIZE_MAX - kHeaderSize)
+			{
+				return nullptr;
+			}
+
+			const HANDLE heap = Heap();
+			const bool fallback = heap == nullptr;
+
+			auto hdr = static_cast<BlockHeader*>(HeapAlloc(fallback ? GetProcessHeap() : heap, 0, size + kHeaderSize));
+			if (!hdr)
+			{
+				return nullptr;
+			}
+
+			hdr->SizeClass = 0;
+			hdr->Magic = fallback ? kMagicProcessHeap : kMagicLarge;
+			hdr->Size = size;
+
+			if (!fallback)
+			{
+				m_HeapBytes.fetch_add(size + kHeaderSize, std::memory_order_relaxed);
+			}
+
+			return hdr + 1;
+		}
+
+		void FreeLarge(BlockHeader* hdr) noexcept
+		{
+			if (const HANDLE heap = m_Heap.load(std::memory_order_acquire))
+			{
+				m_HeapBytes.fetch_sub(hdr->Size + kHeaderSize, std::memory_order_relaxed);
+				HeapFree(heap, 0, hdr);
+			}
+		}
+
+		/**
+		 * @brief Returns a single small block straight to the central list (thread has no cache).
+		 */
+		void FreeCentral(BlockHeader* hdr) noexcept
+		{
+			const auto block = reinterpret_cast<FreeBlock*>(hdr);
+			block->Next = nullptr;
+			PushCentral(hdr->SizeClass, block, 1);
+		}
+
+	private:
+		void PushCentral(uint32_t cls, FreeBlock* head, size_t count) noexcept
+		{
+			FreeBlock* tail = head;
+			while (tail->Next)
+			{
+				tail = tail->Next;
+			}
+
+			auto& central = m_Central[cls];
+			AcquireSRWLockExclusive(&central.Lock);
+			tail->Next = central.Head;
+			central.Head = head;
+			central.Count += count;
+			ReleaseSRWLockExclusive(&central.Lock);
+		}
+
+		bool CarveSlab(ThreadCache* tc, uint32_t cls) noexcept
+		{
+			const HANDLE heap = Heap();
+			if (!heap)
+			{
+				return false;
+			}
+
+			const size_t stride = ClassToSize(cls) + kHeaderSize;
+			const size_t slabSize = stride * 8 > kMinSlabSize ? stride * 8 : kMinSlabSize;
+			const size_t blocks = slabSize / stride;
+
+			auto slab = static_cast<uint8_t*>(HeapAlloc(heap, 0, slabSize));
+			if (!slab)
+			{
+				return false;
+			}
+
+			m_HeapBytes.fetch_add(slabSize, std::memory_order_relaxed);
+
+			//
+			// Slabs are never returned individually; HeapDestroy releases them at unload
+			//
+			auto& bin = tc->Bins[cls];
+			for (size_t i = blocks; i-- > 0;)
+			{
+				auto block = reinterpret_cast<FreeBlock*>(slab + i * stride);
+				block->Next = bin.Head;
+				bin.Head = block;
+			}
+			bin.Count += static_cast<uint32_t>(blocks);
+
+			return true;
+		}
+	};
+
+	SlabAllocator g_Allocator;
+
+	thread_local ThreadCache* t_Cache = nullptr;
+
+	// Set once the thread's cache was handed back; later calls on the exiting
+	// thread (other TLS destructors, CRT teardown) must not pick up a new one
+	thread_local bool t_CacheReleased = false;
+
+	// HydraHookMemoryTagCount means "not set"; callers supply their own default
+	thread_local HYDRAHOOK_MEMORY_TAG t_Tag = HydraHookMemoryTagCount;
+
+	/**
+	 * @brief Hands the thread cache back for reuse when its thread exits.
+	 */
+	struct ThreadCacheOwner
+	{
+		ThreadCache* Cache = nullptr;
+
+		~ThreadCacheOwner()
+		{
+			//
+			// Detach first: once released the cache may be recycled by another thread
+			//
+			t_Cache = nullptr;
+			t_CacheReleased = true;
+
+			if (Cache && !g_Allocator.IsTornDown())
+			{
+				g_Allocator.ReleaseCache(Cache);
+			}
+		}
+	};
+
+	thread_local ThreadCacheOwner t_CacheOwner;
+
+	ThreadCache* GetThreadCache() noexcept
+	{
+		if (t_Cache || t_CacheReleased)
+		{
+			return t_Cache;
+		}
+
+		const auto tc = g_Allocator.AcquireCache();
+		if (tc)
+		{
+			t_CacheOwner.Cache = tc;
+			t_Cache = tc;
+		}
+
+		return tc;
+	}
+}
+
+void* HydraHook::Core::Memory::Allocate(size_t size, HYDRAHOOK_MEMORY_TAG tag) noexcept
+{
+	const auto tc = g_Allocator.IsTornDown() ? nullptr : GetThreadCache();
+
+	if (size > kMaxSmallSize || !tc)
+	{
+		const auto ptr = g_Allocator.AllocateLarge(size);
+		if (ptr)
+		{
+			const auto hdr = static_cast<BlockHeader*>(ptr) - 1;
+			hdr->Tag = static_cast<uint16_t>(tag);
+
+			if (tc)
+			{
+				Charge(tc, tag, BlockBytes(hdr));
+			}
+			else
+			{
+				g_Allocator.ChargeUntracked(tag, BlockBytes(hdr));
+			}
+		}
+		return ptr;
+	}
+
+	const uint32_t cls = SizeToClass(size);
+	auto& bin = tc->Bins[cls];
+
+	if (!bin.Head && !g_Allocator.Refill(tc, cls))
+	{
+		return nullptr;
+	}
+
+	FreeBlock* block = bin.Head;
+	bin.Head = block->Next;
+	bin.Count--;
+
+	const auto hdr = reinterpret_cast<BlockHeader*>(block);
+	hdr->SizeClass = static_cast<uint16_t>(cls);
+	hdr->Tag = static_cast<uint16_t>(tag);
+	hdr->Magic = kMagicSmall;
+	hdr->Size = size;
+
+	Charge(tc, tag, static_cast<int64_t>(ClassToSize(cls)));
+
+	return hdr + 1;
+}
+
+void* HydraHook::Core::Memory::AllocateZeroed(size_t size, HYDRAHOOK_MEMORY_TAG tag) noexcept
+{
+	void* ptr = Allocate(size, tag);
+
+	if (ptr)
+	{
+		ZeroMemory(ptr, size);
+	}
+
+	return ptr;
+}
+
+void HydraHook::Core::Memory::Free(void* ptr) noexcept
+{
+	if (!ptr)
+	{
+		return;
+	}
+
+	const auto hdr = static_cast<BlockHeader*>(ptr) - 1;
+
+	//
+	// Slab and private heap memory is gone once the heap was destroyed
+	//
+	if (g_Allocator.IsTornDown())
+	{
+		if (hdr->Magic == kMagicProcessHeap)
+		{
+			HeapFree(GetProcessHeap(), 0, hdr);
+		}
+		return;
+	}
+
+	const auto tc = GetThreadCache();
+
+	if (hdr->Tag < HydraHookMemoryTagCount)
+	{
+		if (tc)
+		{
+			Charge(tc, hdr->Tag, -BlockBytes(hdr));
+		}
+		else
+		{
+			g_Allocator.ChargeUntracked(hdr->Tag, -BlockBytes(hdr));
+		}
+	}
+
+	switch (hdr->Magic)
+	{
+	case kMagicSmall:
+		{
+			if (!tc)
+			{
+				g_Allocator.FreeCentral(hdr);
+				return;
+			}
+
+			const uint32_t cls = hdr->SizeClass;
+			auto& bin = tc->Bins[cls];
+			const auto block = reinterpret_cast<FreeBlock*>(hdr);
+
+			block->Next = bin.Head;
+			bin.Head = block;
+
+			if (++bin.Count > 2 * BatchCount(cls))
+			{
+				g_Allocator.Drain(tc, cls);
+			}
+		}
+		break;
+	case kMagicLarge:
+		g_Allocator.FreeLarge(hdr);
+		break;
+	case kMagicProcessHeap:
+		HeapFree(GetProcessHeap(), 0, hdr);
+		break;
+	default:
+		// Not ours; leak rather than corrupt a foreign heap
+		break;
+	}
+}
+
+void HydraHook::Core::Memory::QueryUsage(HYDRAHOOK_MEMORY_TAG tag, size_t* current, size_t* peak) noexcept
+{
+	g_Allocator.QueryUsage(tag, current, peak);
+}
+
+size_t HydraHook::Core::Memory::HeapBytes() noexcept
+{
+	return g_Allocator.HeapBytes();
+}
+
+HYDRAHOOK_MEMORY_TAG HydraHook::Core::Memory::ThreadTag(HYDRAHOOK_MEMORY_TAG fallback) noexcept
+{
+	return t_Tag < HydraHookMemoryTagCount ? t_Tag : fallback;
+}
+
+HYDRAHOOK_MEMORY_TAG HydraHook::Core::Memory::SetThreadTag(HYDRAHOOK_MEMORY_TAG tag) noexcept
+{
+	const auto previous = t_Tag;
+	t_Tag = tag < HydraHookMemoryTagCount ? tag : HydraHookMemoryTagCount;
+	return previous;
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API PVOID HydraHookAlloc(size_t Size)
+{
+	using namespace HydraHook::Core::Memory;
+
+	return Allocate(Size, ThreadTag(HydraHookMemoryTagHost));
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API PVOID HydraHookAllocTagged(HYDRAHOOK_MEMORY_TAG Tag, size_t Size)
+{
+	if (Tag < 0 || Tag >= HydraHookMemoryTagCount)
+	{
+		return nullptr;
+	}
+
+	return HydraHook::Core::Memory::Allocate(Size, Tag);
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API HYDRAHOOK_MEMORY_TAG HydraHookSetThreadMemoryTag(HYDRAHOOK_MEMORY_TAG Tag)
+{
+	return HydraHook::Core::Memory::SetThreadTag(Tag);
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API VOID HydraHookFree(PVOID Memory)
+{
+	HydraHook::Core::Memory::Free(Memory);
+}
+
+#if defined(HYDRAHOOK_DYNAMIC) && !defined(HYDRAHOOK_NO_OPERATOR_NEW)
+
+//
+// Route all C++ allocations made inside the engine DLL (spdlog, STL
+// containers, hook bookkeeping) through the private allocator. Scoped to
+// this module since the CRT is linked statically. Unlike the host-facing
+// HYDRAHOOK_DEFINE_OPERATOR_NEW(), untagged allocations are charged to
+// the engine rather than the host.
+//
+namespace
+{
+	FORCEINLINE void* EngineOperatorNew(size_t size) noexcept
+	{
+		using namespace HydraHook::Core::Memory;
+
+		return Allocate(size, ThreadTag(HydraHookMemoryTagEngine));
+	}
+}
+
+void* operator new(size_t size)
+{
+	void* p = EngineOperatorNew(size);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	void* p = EngineOperatorNew(size);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return EngineOperatorNew(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return EngineOperatorNew(size); }
+void operator delete(void* p) noexcept { HydraHook::Core::Memory::Free(p); }
+void operator delete[](void* p) noexcept { HydraHook::Core::Memory::Free(p); }
+void operator delete(void* p, size_t) noexcept { HydraHook::Core::Memory::Free(p); }
+void operator delete[](void* p, size_t) noexcept { HydraHook::Core::Memory::Free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { HydraHook::Core::Memory::Free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { HydraHook::Core::Memory::Free(p); }
+
+#endif
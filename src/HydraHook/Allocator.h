@@ -0,0 +1,127 @@
+/**
+ * @file Allocator.h
+ * @brief Private thread-caching allocator for engine-internal allocations.
+ *
+ * Small requests are served from per-thread size-class free lists backed by
+ * slabs carved from a private Win32 heap, so engine and host callback
+ * allocations on the render thread do not contend with the game's use of
+ * the process heap. Not part of the public API; hosts use HydraHookAlloc
+ * and HydraHookFree.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+/*
+MIT License
+
+Copyright (c) 2018-2026 Benjamin Höglinger-Stelzer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "HydraHook/Engine/HydraHookCore.h"
+
+#include <cstddef>
+
+namespace HydraHook
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            /**
+             * @brief Allocates at least @p size bytes (16-byte aligned on x64).
+             *
+             * Requests up to 32 KiB are served from the calling thread's
+             * size-class cache; larger requests go straight to the private heap.
+             * A zero-byte request returns a unique, freeable pointer.
+             *
+             * @param size Requested size in bytes.
+             * @param tag Accounting tag charged for the block.
+             * @return Pointer to the block, or nullptr on exhaustion.
+             */
+            void* Allocate(size_t size, HYDRAHOOK_MEMORY_TAG tag = HydraHookMemoryTagEngine) noexcept;
+
+            /**
+             * @brief Allocates and zero-fills at least @p size bytes.
+             * @param size Requested size in bytes.
+             * @param tag Accounting tag charged for the block.
+             * @return Pointer to the zeroed block, or nullptr on exhaustion.
+             */
+            void* AllocateZeroed(size_t size, HYDRAHOOK_MEMORY_TAG tag = HydraHookMemoryTagEngine) noexcept;
+
+            /**
+             * @brief Returns a block obtained from Allocate to the allocator.
+             *
+             * May be called from any thread; the block is cached on the
+             * freeing thread. nullptr is ignored.
+             *
+             * @param ptr Block to free, or nullptr.
+             */
+            void Free(void* ptr) noexcept;
+
+            /**
+             * @brief Sums the per-thread counters of a tag and updates its peak.
+             *
+             * Walks every thread cache; intended for the engine thread and stats
+             * queries, not for hot paths.
+             *
+             * @param tag Tag to query.
+             * @param current Receives bytes currently allocated under the tag.
+             * @param peak Receives the highest value observed by any query so far.
+             */
+            void QueryUsage(HYDRAHOOK_MEMORY_TAG tag, size_t* current, size_t* peak) noexcept;
+
+            /**
+             * @brief Bytes the allocator currently holds from the OS (slabs and large blocks).
+             */
+            size_t HeapBytes() noexcept;
+
+            /**
+             * @brief Returns the calling thread's default tag, or @p fallback if none is set.
+             */
+            HYDRAHOOK_MEMORY_TAG ThreadTag(HYDRAHOOK_MEMORY_TAG fallback) noexcept;
+
+            /**
+             * @brief Sets the calling thread's default tag.
+             * @param tag New tag, or HydraHookMemoryTagCount to clear.
+             * @return Previous raw value (HydraHookMemoryTagCount if none was set).
+             */
+            HYDRAHOOK_MEMORY_TAG SetThreadTag(HYDRAHOOK_MEMORY_TAG tag) noexcept;
+
+            /**
+             * @brief RAII helper charging untagged allocations on this thread to a tag.
+             */
+            class TagScope
+            {
+                HYDRAHOOK_MEMORY_TAG m_Previous;
+
+            public:
+                explicit TagScope(HYDRAHOOK_MEMORY_TAG tag) noexcept : m_Previous(SetThreadTag(tag)) {}
+                ~TagScope() { SetThreadTag(m_Previous); }
+
+                TagScope(const TagScope&) = delete;
+                TagScope& operator=(const TagScope&) = delete;
+            };
+        }
+    }
+}
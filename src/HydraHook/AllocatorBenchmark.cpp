@@ -0,0 +1,256 @@
+/**
+ * @file AllocatorBenchmark.cpp
+ * @brief Opt-in multi-threaded benchmark of the private allocator against the CRT heap.
+ *
+ * Each thread keeps a window of live blocks and replaces a pseudo-randomly
+ * chosen one per iteration, so frees are out of order like in real code.
+ * The "handoff" pattern frees every block on the neighbouring thread,
+ * which exercises the central lists (private allocator) and the heap lock
+ * (CRT). Threads start together on a barrier; ns/op is the per-thread
+ * wall time divided by the iteration count, averaged (and maxed) over
+ * threads.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#ifdef HYDRAHOOK_ALLOCATOR_BENCHMARK
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+//
+// Internal
+// 
+#include "Allocator.h"
+#include "AllocatorBenchmark.h"
+
+//
+// STL
+// 
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//
+// Logging
+//
+#include <spdlog/spdlog.h>
+
+static constexpr size_t kWindow = 256;
+
+static volatile LONG g_Ready;
+static volatile LONG g_Go;
+
+struct HeapDesc
+{
+	const char* name;
+	void* (*alloc)(size_t);
+	void (*free)(void*);
+};
+
+static void* PrivateAlloc(size_t size) { return HydraHook::Core::Memory::Allocate(size); }
+static void PrivateFree(void* ptr) { HydraHook::Core::Memory::Free(ptr); }
+static void* CrtAlloc(size_t size) { return malloc(size); }
+static void CrtFree(void* ptr) { free(ptr); }
+
+/**
+ * @brief Size mix: mostly small engine-style objects, a few up to the small-block limit.
+ */
+static __forceinline size_t NextSize(uint32_t& state, size_t maxSize)
+{
+	state = state * 1664525u + 1013904223u;
+	const size_t size = (state >> 8) & 0x3FF;
+	return ((state & 0xF) == 0 ? size * 32 : size) % maxSize + 1;
+}
+
+/**
+ * @brief Single-producer, single-consumer block ring between neighbouring threads.
+ */
+struct alignas(64) Handoff
+{
+	static constexpr size_t kSize = 4096;
+
+	void* Slots[kSize];
+	alignas(64) std::atomic<size_t> Head{ 0 };
+	alignas(64) std::atomic<size_t> Tail{ 0 };
+
+	bool Push(void* ptr)
+	{
+		const size_t head = Head.load(std::memory_order_relaxed);
+		if (head - Tail.load(std::memory_order_acquire) == kSize)
+			return false;
+		Slots[head % kSize] = ptr;
+		Head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	void* Pop()
+	{
+		const size_t tail = Tail.load(std::memory_order_relaxed);
+		if (tail == Head.load(std::memory_order_acquire))
+			return nullptr;
+		void* ptr = Slots[tail % kSize];
+		Tail.store(tail + 1, std::memory_order_release);
+		return ptr;
+	}
+};
+
+static void WaitForStart(LONG threads)
+{
+	InterlockedIncrement(&g_Ready);
+	while (g_Ready < threads)
+		YieldProcessor();
+	while (!g_Go)
+		YieldProcessor();
+}
+
+static double ElapsedNs(const LARGE_INTEGER& start, ULONG iterations)
+{
+	LARGE_INTEGER freq, end;
+	QueryPerformanceCounter(&end);
+	QueryPerformanceFrequency(&freq);
+	return static_cast<double>(end.QuadPart - start.QuadPart) * 1e9 /
+		static_cast<double>(freq.QuadPart) / static_cast<double>(iterations);
+}
+
+static void RunLocal(const HeapDesc* heap, size_t maxSize, ULONG iterations, LONG index, LONG threads,
+                     Handoff* handoffs, double* nsPerOp)
+{
+	UNREFERENCED_PARAMETER(handoffs);
+
+	void* live[kWindow] = {};
+	uint32_t state = 0x9E3779B9u * static_cast<uint32_t>(index + 1);
+
+	WaitForStart(threads);
+
+	LARGE_INTEGER start;
+	QueryPerformanceCounter(&start);
+	for (ULONG i = 0; i < iterations; i++)
+	{
+		const size_t slot = (state >> 4) % kWindow;
+		heap->free(live[slot]);
+		live[slot] = heap->alloc(NextSize(state, maxSize));
+	}
+	*nsPerOp = ElapsedNs(start, iterations);
+
+	for (void* ptr : live)
+		heap->free(ptr);
+}
+
+static void RunHandoff(const HeapDesc* heap, size_t maxSize, ULONG iterations, LONG index, LONG threads,
+                       Handoff* handoffs, double* nsPerOp)
+{
+	Handoff& out = handoffs[(index + 1) % threads];
+	Handoff& in = handoffs[index];
+	uint32_t state = 0x9E3779B9u * static_cast<uint32_t>(index + 1);
+
+	WaitForStart(threads);
+
+	LARGE_INTEGER start;
+	QueryPerformanceCounter(&start);
+	for (ULONG i = 0; i < iterations; i++)
+	{
+		//
+		// A full ring means the neighbour is behind; free locally rather than wait
+		// 
+		void* ptr = heap->alloc(NextSize(state, maxSize));
+		if (!out.Push(ptr))
+			heap->free(ptr);
+
+		if (void* received = in.Pop())
+			heap->free(received);
+	}
+	*nsPerOp = ElapsedNs(start, iterations);
+}
+
+struct PatternDesc
+{
+	const char* name;
+	void (*run)(const HeapDesc*, size_t, ULONG, LONG, LONG, Handoff*, double*);
+	size_t maxSize;
+};
+
+static void Measure(const PatternDesc& pattern, const HeapDesc& heap, LONG threads, ULONG iterations,
+                    const std::shared_ptr<spdlog::logger>& logger)
+{
+	std::vector<double> results(threads);
+	std::vector<std::thread> workers;
+	std::unique_ptr<Handoff[]> handoffs(new Handoff[threads]);
+
+	g_Ready = 0;
+	g_Go = 0;
+
+	for (LONG t = 0; t < threads; t++)
+	{
+		workers.emplace_back(pattern.run, &heap, pattern.maxSize, iterations, t, threads, handoffs.get(), &results[t]);
+	}
+
+	while (g_Ready < threads)
+		SwitchToThread();
+	InterlockedExchange(&g_Go, 1);
+
+	for (auto& worker : workers)
+		worker.join();
+
+	//
+	// Blocks still in flight between threads
+	// 
+	for (LONG t = 0; t < threads; t++)
+	{
+		while (void* ptr = handoffs[t].Pop())
+			heap.free(ptr);
+	}
+
+	double sum = 0, max = 0;
+	for (const double ns : results)
+	{
+		sum += ns;
+		if (ns > max)
+			max = ns;
+	}
+
+	logger->info(
+		"allocator-benchmark {{\"pattern\":\"{}\",\"heap\":\"{}\",\"threads\":{},\"iterations\":{},\"ns_per_op\":{:.3f},\"ns_per_op_max\":{:.3f}}}",
+		pattern.name, heap.name, threads, iterations, sum / threads, max);
+}
+
+void HydraHookRunAllocatorBenchmark()
+{
+	auto logger = spdlog::get("HYDRAHOOK")->clone("benchmark");
+
+	const HeapDesc heaps[] =
+	{
+		{ "hydrahook", PrivateAlloc, PrivateFree },
+		{ "crt", CrtAlloc, CrtFree },
+	};
+
+	const PatternDesc patterns[] =
+	{
+		{ "local_small", RunLocal, 1024 },
+		{ "local_mixed", RunLocal, 32 * 1024 },
+		{ "handoff_small", RunHandoff, 1024 },
+	};
+
+	const ULONG iterations = HYDRAHOOK_ALLOCATOR_BENCHMARK_ITERATIONS;
+
+	logger->info("Running allocator benchmark ({} iterations per thread, {} hardware threads)",
+	             iterations, std::thread::hardware_concurrency());
+
+	for (const auto& pattern : patterns)
+	{
+		for (const auto& heap : heaps)
+		{
+			for (LONG threads = 1; threads <= 16; threads *= 2)
+			{
+				Measure(pattern, heap, threads, iterations, logger);
+			}
+		}
+	}
+
+	logger->info("Allocator benchmark finished");
+}
+
+#endif
@@ -0,0 +1,32 @@
+/**
+ * @file AllocatorBenchmark.h
+ * @brief Opt-in multi-threaded benchmark of the private allocator against the CRT heap.
+ *
+ * Compiled only with HYDRAHOOK_ALLOCATOR_BENCHMARK defined. Runs the same
+ * allocation patterns through HydraHook::Core::Memory and through
+ * malloc/free under 1-16 contending threads and logs one JSON object per
+ * result.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#pragma once
+
+#ifdef HYDRAHOOK_ALLOCATOR_BENCHMARK
+
+/**
+ * @brief Allocate/free pairs each thread runs per pattern.
+ */
+#ifndef HYDRAHOOK_ALLOCATOR_BENCHMARK_ITERATIONS
+#define HYDRAHOOK_ALLOCATOR_BENCHMARK_ITERATIONS 1000000
+#endif
+
+/**
+ * @brief Runs all patterns and logs the results as "allocator-benchmark {json}" lines.
+ *
+ * Runs on the engine worker thread; does not touch engine state.
+ */
+void HydraHookRunAllocatorBenchmark();
+
+#endif
@@ -0,0 +1,279 @@
+/**
+ * @file DispatchBenchmark.cpp
+ * @brief Opt-in micro-benchmark of the hook dispatch path.
+ *
+ * Each stage reproduces one piece of a hook lambda (activity guard,
+ * call_once, extension init, INVOKE_* dispatch, indirect call_orig) using
+ * the real engine types, so numbers track the shipped code. Threads start
+ * together on a barrier; ns/call is the per-thread wall time divided by
+ * the iteration count, averaged (and maxed) over threads.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#if defined(HYDRAHOOK_DISPATCH_BENCHMARK) && !defined(HYDRAHOOK_NO_D3D11)
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <Utils/Hook.h>
+
+//
+// Public
+// 
+#include "HydraHook/Engine/HydraHookCore.h"
+#include "HydraHook/Engine/HydraHookDirect3D9.h"
+#include "HydraHook/Engine/HydraHookDirect3D10.h"
+#include "HydraHook/Engine/HydraHookDirect3D11.h"
+#include "HydraHook/Engine/HydraHookDirect3D12.h"
+#include "HydraHook/Engine/HydraHookCoreAudio.h"
+
+//
+// Internal
+// 
+#include "Engine.h"
+#include "Allocator.h"
+#include "DispatchBenchmark.h"
+
+//
+// STL
+// 
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// Logging
+//
+#include <spdlog/spdlog.h>
+
+static volatile LONG64 g_Sink;
+
+static volatile LONG g_Ready;
+static volatile LONG g_Go;
+
+static PHYDRAHOOK_ENGINE g_Plain;    // callback registered, no budget
+static PHYDRAHOOK_ENGINE g_Budgeted; // callback registered, budget timing active
+
+typedef convention<CallConvention::stdcall_t, HRESULT, IDXGISwapChain*, UINT, UINT>::type PresentType;
+
+static volatile size_t g_Original;
+
+static __declspec(noinline) HRESULT __stdcall OriginalPresent(IDXGISwapChain* chain, UINT SyncInterval, UINT Flags)
+{
+	UNREFERENCED_PARAMETER(chain);
+	return static_cast<HRESULT>(SyncInterval + Flags);
+}
+
+static __declspec(noinline) void NoopPrePresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags,
+                                                PHYDRAHOOK_EVT_PRE_EXTENSION Extension)
+{
+	UNREFERENCED_PARAMETER(pSwapChain);
+	UNREFERENCED_PARAMETER(Flags);
+	UNREFERENCED_PARAMETER(Extension);
+	g_Sink = SyncInterval;
+}
+
+//
+// Stages; each performs exactly one simulated call
+// 
+
+static __forceinline void StageBaseline(PHYDRAHOOK_ENGINE engine, ULONG i)
+{
+	UNREFERENCED_PARAMETER(engine);
+	g_Sink = i;
+}
+
+static __forceinline void StageGuard(PHYDRAHOOK_ENGINE engine, ULONG i)
+{
+	UNREFERENCED_PARAMETER(engine);
+	HookActivityTracker::Guard guard;
+	g_Sink = guard.invoke + i;
+}
+
+static __forceinline void StageCallOnce(PHYDRAHOOK_ENGINE engine, ULONG i)
+{
+	UNREFERENCED_PARAMETER(engine);
+	static std::once_flag flag;
+	std::call_once(flag, []() { g_Sink = 0; });
+	g_Sink = i;
+}
+
+static __forceinline void StageExtensionInit(PHYDRAHOOK_ENGINE engine, ULONG i)
+{
+	HYDRAHOOK_EVT_PRE_EXTENSION pre;
+	HYDRAHOOK_EVT_PRE_EXTENSION_INIT(&pre, engine, engine->CustomContext);
+	g_Sink = reinterpret_cast<LONG64>(pre.Context) + i;
+}
+
+static __forceinline void StageInvoke(PHYDRAHOOK_ENGINE engine, ULONG i)
+{
+	HYDRAHOOK_EVT_PRE_EXTENSION pre;
+	HYDRAHOOK_EVT_PRE_EXTENSION_INIT(&pre, engine, engine->CustomContext);
+	INVOKE_D3D11_CALLBACK(engine, EvtHydraHookD3D11PrePresent, nullptr, i, 0, &pre);
+}
+
+static __forceinline void StageCallOrig(PHYDRAHOOK_ENGINE engine, ULONG i)
+{
+	UNREFERENCED_PARAMETER(engine);
+	g_Sink = PresentType(g_Original)(nullptr, i, 0);
+}
+
+static __forceinline void StageFull(PHYDRAHOOK_ENGINE engine, ULONG i)
+{
+	HookActivityTracker::Guard guard;
+
+	if (guard.invoke)
+	{
+		static std::once_flag flag;
+		std::call_once(flag, []() { g_Sink = 0; });
+
+		HYDRAHOOK_EVT_PRE_EXTENSION pre;
+		HYDRAHOOK_EVT_PRE_EXTENSION_INIT(&pre, engine, engine->CustomContext);
+		INVOKE_D3D11_CALLBACK(engine, EvtHydraHookD3D11PrePresent, nullptr, i, 0, &pre);
+	}
+
+	g_Sink = PresentType(g_Original)(nullptr, i, 0);
+}
+
+template <void Stage(PHYDRAHOOK_ENGINE, ULONG)>
+static void RunStage(PHYDRAHOOK_ENGINE engine, ULONG iterations, LONG threads, double* nsPerCall)
+{
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+
+	//
+	// Wait until every worker is spinning, then release them together
+	// 
+	InterlockedIncrement(&g_Ready);
+	while (g_Ready < threads)
+		YieldProcessor();
+	while (!g_Go)
+		YieldProcessor();
+
+	QueryPerformanceCounter(&start);
+	for (ULONG i = 0; i < iterations; i++)
+	{
+		Stage(engine, i);
+	}
+	QueryPerformanceCounter(&end);
+
+	*nsPerCall = static_cast<double>(end.QuadPart - start.QuadPart) * 1e9 /
+		static_cast<double>(freq.QuadPart) / static_cast<double>(iterations);
+}
+
+struct StageDesc
+{
+	const char* name;
+	void (*run)(PHYDRAHOOK_ENGINE, ULONG, LONG, double*);
+	PHYDRAHOOK_ENGINE* engine;
+};
+
+static void Measure(const StageDesc& stage, LONG threads, ULONG iterations,
+                    const std::shared_ptr<spdlog::logger>& logger)
+{
+	std::vector<double> results(threads);
+	std::vector<std::thread> workers;
+
+	g_Ready = 0;
+	g_Go = 0;
+
+	for (LONG t = 0; t < threads; t++)
+	{
+		workers.emplace_back(stage.run, *stage.engine, iterations, threads, &results[t]);
+	}
+
+	while (g_Ready < threads)
+		SwitchToThread();
+	InterlockedExchange(&g_Go, 1);
+
+	for (auto& worker : workers)
+		worker.join();
+
+	double sum = 0, max = 0;
+	for (const double ns : results)
+	{
+		sum += ns;
+		if (ns > max)
+			max = ns;
+	}
+
+	logger->info(
+		"dispatch-benchmark {{\"stage\":\"{}\",\"threads\":{},\"iterations\":{},\"ns_per_call\":{:.3f},\"ns_per_call_max\":{:.3f}}}",
+		stage.name, threads, iterations, sum / threads, max);
+}
+
+static PHYDRAHOOK_ENGINE CreateScratchEngine(LONGLONG budgetTicks)
+{
+	const auto engine = static_cast<PHYDRAHOOK_ENGINE>(
+		HydraHook::Core::Memory::AllocateZeroed(sizeof(HYDRAHOOK_ENGINE)));
+	if (!engine)
+		return nullptr;
+
+	HYDRAHOOK_D3D11_EVENT_CALLBACKS_INIT(&engine->EventsD3D11);
+	engine->EventsD3D11.EvtHydraHookD3D11PrePresent = NoopPrePresent;
+
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	engine->CallbackBudget.TicksPerSecond = freq.QuadPart;
+	engine->CallbackBudget.BudgetTicks = budgetTicks;
+
+	return engine;
+}
+
+void HydraHookRunDispatchBenchmark()
+{
+	auto logger = spdlog::get("HYDRAHOOK")->clone("benchmark");
+
+	g_Original = reinterpret_cast<size_t>(&OriginalPresent);
+
+	//
+	// A budget of one hour never overruns or throttles, so only the timing cost is measured
+	// 
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	g_Plain = CreateScratchEngine(0);
+	g_Budgeted = CreateScratchEngine(freq.QuadPart * 3600);
+
+	if (!g_Plain || !g_Budgeted)
+	{
+		logger->error("Failed to allocate scratch engines, skipping dispatch benchmark");
+		HydraHook::Core::Memory::Free(g_Plain);
+		HydraHook::Core::Memory::Free(g_Budgeted);
+		return;
+	}
+
+	const StageDesc stages[] =
+	{
+		{ "baseline", RunStage<StageBaseline>, &g_Plain },
+		{ "guard", RunStage<StageGuard>, &g_Plain },
+		{ "call_once", RunStage<StageCallOnce>, &g_Plain },
+		{ "pre_extension_init", RunStage<StageExtensionInit>, &g_Plain },
+		{ "invoke", RunStage<StageInvoke>, &g_Plain },
+		{ "invoke_budgeted", RunStage<StageInvoke>, &g_Budgeted },
+		{ "call_orig", RunStage<StageCallOrig>, &g_Plain },
+		{ "full", RunStage<StageFull>, &g_Plain },
+	};
+
+	const ULONG iterations = HYDRAHOOK_DISPATCH_BENCHMARK_ITERATIONS;
+
+	logger->info("Running dispatch benchmark ({} iterations per thread, {} hardware threads)",
+	             iterations, std::thread::hardware_concurrency());
+
+	for (const auto& stage : stages)
+	{
+		for (LONG threads = 1; threads <= 16; threads *= 2)
+		{
+			Measure(stage, threads, iterations, logger);
+		}
+	}
+
+	logger->info("Dispatch benchmark finished");
+
+	HydraHook::Core::Memory::Free(g_Plain);
+	HydraHook::Core::Memory::Free(g_Budgeted);
+	g_Plain = g_Budgeted = nullptr;
+}
+
+#endif
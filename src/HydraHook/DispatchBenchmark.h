@@ -0,0 +1,33 @@
+/**
+ * @file DispatchBenchmark.h
+ * @brief Opt-in micro-benchmark of the hook dispatch path.
+ *
+ * Compiled only with HYDRAHOOK_DISPATCH_BENCHMARK defined (and D3D11 support
+ * enabled, whose callback table it dispatches through). Measures the
+ * building blocks every hook lambda executes, in isolation and under
+ * 1-16 contending threads, and logs one JSON object per result.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#pragma once
+
+#if defined(HYDRAHOOK_DISPATCH_BENCHMARK) && !defined(HYDRAHOOK_NO_D3D11)
+
+/**
+ * @brief Iterations each thread runs per stage.
+ */
+#ifndef HYDRAHOOK_DISPATCH_BENCHMARK_ITERATIONS
+#define HYDRAHOOK_DISPATCH_BENCHMARK_ITERATIONS 1000000
+#endif
+
+/**
+ * @brief Runs all stages and logs the results as "dispatch-benchmark {json}" lines.
+ *
+ * Must run on the engine worker thread before any hook is applied, since
+ * it exercises the global HookActivityTracker counter.
+ */
+void HydraHookRunDispatchBenchmark();
+
+#endif
@@ -51,11 +51,13 @@ SOFTWARE.
 // Internal
 // 
 #include "Engine.h"
+#include "Allocator.h"
 #include "CrashHandler.h"
 #include "Game/Game.h"
 #include "Game/Shutdown.h"
 #include "Utils/Global.h"
 #include "LdrLock.h"
+#include "SwapChainSimulation.h"
 
 //
 // Logging
@@ -63,6 +65,7 @@ SOFTWARE.
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include "RotatingLogSink.h"
 
 //
 // STL
@@ -113,7 +116,7 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineCreate(HMODULE HostInstance, PHYDRA
 		return HYDRAHOOK_ERROR_GET_MODULE_HANDLE_FAILED;
 	}
 
-	const auto engine = static_cast<PHYDRAHOOK_ENGINE>(malloc(sizeof(HYDRAHOOK_ENGINE)));
+	const auto engine = static_cast<PHYDRAHOOK_ENGINE>(HydraHook::Core::Memory::Allocate(sizeof(HYDRAHOOK_ENGINE)));
 
 	if (!engine)
 	{
@@ -128,8 +131,24 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineCreate(HMODULE HostInstance, PHYDRA
 	engine->DllModule = hMod;
 	engine->ShutdownCleanupDone.store(false);
 	engine->FreeLibraryHookActive.store(false);
+	InitializeSRWLock(&engine->Memory.Lock);
+	InitializeSRWLock(&engine->ThreadContexts.Lock);
+	engine->ThreadContexts.Generation.store(0);
 	CopyMemory(&engine->EngineConfig, EngineConfig, sizeof(HYDRAHOOK_ENGINE_CONFIG));	
 
+	//
+	// Convert the callback CPU budget to QPC ticks once so the hot path stays integer-only
+	// 
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	engine->CallbackBudget.TicksPerSecond = frequency.QuadPart;
+	engine->CallbackBudget.BudgetTicks =
+		static_cast<LONGLONG>(EngineConfig->CallbackBudget.BudgetMicroseconds) * frequency.QuadPart / 1000000;
+	engine->CallbackBudget.Invocations.store(0);
+	engine->CallbackBudget.Overruns.store(0);
+	engine->CallbackBudget.Skipped.store(0);
+	engine->CallbackBudget.PeakTicks.store(0);
+
 	//
 	// Set up logging: try process directory first, then DLL directory, then %TEMP%
 	//
@@ -137,11 +156,26 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineCreate(HMODULE HostInstance, PHYDRA
 	std::string dllDir = HydraHook::Core::Util::get_module_directory(HostInstance);
 	std::string tempPath = HydraHook::Core::Util::expand_environment_variables(EngineConfig->Logging.FilePath);
 
-	auto tryCreateLogger = [](const std::string& path) -> bool
+	auto tryCreateLogger = [EngineConfig](const std::string& path) -> bool
 	{
+		HydraHook::Core::Memory::TagScope tag(HydraHookMemoryTagLogging);
+
 		try
 		{
-			(void)spdlog::basic_logger_mt("HYDRAHOOK", path);
+			if (!EngineConfig->Logging.MaxFileSize)
+			{
+				(void)spdlog::basic_logger_mt("HYDRAHOOK", path);
+				return true;
+			}
+
+			auto sink = std::make_shared<HydraHook::Core::Logging::RotatingCompressedSink>(
+				path,
+				EngineConfig->Logging.MaxFileSize,
+				EngineConfig->Logging.MaxFiles,
+				EngineConfig->Logging.Compress != FALSE
+			);
+
+			spdlog::initialize_logger(std::make_shared<spdlog::logger>("HYDRAHOOK", std::move(sink)));
 			return true;
 		}
 		catch (const std::exception&)
@@ -163,13 +197,15 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineCreate(HMODULE HostInstance, PHYDRA
 	auto logger = spdlog::get("HYDRAHOOK");
 	if (!logger)
 	{
+		HydraHook::Core::Memory::TagScope tag(HydraHookMemoryTagLogging);
+
 		try
 		{
 			logger = spdlog::stdout_color_mt("HYDRAHOOK");
 		}
 		catch (const std::exception&)
 		{
-			free(engine);
+			HydraHook::Core::Memory::Free(engine);
 			return HYDRAHOOK_ERROR_CREATE_LOGGER_FAILED;
 		}
 	}
@@ -178,7 +214,11 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineCreate(HMODULE HostInstance, PHYDRA
 	spdlog::set_level(spdlog::level::debug);
 	logger->flush_on(spdlog::level::debug);
 #else
-	logger->flush_on(spdlog::level::info);
+	//
+	// Lines are buffered and flushed by the engine thread once per second;
+	// warnings and errors still reach the disk right away
+	// 
+	logger->flush_on(spdlog::level::warn);
 #endif
 
 	if (EngineConfig->Logging.IsEnabled)
@@ -216,7 +256,7 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineCreate(HMODULE HostInstance, PHYDRA
 			HydraHookCrashHandlerUninstall(engine);
 			engine->CrashHandlerInstalled = FALSE;
 		}
-		free(engine);
+		HydraHook::Core::Memory::Free(engine);
 		return HYDRAHOOK_ERROR_CREATE_EVENT_FAILED;
 	}
 
@@ -243,7 +283,7 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineCreate(HMODULE HostInstance, PHYDRA
 			engine->CrashHandlerInstalled = FALSE;
 		}
 		CloseHandle(engine->EngineCancellationEvent);
-		free(engine);
+		HydraHook::Core::Memory::Free(engine);
 		return HYDRAHOOK_ERROR_CREATE_THREAD_FAILED;
 	}
 
@@ -282,12 +322,24 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineDestroy(HMODULE HostInstance)
 	CloseHandle(engine->EngineCancellationEvent);
 	CloseHandle(engine->EngineThread);
 
+	(void)HydraHookEngineFreeThreadContexts(engine);
+
 	g_EngineHostInstances.erase(HostInstance);
-	free(engine);
+	HydraHook::Core::Memory::Free(engine);
 
 	logger->info("Engine shutdown complete");
 	logger->flush();
 
+	//
+	// Unregister the logger with the last engine so the registry releases the
+	// sink (closing the file) and a later HydraHookEngineCreate can register it again
+	// 
+	if (g_EngineHostInstances.empty())
+	{
+		HydraHook::Core::Logging::StopArchiving(logger);
+		spdlog::drop("HYDRAHOOK");
+	}
+
 	return HYDRAHOOK_ERROR_NONE;
 }
 
@@ -304,7 +356,7 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineAllocCustomContext(PHYDRAHOOK_ENGIN
 		HydraHookEngineFreeCustomContext(Engine);
 	}
 
-	Engine->CustomContext = malloc(ContextSize);
+	Engine->CustomContext = HydraHook::Core::Memory::Allocate(ContextSize, HydraHookMemoryTagContext);
 
 	if (!Engine->CustomContext)
 	{
@@ -326,7 +378,7 @@ HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineFreeCustomContext(PHYDRAHOOK_ENGINE
 
 	if (Engine->CustomContext)
 	{
-		free(Engine->CustomContext);
+		HydraHook::Core::Memory::Free(Engine->CustomContext);
 		Engine->CustomContext = NULL;
 	}
 
@@ -343,6 +395,73 @@ HYDRAHOOK_API PVOID HydraHookEngineGetCustomContext(PHYDRAHOOK_ENGINE Engine)
 	return Engine->CustomContext;
 }
 
+/**
+ * @brief Converts QPC ticks to microseconds using the engine's cached frequency.
+ */
+static LONGLONG TicksToMicroseconds(PHYDRAHOOK_ENGINE Engine, LONGLONG Ticks)
+{
+	return Ticks * 1000000 / Engine->CallbackBudget.TicksPerSecond;
+}
+
+HYDRAHOOK_API LONG HydraHookEngineGetCallbackBudgetRemaining(PHYDRAHOOK_ENGINE Engine)
+{
+	if (!Engine || !Engine->CallbackBudget.BudgetTicks)
+	{
+		return MAXLONG;
+	}
+
+	const auto current = CallbackBudgetScope::s_current;
+	if (!current || current->engine != Engine)
+	{
+		return static_cast<LONG>(TicksToMicroseconds(Engine, Engine->CallbackBudget.BudgetTicks));
+	}
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	const LONGLONG remaining = Engine->CallbackBudget.BudgetTicks - (now.QuadPart - current->start);
+
+	return static_cast<LONG>(TicksToMicroseconds(Engine, remaining));
+}
+
+HYDRAHOOK_API BOOL HydraHookEngineShouldDegrade(PHYDRAHOOK_ENGINE Engine)
+{
+	if (!Engine || !Engine->CallbackBudget.BudgetTicks)
+	{
+		return FALSE;
+	}
+
+	const auto current = CallbackBudgetScope::s_current;
+	if (!current || current->engine != Engine)
+	{
+		return FALSE;
+	}
+
+	return current->site->averageTicks.load(std::memory_order_relaxed) > Engine->CallbackBudget.BudgetTicks;
+}
+
+HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineGetCallbackBudgetStats(PHYDRAHOOK_ENGINE Engine,
+                                                                    PHYDRAHOOK_CALLBACK_BUDGET_STATS Stats)
+{
+	if (!Engine)
+	{
+		return HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Stats)
+	{
+		return HYDRAHOOK_ERROR_INVALID_PARAMETER;
+	}
+
+	Stats->Invocations = Engine->CallbackBudget.Invocations.load(std::memory_order_relaxed);
+	Stats->Overruns = Engine->CallbackBudget.Overruns.load(std::memory_order_relaxed);
+	Stats->Skipped = Engine->CallbackBudget.Skipped.load(std::memory_order_relaxed);
+	Stats->PeakMicroseconds = static_cast<ULONG>(
+		TicksToMicroseconds(Engine, Engine->CallbackBudget.PeakTicks.load(std::memory_order_relaxed)));
+
+	return HYDRAHOOK_ERROR_NONE;
+}
+
 #ifndef HYDRAHOOK_NO_D3D9
 
 HYDRAHOOK_API VOID HydraHookEngineSetD3D9EventCallbacks(PHYDRAHOOK_ENGINE Engine,
@@ -394,6 +513,10 @@ HYDRAHOOK_API VOID HydraHookEngineSetD3D10EventCallbacks(PHYDRAHOOK_ENGINE Engin
 	if (Engine)
 	{
 		Engine->EventsD3D10 = *Callbacks;
+
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+		HydraHookSwapChainSimulationInterpose(Engine);
+#endif
 	}
 }
 
@@ -407,6 +530,10 @@ HYDRAHOOK_API VOID HydraHookEngineSetD3D11EventCallbacks(PHYDRAHOOK_ENGINE Engin
 	if (Engine)
 	{
 		Engine->EventsD3D11 = *Callbacks;
+
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+		HydraHookSwapChainSimulationInterpose(Engine);
+#endif
 	}
 }
 
@@ -428,6 +555,10 @@ HYDRAHOOK_API VOID HydraHookEngineSetD3D12EventCallbacks(PHYDRAHOOK_ENGINE Engin
 	if (Engine)
 	{
 		Engine->EventsD3D12 = *Callbacks;
+
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+		HydraHookSwapChainSimulationInterpose(Engine);
+#endif
 	}
 }
 
@@ -71,8 +71,46 @@ typedef struct _HYDRAHOOK_ENGINE
         IAudioRenderClient *pARC;        /**< Core Audio render client. */
     } CoreAudio;
 
+    struct
+    {
+        SRWLOCK Lock;                                              /**< Guards Budgets against concurrent host updates. */
+        HYDRAHOOK_MEMORY_BUDGET Budgets[HydraHookMemoryTagCount];  /**< Per-tag budgets (zero = unlimited). */
+        BOOL WarningRaised[HydraHookMemoryTagCount];               /**< Engine thread only; warning edge state. */
+        BOOL BudgetExceeded[HydraHookMemoryTagCount];              /**< Engine thread only; overrun edge state for logging. */
+    } Memory;
+
+    struct
+    {
+        LONGLONG BudgetTicks;                 /**< Per-invocation budget in QPC ticks; 0 = disabled. */
+        LONGLONG TicksPerSecond;              /**< QueryPerformanceFrequency result. */
+        std::atomic<uint64_t> Invocations;    /**< Timed invocations. */
+        std::atomic<uint64_t> Overruns;       /**< Invocations exceeding BudgetTicks. */
+        std::atomic<uint64_t> Skipped;        /**< Invocations dropped by throttling. */
+        std::atomic<int64_t> PeakTicks;       /**< Longest single invocation. */
+    } CallbackBudget;
+
+    struct
+    {
+        SRWLOCK Lock;                         /**< Guards the slot list. */
+        size_t SlotSize;                      /**< Slot size rounded to whole cache lines; 0 = not configured. */
+        std::atomic<uint32_t> Generation;     /**< Process-unique; changes whenever slots are replaced or freed. */
+        struct _HYDRAHOOK_THREAD_CONTEXT_SLOT* Slots; /**< Singly linked list of all slots. */
+    } ThreadContexts;
+
 } HYDRAHOOK_ENGINE;
 
+/**
+ * @brief Throttle decision of the last per-frame pre callback on this thread.
+ *
+ * Cleared for the lifetime of every HookActivityTracker::Guard and restored
+ * when it ends, set by the pre callback's CallbackBudgetScope and consumed by
+ * the post callback of the same call. Hooks nest on shared methods (a D3D12
+ * Present passes through the D3D10 Present detour), so an inner guard must
+ * not discard the outer call's pending decision.
+ */
+enum class CallbackBudgetPendingPre : uint8_t { None, Invoked, Skipped };
+inline thread_local CallbackBudgetPendingPre t_CallbackBudgetPendingPre = CallbackBudgetPendingPre::None;
+
 /**
  * @brief Lock-free tracker for in-flight hook lambda invocations.
  *
@@ -96,15 +134,19 @@ struct HookActivityTracker
     struct Guard
     {
         bool invoke;
+        CallbackBudgetPendingPre savedPendingPre;
 
         Guard() noexcept
         {
             s_active.fetch_add(1, std::memory_order_seq_cst);
             invoke = !s_shutting_down.load(std::memory_order_seq_cst);
+            savedPendingPre = t_CallbackBudgetPendingPre;
+            t_CallbackBudgetPendingPre = CallbackBudgetPendingPre::None;
         }
 
         ~Guard() noexcept
         {
+            t_CallbackBudgetPendingPre = savedPendingPre;
             s_active.fetch_sub(1, std::memory_order_seq_cst);
         }
 
@@ -141,6 +183,185 @@ struct HookActivityTracker
     }
 };
 
+/**
+ * @brief How a callback site takes part in budget throttling.
+ */
+enum class CallbackBudgetRole
+{
+    Pre,        /**< Per-frame pre callback; throttled on its own. */
+    Post,       /**< Per-frame post callback; follows the pre callback of the same call. */
+    Untimed     /**< Resize/reset; always invoked, never throttled. */
+};
+
+/**
+ * @brief Classifies a callback by its table field name at compile time.
+ *
+ * Resize and reset callbacks must run unconditionally: a skipped
+ * PreResizeBuffers would leave the host's back-buffer references alive
+ * and make the game's ResizeBuffers fail.
+ */
+constexpr CallbackBudgetRole CallbackBudgetRoleOf(const char* name) noexcept
+{
+    bool post = false;
+    for (const char* p = name; *p; ++p)
+    {
+        const auto starts = [p](const char* word)
+        {
+            for (const char* q = p; *word; ++q, ++word)
+                if (*q != *word)
+                    return false;
+            return true;
+        };
+        if (starts("Resize") || starts("Reset"))
+            return CallbackBudgetRole::Untimed;
+        if (starts("Post"))
+            post = true;
+    }
+    return post ? CallbackBudgetRole::Post : CallbackBudgetRole::Pre;
+}
+
+static_assert(CallbackBudgetRoleOf("EvtHydraHookD3D11PrePresent") == CallbackBudgetRole::Pre, "role table");
+static_assert(CallbackBudgetRoleOf("EvtHydraHookD3D9PostEndScene") == CallbackBudgetRole::Post, "role table");
+static_assert(CallbackBudgetRoleOf("EvtHydraHookD3D12PostResizeBuffers") == CallbackBudgetRole::Untimed, "role table");
+static_assert(CallbackBudgetRoleOf("EvtHydraHookD3D9PreResetEx") == CallbackBudgetRole::Untimed, "role table");
+
+/**
+ * @brief Per-call-site timing state for callback CPU budget enforcement.
+ *
+ * One instance lives as a function-local static inside each INVOKE_*_CALLBACK
+ * expansion, so every hook/callback pair is averaged and throttled on its own.
+ */
+struct CallbackBudgetSite
+{
+    std::atomic<int64_t> averageTicks{0};  /**< Exponential moving average (alpha 1/8). */
+    std::atomic<uint32_t> interval{1};     /**< Invoke every Nth call; 1 = not throttled. */
+    std::atomic<uint32_t> counter{0};      /**< Calls seen while throttled. */
+};
+
+/**
+ * @brief RAII scope wrapped around every host callback invocation.
+ *
+ * Mirrors HookActivityTracker::Guard: the @c invoke flag tells the caller
+ * whether to run the callback. With no budget configured the cost is a
+ * single load. Otherwise the callback is timed with QueryPerformanceCounter,
+ * the site average and engine counters are updated on exit, and with
+ * AutoThrottle the site interval doubles while the average is over budget
+ * and halves again once it drops below half the budget.
+ *
+ * Only per-frame callbacks (Present, EndScene, ARC buffers) are timed and
+ * throttled. A post callback is skipped exactly when the pre callback of
+ * the same hooked call was, so hosts never see one half of a pair; a post
+ * callback without a registered pre callback throttles on its own.
+ */
+struct CallbackBudgetScope
+{
+    struct Active
+    {
+        PHYDRAHOOK_ENGINE engine;
+        CallbackBudgetSite* site;
+        LONGLONG start;
+    };
+
+    /** @brief Innermost timed callback on this thread; read by the budget query API. */
+    static inline thread_local const Active* s_current = nullptr;
+
+    bool invoke = true;
+    Active active;
+    const Active* previous = nullptr;
+
+    CallbackBudgetScope(PHYDRAHOOK_ENGINE engine, CallbackBudgetSite& site, CallbackBudgetRole role) noexcept
+        : active{ engine, &site, 0 }
+    {
+        if (!engine->CallbackBudget.BudgetTicks || role == CallbackBudgetRole::Untimed)
+        {
+            active.engine = nullptr;
+            return;
+        }
+
+        if (role == CallbackBudgetRole::Post && t_CallbackBudgetPendingPre != CallbackBudgetPendingPre::None)
+        {
+            const bool skipped = t_CallbackBudgetPendingPre == CallbackBudgetPendingPre::Skipped;
+            t_CallbackBudgetPendingPre = CallbackBudgetPendingPre::None;
+
+            if (skipped)
+            {
+                invoke = false;
+                active.engine = nullptr;
+                engine->CallbackBudget.Skipped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        else if (const uint32_t n = site.interval.load(std::memory_order_relaxed); n > 1)
+        {
+            const uint32_t c = site.counter.load(std::memory_order_relaxed);
+            site.counter.store(c + 1, std::memory_order_relaxed);
+
+            if (c % n)
+            {
+                invoke = false;
+                active.engine = nullptr;
+                engine->CallbackBudget.Skipped.fetch_add(1, std::memory_order_relaxed);
+                if (role == CallbackBudgetRole::Pre)
+                    t_CallbackBudgetPendingPre = CallbackBudgetPendingPre::Skipped;
+                return;
+            }
+        }
+
+        if (role == CallbackBudgetRole::Pre)
+            t_CallbackBudgetPendingPre = CallbackBudgetPendingPre::Invoked;
+
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        active.start = now.QuadPart;
+
+        previous = s_current;
+        s_current = &active;
+    }
+
+    ~CallbackBudgetScope() noexcept
+    {
+        if (!active.engine)
+            return;
+
+        s_current = previous;
+
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        const int64_t elapsed = now.QuadPart - active.start;
+
+        auto& budget = active.engine->CallbackBudget;
+        auto& site = *active.site;
+
+        budget.Invocations.fetch_add(1, std::memory_order_relaxed);
+        if (elapsed > budget.BudgetTicks)
+            budget.Overruns.fetch_add(1, std::memory_order_relaxed);
+
+        int64_t peak = budget.PeakTicks.load(std::memory_order_relaxed);
+        while (elapsed > peak && !budget.PeakTicks.compare_exchange_weak(peak, elapsed, std::memory_order_relaxed))
+        {
+        }
+
+        const int64_t avg = site.averageTicks.load(std::memory_order_relaxed);
+        const int64_t next = avg + (elapsed - avg) / 8;
+        site.averageTicks.store(next, std::memory_order_relaxed);
+
+        const auto& config = active.engine->EngineConfig.CallbackBudget;
+        if (config.AutoThrottle)
+        {
+            const uint32_t n = site.interval.load(std::memory_order_relaxed);
+            const uint32_t limit = config.MaxThrottleInterval ? config.MaxThrottleInterval : 1;
+
+            if (next > budget.BudgetTicks && n < limit)
+                site.interval.store(n * 2 < limit ? n * 2 : limit, std::memory_order_relaxed);
+            else if (next < budget.BudgetTicks / 2 && n > 1)
+                site.interval.store(n / 2, std::memory_order_relaxed);
+        }
+    }
+
+    CallbackBudgetScope(const CallbackBudgetScope&) = delete;
+    CallbackBudgetScope& operator=(const CallbackBudgetScope&) = delete;
+};
+
 /** @brief Invokes EvtHydraHookGameHooked if non-NULL. */
 #define INVOKE_HYDRAHOOK_GAME_HOOKED(_engine_, _version_)    \
                                     ((_engine_)->EngineConfig.EvtHydraHookGameHooked ? \
@@ -151,33 +372,63 @@ struct HookActivityTracker
 #define INVOKE_D3D9_CALLBACK(_engine_, _callback_, ...)              \
     do {                                                             \
         const auto _pfn_ = (_engine_)->EventsD3D9._callback_;       \
-        if (_pfn_) _pfn_(##__VA_ARGS__);                             \
+        if (_pfn_) {                                                 \
+            static CallbackBudgetSite _site_;                        \
+            static constexpr CallbackBudgetRole _role_ =             \
+                CallbackBudgetRoleOf(#_callback_);                   \
+            CallbackBudgetScope _scope_(_engine_, _site_, _role_);   \
+            if (_scope_.invoke) _pfn_(##__VA_ARGS__);                \
+        }                                                            \
     } while(0)
 
 /** @brief Invokes D3D10 callback if registered. */
 #define INVOKE_D3D10_CALLBACK(_engine_, _callback_, ...)             \
     do {                                                             \
         const auto _pfn_ = (_engine_)->EventsD3D10._callback_;      \
-        if (_pfn_) _pfn_(##__VA_ARGS__);                             \
+        if (_pfn_) {                                                 \
+            static CallbackBudgetSite _site_;                        \
+            static constexpr CallbackBudgetRole _role_ =             \
+                CallbackBudgetRoleOf(#_callback_);                   \
+            CallbackBudgetScope _scope_(_engine_, _site_, _role_);   \
+            if (_scope_.invoke) _pfn_(##__VA_ARGS__);                \
+        }                                                            \
     } while(0)
 
 /** @brief Invokes D3D11 callback if registered. */
 #define INVOKE_D3D11_CALLBACK(_engine_, _callback_, ...)             \
     do {                                                             \
         const auto _pfn_ = (_engine_)->EventsD3D11._callback_;      \
-        if (_pfn_) _pfn_(##__VA_ARGS__);                             \
+        if (_pfn_) {                                                 \
+            static CallbackBudgetSite _site_;                        \
+            static constexpr CallbackBudgetRole _role_ =             \
+                CallbackBudgetRoleOf(#_callback_);                   \
+            CallbackBudgetScope _scope_(_engine_, _site_, _role_);   \
+            if (_scope_.invoke) _pfn_(##__VA_ARGS__);                \
+        }                                                            \
     } while(0)
 
 /** @brief Invokes D3D12 callback if registered. */
 #define INVOKE_D3D12_CALLBACK(_engine_, _callback_, ...)             \
     do {                                                             \
         const auto _pfn_ = (_engine_)->EventsD3D12._callback_;      \
-        if (_pfn_) _pfn_(##__VA_ARGS__);                             \
+        if (_pfn_) {                                                 \
+            static CallbackBudgetSite _site_;                        \
+            static constexpr CallbackBudgetRole _role_ =             \
+                CallbackBudgetRoleOf(#_callback_);                   \
+            CallbackBudgetScope _scope_(_engine_, _site_, _role_);   \
+            if (_scope_.invoke) _pfn_(##__VA_ARGS__);                \
+        }                                                            \
     } while(0)
 
 /** @brief Invokes Core Audio callback if registered. */
 #define INVOKE_ARC_CALLBACK(_engine_, _callback_, ...)               \
     do {                                                             \
         const auto _pfn_ = (_engine_)->EventsARC._callback_;        \
-        if (_pfn_) _pfn_(##__VA_ARGS__);                             \
+        if (_pfn_) {                                                 \
+            static CallbackBudgetSite _site_;                        \
+            static constexpr CallbackBudgetRole _role_ =             \
+                CallbackBudgetRoleOf(#_callback_);                   \
+            CallbackBudgetScope _scope_(_engine_, _site_, _role_);   \
+            if (_scope_.invoke) _pfn_(##__VA_ARGS__);                \
+        }                                                            \
     } while(0)
@@ -40,6 +40,7 @@ using namespace HydraHook::Core::Exceptions;
 #include <Game/Hook/Direct3D9.h>
 #include <Game/Hook/Direct3D9Ex.h>
 #include <Game/Hook/DXGI.h>
+#include <Game/SwapChain.h>
 #include <dxgi.h>
 #include <dxgi1_2.h>
 #include <dxgi1_4.h>
@@ -64,6 +65,12 @@ using namespace HydraHook::Core::Exceptions;
 // Internal
 // 
 #include "Engine.h"
+#include "MemoryBudget.h"
+#include "AllocatorBenchmark.h"
+#include "DispatchBenchmark.h"
+#include "SwapChainSimulation.h"
+#include "Recorder.h"
+#include "RotatingLogSink.h"
 
 //
 // STL
@@ -163,6 +170,11 @@ void PerformShutdownCleanup(PHYDRAHOOK_ENGINE engine, ShutdownOrigin origin)
 		engine->EngineConfig.EvtHydraHookGamePreExit(engine);
 	}
 
+	//
+	// The engine thread may never get to write out the rest (e.g. ExitProcess)
+	// 
+	HydraHookRecorderFlush();
+
 	const auto ret = SetEvent(engine->EngineCancellationEvent);
 	if (!ret)
 	{
@@ -248,6 +260,19 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 
 	logger->info("Library enabled");
 
+#if defined(HYDRAHOOK_DISPATCH_BENCHMARK) && !defined(HYDRAHOOK_NO_D3D11)
+	//
+	// Must run before any hook is live; it drives the shared activity counter
+	// 
+	HydraHookRunDispatchBenchmark();
+#endif
+
+#ifdef HYDRAHOOK_ALLOCATOR_BENCHMARK
+	HydraHookRunAllocatorBenchmark();
+#endif
+
+	HydraHookRecorderStart(engine);
+
 	// 
 	// D3D9 Hooks
 	// 
@@ -506,6 +531,7 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 		                   ) -> HRESULT
 			                   {
 				                   HookActivityTracker::Guard guard;
+				                   CallRecorder::Scope record(HydraHookRecordSiteD3D9Present);
 
 				                   if (guard.invoke)
 				                   {
@@ -541,6 +567,9 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 		                 ) -> HRESULT
 			                 {
 				                 HookActivityTracker::Guard guard;
+				                 CallRecorder::Scope record(HydraHookRecordSiteD3D9Reset,
+					                 pp ? pp->BackBufferWidth : 0, pp ? pp->BackBufferHeight : 0,
+					                 pp ? static_cast<uint32_t>(pp->Windowed) : 0);
 
 				                 if (guard.invoke)
 				                 {
@@ -571,6 +600,7 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 		                    ) -> HRESULT
 			                    {
 				                    HookActivityTracker::Guard guard;
+				                    CallRecorder::Scope record(HydraHookRecordSiteD3D9EndScene);
 
 				                    if (guard.invoke)
 				                    {
@@ -606,6 +636,7 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 		                     ) -> HRESULT
 			                     {
 				                     HookActivityTracker::Guard guard;
+				                     CallRecorder::Scope record(HydraHookRecordSiteD3D9PresentEx, a5);
 
 				                     if (guard.invoke)
 				                     {
@@ -645,6 +676,9 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 		                   ) -> HRESULT
 			                   {
 				                   HookActivityTracker::Guard guard;
+				                   CallRecorder::Scope record(HydraHookRecordSiteD3D9ResetEx,
+					                   pp ? pp->BackBufferWidth : 0, pp ? pp->BackBufferHeight : 0,
+					                   pp ? static_cast<uint32_t>(pp->Windowed) : 0);
 
 				                   if (guard.invoke)
 				                   {
@@ -699,8 +733,12 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 	{
 		try
 		{
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+			auto vtable = HydraHookSwapChainSimulationVtable();
+#else
 			const std::unique_ptr<Direct3D10Hooking::Direct3D10> d3d10(new Direct3D10Hooking::Direct3D10);
 			auto vtable = d3d10->vtable();
+#endif
 
 			logger->info("Hooking IDXGISwapChain::Present");
 
@@ -712,6 +750,14 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 			                             {
 				                             HookActivityTracker::Guard guard;
 
+				                             // deviceVersion is fixed by the first chain; D3D12 chains belong to the D3D12 hook
+				                             if (SwapChainHasDevice<ID3D12Device>(chain))
+				                             {
+				                             	return swapChainPresent10Hook.call_orig(chain, SyncInterval, Flags);
+				                             }
+
+				                             CallRecorder::Scope record(HydraHookRecordSiteD3D10Present, SyncInterval, Flags);
+
 				                             if (guard.invoke)
 				                             {
 					                             static std::once_flag flag;
@@ -806,6 +852,16 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 			                                  {
 				                                  HookActivityTracker::Guard guard;
 
+				                                  if (SwapChainHasDevice<ID3D12Device>(chain))
+				                                  {
+				                                  	return swapChainResizeTarget10Hook.call_orig(chain, pNewTargetParameters);
+				                                  }
+
+				                                  CallRecorder::Scope record(HydraHookRecordSiteD3D10ResizeTarget,
+					                                  pNewTargetParameters ? pNewTargetParameters->Width : 0,
+					                                  pNewTargetParameters ? pNewTargetParameters->Height : 0,
+					                                  pNewTargetParameters ? pNewTargetParameters->RefreshRate.Numerator : 0);
+
 				                                  if (guard.invoke)
 				                                  {
 					                                  static std::once_flag flag;
@@ -882,6 +938,14 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 			                                   {
 				                                   HookActivityTracker::Guard guard;
 
+				                                   if (SwapChainHasDevice<ID3D12Device>(chain))
+				                                   {
+				                                   	return swapChainResizeBuffers10Hook.call_orig(chain,
+				                                   		BufferCount, Width, Height, NewFormat, SwapChainFlags);
+				                                   }
+
+				                                   CallRecorder::Scope record(HydraHookRecordSiteD3D10ResizeBuffers, BufferCount, Width, Height);
+
 				                                   if (guard.invoke)
 				                                   {
 					                                   static std::once_flag flag;
@@ -965,8 +1029,12 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 	{
 		try
 		{
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+			auto vtable = HydraHookSwapChainSimulationVtable();
+#else
 			const std::unique_ptr<Direct3D11Hooking::Direct3D11> d3d11(new Direct3D11Hooking::Direct3D11);
 			auto vtable = d3d11->vtable();
+#endif
 			const size_t d3d11PresentAddress = vtable[DXGIHooking::Present];
 
 			if (dxgiPresent1Address == 0 && vtable.size() > static_cast<size_t>(
@@ -994,20 +1062,13 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 				                             {
 					                             HookActivityTracker::Guard guard;
 
-					                             ID3D11Device* pD11Device = nullptr;
-					                             if (FAILED(chain->GetDevice(IID_PPV_ARGS(&pD11Device))))
+					                             if (!SwapChainHasDevice<ID3D11Device>(chain))
 					                             {
-						                             if (pD11Device)
-						                             {
-							                             pD11Device->Release();
-						                             }
 						                             return swapChainPresent11Hook.
 							                             call_orig(chain, SyncInterval, Flags);
 					                             }
-					                             if (pD11Device)
-					                             {
-						                             pD11Device->Release();
-					                             }
+
+					                             CallRecorder::Scope record(HydraHookRecordSiteD3D11Present, SyncInterval, Flags);
 
 					                             if (guard.invoke)
 					                             {
@@ -1068,20 +1129,16 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 				                                  {
 					                                  HookActivityTracker::Guard guard;
 
-					                                  ID3D11Device* pD11Device = nullptr;
-					                                  if (FAILED(chain->GetDevice(IID_PPV_ARGS(&pD11Device))))
+					                                  if (!SwapChainHasDevice<ID3D11Device>(chain))
 					                                  {
-						                                  if (pD11Device)
-						                                  {
-							                                  pD11Device->Release();
-						                                  }
 						                                  return swapChainResizeTarget11Hook.call_orig(
 							                                  chain, pNewTargetParameters);
 					                                  }
-					                                  if (pD11Device)
-					                                  {
-						                                  pD11Device->Release();
-					                                  }
+
+					                                  CallRecorder::Scope record(HydraHookRecordSiteD3D11ResizeTarget,
+						                                  pNewTargetParameters ? pNewTargetParameters->Width : 0,
+						                                  pNewTargetParameters ? pNewTargetParameters->Height : 0,
+						                                  pNewTargetParameters ? pNewTargetParameters->RefreshRate.Numerator : 0);
 
 					                                  if (guard.invoke)
 					                                  {
@@ -1139,20 +1196,13 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 				                                   {
 					                                   HookActivityTracker::Guard guard;
 
-					                                   ID3D11Device* pD11Device = nullptr;
-					                                   if (FAILED(chain->GetDevice(IID_PPV_ARGS(&pD11Device))))
+					                                   if (!SwapChainHasDevice<ID3D11Device>(chain))
 					                                   {
-						                                   if (pD11Device)
-						                                   {
-							                                   pD11Device->Release();
-						                                   }
 						                                   return swapChainResizeBuffers11Hook.call_orig(chain,
 							                                   BufferCount, Width, Height, NewFormat, SwapChainFlags);
 					                                   }
-					                                   if (pD11Device)
-					                                   {
-						                                   pD11Device->Release();
-					                                   }
+
+					                                   CallRecorder::Scope record(HydraHookRecordSiteD3D11ResizeBuffers, BufferCount, Width, Height);
 
 					                                   if (guard.invoke)
 					                                   {
@@ -1292,11 +1342,16 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 				pFactory->Release();
 			}
 
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+			auto vtable = HydraHookSwapChainSimulationVtable();
+			void** pQueueVtbl = HydraHookSwapChainSimulationQueueVtable();
+#else
 			const std::unique_ptr<Direct3D12Hooking::Direct3D12> d3d12(new Direct3D12Hooking::Direct3D12);
 			auto vtable = d3d12->vtable();
 
 			// Hook ExecuteCommandLists to capture the game's queue at runtime (supports mid-process injection)
 			void** pQueueVtbl = d3d12->commandQueueVtable();
+#endif
 			if (pQueueVtbl)
 			{
 				constexpr int ExecuteCommandListsIndex = 10;
@@ -1339,19 +1394,12 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 			                             {
 				                             HookActivityTracker::Guard guard;
 
-				                             ID3D12Device* pD12Device = nullptr;
-				                             if (FAILED(chain->GetDevice(IID_PPV_ARGS(&pD12Device))))
+				                             if (!SwapChainHasDevice<ID3D12Device>(chain))
 				                             {
-					                             if (pD12Device)
-					                             {
-						                             pD12Device->Release();
-					                             }
 					                             return swapChainPresent12Hook.call_orig(chain, SyncInterval, Flags);
 				                             }
-				                             if (pD12Device)
-				                             {
-					                             pD12Device->Release();
-				                             }
+
+				                             CallRecorder::Scope record(HydraHookRecordSiteD3D12Present, SyncInterval, Flags);
 
 				                             if (guard.invoke)
 				                             {
@@ -1403,20 +1451,16 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 			                                  {
 				                                  HookActivityTracker::Guard guard;
 
-				                                  ID3D12Device* pD12Device = nullptr;
-				                                  if (FAILED(chain->GetDevice(IID_PPV_ARGS(&pD12Device))))
+				                                  if (!SwapChainHasDevice<ID3D12Device>(chain))
 				                                  {
-					                                  if (pD12Device)
-					                                  {
-						                                  pD12Device->Release();
-					                                  }
 					                                  return swapChainResizeTarget12Hook.call_orig(
 						                                  chain, pNewTargetParameters);
 				                                  }
-				                                  if (pD12Device)
-				                                  {
-					                                  pD12Device->Release();
-				                                  }
+
+				                                  CallRecorder::Scope record(HydraHookRecordSiteD3D12ResizeTarget,
+					                                  pNewTargetParameters ? pNewTargetParameters->Width : 0,
+					                                  pNewTargetParameters ? pNewTargetParameters->Height : 0,
+					                                  pNewTargetParameters ? pNewTargetParameters->RefreshRate.Numerator : 0);
 
 				                                  if (guard.invoke)
 				                                  {
@@ -1465,20 +1509,13 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 			                                   {
 				                                   HookActivityTracker::Guard guard;
 
-				                                   ID3D12Device* pD12Device = nullptr;
-				                                   if (FAILED(chain->GetDevice(IID_PPV_ARGS(&pD12Device))))
+				                                   if (!SwapChainHasDevice<ID3D12Device>(chain))
 				                                   {
-					                                   if (pD12Device)
-					                                   {
-						                                   pD12Device->Release();
-					                                   }
 					                                   return swapChainResizeBuffers12Hook.call_orig(chain,
 						                                   BufferCount, Width, Height, NewFormat, SwapChainFlags);
 				                                   }
-				                                   if (pD12Device)
-				                                   {
-					                                   pD12Device->Release();
-				                                   }
+
+				                                   CallRecorder::Scope record(HydraHookRecordSiteD3D12ResizeBuffers, BufferCount, Width, Height);
 
 				                                   if (guard.invoke)
 				                                   {
@@ -1550,14 +1587,12 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 			                            {
 				                            HookActivityTracker::Guard guard;
 
-				                            ID3D12Device* pD12Device = nullptr;
-				                            ID3D11Device* pD11Device = nullptr;
-				                            ID3D10Device* pD10Device = nullptr;
+				                            const auto version = ClassifySwapChain(chain);
 
-				                            if (SUCCEEDED(chain->GetDevice(IID_PPV_ARGS(&pD12Device))) && pD12Device)
-				                            {
-					                            pD12Device->Release();
+				                            CallRecorder::Scope record(HydraHookRecordSiteDXGIPresent1, SyncInterval, PresentFlags, version);
 
+				                            if (version == HydraHookDirect3DVersion12)
+				                            {
 					                            if (guard.invoke && engine->EngineConfig.Direct3D.HookDirect3D12)
 					                            {
 						                            static std::once_flag flag;
@@ -1598,10 +1633,8 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 						                            chain, SyncInterval, PresentFlags, pPresentParameters);
 				                            }
 
-				                            if (SUCCEEDED(chain->GetDevice(IID_PPV_ARGS(&pD11Device))) && pD11Device)
+				                            if (version == HydraHookDirect3DVersion11)
 				                            {
-					                            pD11Device->Release();
-
 					                            if (guard.invoke && engine->EngineConfig.Direct3D.HookDirect3D11)
 					                            {
 						                            static std::once_flag flag;
@@ -1642,10 +1675,8 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 						                            chain, SyncInterval, PresentFlags, pPresentParameters);
 				                            }
 
-				                            if (SUCCEEDED(chain->GetDevice(IID_PPV_ARGS(&pD10Device))) && pD10Device)
+				                            if (version == HydraHookDirect3DVersion10)
 				                            {
-					                            pD10Device->Release();
-
 					                            if (guard.invoke && engine->EngineConfig.Direct3D.HookDirect3D10)
 					                            {
 						                            static std::once_flag flag;
@@ -1698,15 +1729,12 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 			                                  {
 				                                  HookActivityTracker::Guard guard;
 
-				                                  ID3D12Device* pD12Device = nullptr;
-				                                  ID3D11Device* pD11Device = nullptr;
-				                                  ID3D10Device* pD10Device = nullptr;
+				                                  const auto version = ClassifySwapChain(chain);
 
-				                                  if (SUCCEEDED(chain->GetDevice(IID_PPV_ARGS(&pD12Device))) &&
-					                                  pD12Device)
-				                                  {
-					                                  pD12Device->Release();
+				                                  CallRecorder::Scope record(HydraHookRecordSiteDXGIResizeBuffers1, BufferCount, Width, Height);
 
+				                                  if (version == HydraHookDirect3DVersion12)
+				                                  {
 					                                  if (guard.invoke && engine->EngineConfig.Direct3D.HookDirect3D12)
 					                                  {
 						                                  static std::once_flag flag;
@@ -1746,11 +1774,8 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 						                                  pCreationNodeMask, ppPresentQueue);
 				                                  }
 
-				                                  if (SUCCEEDED(chain->GetDevice(IID_PPV_ARGS(&pD11Device))) &&
-					                                  pD11Device)
+				                                  if (version == HydraHookDirect3DVersion11)
 				                                  {
-					                                  pD11Device->Release();
-
 					                                  if (guard.invoke && engine->EngineConfig.Direct3D.HookDirect3D11)
 					                                  {
 						                                  static std::once_flag flag;
@@ -1790,11 +1815,8 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 						                                  pCreationNodeMask, ppPresentQueue);
 				                                  }
 
-				                                  if (SUCCEEDED(chain->GetDevice(IID_PPV_ARGS(&pD10Device))) &&
-					                                  pD10Device)
+				                                  if (version == HydraHookDirect3DVersion10)
 				                                  {
-					                                  pD10Device->Release();
-
 					                                  if (guard.invoke && engine->EngineConfig.Direct3D.HookDirect3D10)
 					                                  {
 						                                  static std::once_flag flag;
@@ -1857,6 +1879,7 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 		                       ) -> HRESULT
 			                       {
 				                       HookActivityTracker::Guard guard;
+				                       CallRecorder::Scope record(HydraHookRecordSiteARCGetBuffer, NumFramesRequested);
 
 				                       if (guard.invoke)
 				                       {
@@ -1899,6 +1922,7 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 		                           ) -> HRESULT
 			                           {
 				                           HookActivityTracker::Guard guard;
+				                           CallRecorder::Scope record(HydraHookRecordSiteARCReleaseBuffer, NumFramesWritten, dwFlags);
 
 				                           if (guard.invoke)
 				                           {
@@ -1982,10 +2006,23 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 
 	logger->info("Library initialized successfully");
 
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+	HydraHookSwapChainSimulationStart(engine);
+#endif
+
 	//
-	// Wait until cancellation requested
+	// Wait until cancellation requested, waking periodically to enforce memory budgets,
+	// write out recorded calls and flush buffered log lines
 	// 
-	const auto result = WaitForSingleObject(engine->EngineCancellationEvent, INFINITE);
+	DWORD result;
+	while ((result = WaitForSingleObject(engine->EngineCancellationEvent, HYDRAHOOK_MEMORY_BUDGET_INTERVAL_MS)) ==
+		WAIT_TIMEOUT)
+	{
+		HydraHookMemoryBudgetCheck(engine);
+		HydraHookRecorderFlush();
+		logger->flush();
+	}
+
 	logger->info("Shutting down hooks... (result: {}, error: {})", result, GetLastError());
 	switch (result)
 	{
@@ -2011,6 +2048,10 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 	HookActivityTracker::shutdown();
 	logger->info("Shutdown flag set, new hook invocations will skip callbacks");
 
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+	HydraHookSwapChainSimulationShutdownBegin();
+#endif
+
 	//
 	// Notify host that we are about to release all render pipeline hooks
 	// 
@@ -2076,11 +2117,16 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 	if (!HookActivityTracker::drain())
 	{
 		logger->error("Timed out waiting for in-flight callbacks to drain");
+
+		// Lambdas may still write to the ring, keep it allocated
+		HydraHookRecorderStop(false);
 	}
 	else
 	{
 		logger->info("All in-flight hook callbacks drained");
 
+		HydraHookRecorderStop(true);
+
 		ZeroMemory(&engine->EventsD3D9, sizeof(engine->EventsD3D9));
 		ZeroMemory(&engine->EventsD3D10, sizeof(engine->EventsD3D10));
 		ZeroMemory(&engine->EventsD3D11, sizeof(engine->EventsD3D11));
@@ -2088,6 +2134,10 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 		ZeroMemory(&engine->EventsARC, sizeof(engine->EventsARC));
 	}
 
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+	HydraHookSwapChainSimulationStop(engine);
+#endif
+
 	//
 	// Notify host that we released all render pipeline hooks
 	// 
@@ -2098,6 +2148,12 @@ DWORD WINAPI HydraHookMainThread(LPVOID Params)
 
 	logger->info("Exiting worker thread");
 
+	//
+	// The log archive thread holds a reference on this module; let it finish
+	// and release it, otherwise the FreeLibrary below never unloads us
+	// 
+	HydraHook::Core::Logging::StopArchiving(logger);
+
 	if (engine->FreeLibraryHookActive.load(std::memory_order_acquire))
 	{
 		ExitThread(0);
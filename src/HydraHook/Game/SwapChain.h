@@ -0,0 +1,72 @@
+/**
+ * @file SwapChain.h
+ * @brief Swap chain device classification shared by all DXGI hook lambdas.
+ *
+ * The Present/ResizeTarget/ResizeBuffers hooks of D3D10, D3D11 and D3D12
+ * share one IDXGISwapChain vtable, so every hook first asks the chain which
+ * device created it. Keeping that decision here, free of engine state,
+ * lets it be driven by mock swap chains outside a live game.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#pragma once
+
+#include "HydraHook/Engine/HydraHookCore.h"
+
+#include <dxgi.h>
+#include <d3d10.h>
+#include <d3d11.h>
+#include <d3d12.h>
+
+/**
+ * @brief Returns true if @p chain was created by a device implementing @p TDevice.
+ *
+ * The queried reference is released immediately; only the answer is kept.
+ *
+ * @tparam TDevice ID3D10Device, ID3D11Device or ID3D12Device.
+ * @param chain Swap chain passed to the hook.
+ */
+template <typename TDevice>
+bool SwapChainHasDevice(IDXGISwapChain* chain)
+{
+    TDevice* pDevice = nullptr;
+
+    if (FAILED(chain->GetDevice(IID_PPV_ARGS(&pDevice))) || !pDevice)
+    {
+        return false;
+    }
+
+    pDevice->Release();
+    return true;
+}
+
+/**
+ * @brief Determines which Direct3D version rendered into @p chain.
+ *
+ * Probes D3D12 first, then D3D11, then D3D10, matching the order the DXGI1+
+ * hooks dispatch in (an ID3D11Device may also answer for ID3D10Device).
+ *
+ * @param chain Swap chain passed to the hook.
+ * @return The detected version, or HydraHookDirect3DVersionUnknown.
+ */
+inline HYDRAHOOK_D3D_VERSION ClassifySwapChain(IDXGISwapChain* chain)
+{
+    if (SwapChainHasDevice<ID3D12Device>(chain))
+    {
+        return HydraHookDirect3DVersion12;
+    }
+
+    if (SwapChainHasDevice<ID3D11Device>(chain))
+    {
+        return HydraHookDirect3DVersion11;
+    }
+
+    if (SwapChainHasDevice<ID3D10Device>(chain))
+    {
+        return HydraHookDirect3DVersion10;
+    }
+
+    return HydraHookDirect3DVersionUnknown;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file MemoryBudget.cpp
+ * @brief Memory budget and statistics API, periodic budget enforcement.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "HydraHook/Engine/HydraHookCore.h"
+#include "HydraHook/Engine/HydraHookDirect3D9.h"
+#include "HydraHook/Engine/HydraHookDirect3D10.h"
+#include "HydraHook/Engine/HydraHookDirect3D11.h"
+#include "HydraHook/Engine/HydraHookDirect3D12.h"
+#include "HydraHook/Engine/HydraHookCoreAudio.h"
+#include "Engine.h"
+#include "Allocator.h"
+#include "MemoryBudget.h"
+
+#include <spdlog/spdlog.h>
+
+static const char* MemoryTagToString(HYDRAHOOK_MEMORY_TAG tag)
+{
+	switch (tag)
+	{
+	case HydraHookMemoryTagEngine:  return "Engine";
+	case HydraHookMemoryTagLogging: return "Logging";
+	case HydraHookMemoryTagContext: return "Context";
+	case HydraHookMemoryTagHost:    return "Host";
+	default:
+		return tag >= HydraHookMemoryTagHostUser0 && tag < HydraHookMemoryTagCount ? "HostUser" : "Reserved";
+	}
+}
+
+static bool IsValidMemoryTag(HYDRAHOOK_MEMORY_TAG tag)
+{
+	return tag >= 0 && tag < HydraHookMemoryTagCount;
+}
+
+void HydraHookMemoryBudgetCheck(PHYDRAHOOK_ENGINE engine)
+{
+	auto logger = spdlog::get("HYDRAHOOK")->clone("memory");
+
+	for (int i = 0; i < HydraHookMemoryTagCount; i++)
+	{
+		const auto tag = static_cast<HYDRAHOOK_MEMORY_TAG>(i);
+
+		//
+		// Always sample so peaks stay meaningful even without budgets
+		//
+		size_t current, peak;
+		HydraHook::Core::Memory::QueryUsage(tag, &current, &peak);
+
+		HYDRAHOOK_MEMORY_BUDGET budget;
+		AcquireSRWLockShared(&engine->Memory.Lock);
+		budget = engine->Memory.Budgets[i];
+		ReleaseSRWLockShared(&engine->Memory.Lock);
+
+		if (budget.WarningBytes)
+		{
+			if (current >= budget.WarningBytes && !engine->Memory.WarningRaised[i])
+			{
+				engine->Memory.WarningRaised[i] = TRUE;
+				logger->warn("Tag {} ({}) crossed warning threshold: {} of {} bytes",
+				             MemoryTagToString(tag), i, current, budget.WarningBytes);
+
+				if (budget.EvtMemoryBudgetWarning)
+				{
+					budget.EvtMemoryBudgetWarning(engine, tag, current, budget.BudgetBytes);
+				}
+			}
+			else if (current < budget.WarningBytes)
+			{
+				engine->Memory.WarningRaised[i] = FALSE;
+			}
+		}
+
+		if (budget.BudgetBytes && current > budget.BudgetBytes)
+		{
+			if (!engine->Memory.BudgetExceeded[i])
+			{
+				engine->Memory.BudgetExceeded[i] = TRUE;
+				logger->error("Tag {} ({}) exceeded its budget: {} of {} bytes",
+				              MemoryTagToString(tag), i, current, budget.BudgetBytes);
+			}
+
+			if (budget.EvtMemoryBudgetExceeded)
+			{
+				budget.EvtMemoryBudgetExceeded(engine, tag, current, budget.BudgetBytes);
+			}
+		}
+		else if (engine->Memory.BudgetExceeded[i])
+		{
+			engine->Memory.BudgetExceeded[i] = FALSE;
+			logger->info("Tag {} ({}) back within budget: {} bytes", MemoryTagToString(tag), i, current);
+		}
+	}
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineSetMemoryBudget(PHYDRAHOOK_ENGINE Engine, HYDRAHOOK_MEMORY_TAG Tag,
+                                                             const HYDRAHOOK_MEMORY_BUDGET* Budget)
+{
+	if (!Engine)
+	{
+		return HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!IsValidMemoryTag(Tag) || !Budget)
+	{
+		return HYDRAHOOK_ERROR_INVALID_PARAMETER;
+	}
+
+	AcquireSRWLockExclusive(&Engine->Memory.Lock);
+	Engine->Memory.Budgets[Tag] = *Budget;
+	ReleaseSRWLockExclusive(&Engine->Memory.Lock);
+
+	return HYDRAHOOK_ERROR_NONE;
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineGetMemoryStats(PHYDRAHOOK_ENGINE Engine, HYDRAHOOK_MEMORY_TAG Tag,
+                                                            PHYDRAHOOK_MEMORY_STATS Stats)
+{
+	if (!Engine)
+	{
+		return HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!IsValidMemoryTag(Tag) || !Stats)
+	{
+		return HYDRAHOOK_ERROR_INVALID_PARAMETER;
+	}
+
+	size_t current, peak;
+	HydraHook::Core::Memory::QueryUsage(Tag, &current, &peak);
+
+	AcquireSRWLockShared(&Engine->Memory.Lock);
+	Stats->BudgetBytes = Engine->Memory.Budgets[Tag].BudgetBytes;
+	ReleaseSRWLockShared(&Engine->Memory.Lock);
+
+	Stats->CurrentBytes = current;
+	Stats->PeakBytes = peak;
+	Stats->HeapBytes = HydraHook::Core::Memory::HeapBytes();
+
+	return HYDRAHOOK_ERROR_NONE;
+}
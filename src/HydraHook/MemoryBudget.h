@@ -0,0 +1,27 @@
+/**
+ * @file MemoryBudget.h
+ * @brief Per-tag memory budget enforcement for the engine thread.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#pragma once
+
+#include "HydraHook/Engine/HydraHookCore.h"
+
+/**
+ * @brief Interval at which the engine thread samples usage and checks budgets.
+ */
+#define HYDRAHOOK_MEMORY_BUDGET_INTERVAL_MS 1000
+
+/**
+ * @brief Samples all tags and fires warning/exceeded callbacks as configured.
+ *
+ * Must be called from the engine worker thread only; it owns the edge
+ * state used to fire warnings once per upward crossing. Also refreshes
+ * the peak values reported by HydraHookEngineGetMemoryStats.
+ *
+ * @param engine Engine whose budgets are checked.
+ */
+void HydraHookMemoryBudgetCheck(PHYDRAHOOK_ENGINE engine);
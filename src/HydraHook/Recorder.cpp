@@ -0,0 +1,199 @@
+/**
+ * @file Recorder.cpp
+ * @brief Recording file management and ring draining for CallRecorder.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "HydraHook/Engine/HydraHookCore.h"
+#include "HydraHook/Engine/HydraHookDirect3D9.h"
+#include "HydraHook/Engine/HydraHookDirect3D10.h"
+#include "HydraHook/Engine/HydraHookDirect3D11.h"
+#include "HydraHook/Engine/HydraHookDirect3D12.h"
+#include "HydraHook/Engine/HydraHookCoreAudio.h"
+#include "Engine.h"
+#include "Allocator.h"
+#include "Recorder.h"
+#include "Utils/Global.h"
+
+#include <spdlog/spdlog.h>
+
+static SRWLOCK g_RecorderLock = SRWLOCK_INIT;
+static HANDLE g_RecorderFile = INVALID_HANDLE_VALUE;
+
+//
+// Staging buffer so each flush becomes a single sequential write
+// 
+static HYDRAHOOK_RECORD* g_RecorderStaging = nullptr;
+
+static void DrainLocked()
+{
+	if (g_RecorderFile == INVALID_HANDLE_VALUE || !CallRecorder::s_slots)
+		return;
+
+	size_t count = 0;
+
+	const uint64_t dropped = CallRecorder::s_dropped.exchange(0, std::memory_order_relaxed);
+	if (dropped)
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+
+		auto& marker = g_RecorderStaging[count++];
+		ZeroMemory(&marker, sizeof(marker));
+		marker.Start = static_cast<uint64_t>(now.QuadPart - CallRecorder::s_base);
+		marker.ThreadId = GetCurrentThreadId();
+		marker.Site = HydraHookRecordSiteDropped;
+		marker.Args[0] = dropped > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(dropped);
+	}
+
+	uint64_t tail = CallRecorder::s_tail.load(std::memory_order_relaxed);
+
+	//
+	// One slot of the staging buffer is reserved for the drop marker
+	// 
+	while (count < HYDRAHOOK_RECORDER_CAPACITY + 1)
+	{
+		auto& slot = CallRecorder::s_slots[tail & (HYDRAHOOK_RECORDER_CAPACITY - 1)];
+		if (!slot.ready.load(std::memory_order_acquire))
+			break;
+
+		g_RecorderStaging[count++] = slot.record;
+		slot.ready.store(0, std::memory_order_relaxed);
+		tail++;
+	}
+
+	CallRecorder::s_tail.store(tail, std::memory_order_release);
+
+	if (!count)
+		return;
+
+	DWORD written = 0;
+	if (!WriteFile(g_RecorderFile, g_RecorderStaging, static_cast<DWORD>(count * sizeof(HYDRAHOOK_RECORD)),
+	               &written, nullptr))
+	{
+		spdlog::get("HYDRAHOOK")->clone("recorder")->error("WriteFile failed: {}, recording stopped", GetLastError());
+		CallRecorder::s_enabled.store(false, std::memory_order_relaxed);
+		CloseHandle(g_RecorderFile);
+		g_RecorderFile = INVALID_HANDLE_VALUE;
+	}
+}
+
+void HydraHookRecorderStart(PHYDRAHOOK_ENGINE engine)
+{
+	const auto& config = engine->EngineConfig.Recorder;
+
+	if (!config.IsEnabled || !config.FilePath)
+		return;
+
+	auto logger = spdlog::get("HYDRAHOOK")->clone("recorder");
+	const auto path = HydraHook::Core::Util::expand_environment_variables(config.FilePath);
+
+	AcquireSRWLockExclusive(&g_RecorderLock);
+
+	if (g_RecorderFile != INVALID_HANDLE_VALUE)
+	{
+		ReleaseSRWLockExclusive(&g_RecorderLock);
+		return;
+	}
+
+	if (!CallRecorder::s_slots)
+	{
+		CallRecorder::s_slots = static_cast<CallRecorder::Slot*>(HydraHook::Core::Memory::AllocateZeroed(
+			sizeof(CallRecorder::Slot) * HYDRAHOOK_RECORDER_CAPACITY));
+		g_RecorderStaging = static_cast<HYDRAHOOK_RECORD*>(HydraHook::Core::Memory::Allocate(
+			sizeof(HYDRAHOOK_RECORD) * (HYDRAHOOK_RECORDER_CAPACITY + 1)));
+	}
+
+	if (!CallRecorder::s_slots || !g_RecorderStaging)
+	{
+		ReleaseSRWLockExclusive(&g_RecorderLock);
+		logger->error("Failed to allocate recorder buffers, recording disabled");
+		return;
+	}
+
+	g_RecorderFile = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+	                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (g_RecorderFile == INVALID_HANDLE_VALUE)
+	{
+		ReleaseSRWLockExclusive(&g_RecorderLock);
+		logger->error("Failed to create recording {}: {}, recording disabled", path, GetLastError());
+		return;
+	}
+
+	LARGE_INTEGER frequency, now;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&now);
+
+	HYDRAHOOK_RECORD_FILE_HEADER header;
+	ZeroMemory(&header, sizeof(header));
+	header.Magic = HYDRAHOOK_RECORD_MAGIC;
+	header.Version = HYDRAHOOK_RECORD_VERSION;
+	header.RecordSize = sizeof(HYDRAHOOK_RECORD);
+	header.ProcessId = GetCurrentProcessId();
+	header.QpcFrequency = frequency.QuadPart;
+	header.QpcBase = now.QuadPart;
+
+	DWORD written = 0;
+	if (!WriteFile(g_RecorderFile, &header, sizeof(header), &written, nullptr))
+	{
+		CloseHandle(g_RecorderFile);
+		g_RecorderFile = INVALID_HANDLE_VALUE;
+		ReleaseSRWLockExclusive(&g_RecorderLock);
+		logger->error("Failed to write recording header: {}, recording disabled", GetLastError());
+		return;
+	}
+
+	CallRecorder::s_base = now.QuadPart;
+	CallRecorder::s_enabled.store(true, std::memory_order_release);
+
+	ReleaseSRWLockExclusive(&g_RecorderLock);
+
+	logger->info("Recording hooked calls to {}", path);
+}
+
+void HydraHookRecorderFlush()
+{
+	if (!CallRecorder::s_enabled.load(std::memory_order_relaxed))
+		return;
+
+	AcquireSRWLockExclusive(&g_RecorderLock);
+	DrainLocked();
+	ReleaseSRWLockExclusive(&g_RecorderLock);
+}
+
+void HydraHookRecorderStop(bool releaseBuffer)
+{
+	AcquireSRWLockExclusive(&g_RecorderLock);
+
+	CallRecorder::s_enabled.store(false, std::memory_order_relaxed);
+
+	if (g_RecorderFile != INVALID_HANDLE_VALUE)
+	{
+		DrainLocked();
+
+		if (g_RecorderFile != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(g_RecorderFile);
+			g_RecorderFile = INVALID_HANDLE_VALUE;
+		}
+	}
+
+	if (releaseBuffer)
+	{
+		HydraHook::Core::Memory::Free(CallRecorder::s_slots);
+		HydraHook::Core::Memory::Free(g_RecorderStaging);
+		CallRecorder::s_slots = nullptr;
+		g_RecorderStaging = nullptr;
+		CallRecorder::s_head.store(0, std::memory_order_relaxed);
+		CallRecorder::s_tail.store(0, std::memory_order_relaxed);
+		CallRecorder::s_dropped.store(0, std::memory_order_relaxed);
+	}
+
+	ReleaseSRWLockExclusive(&g_RecorderLock);
+}
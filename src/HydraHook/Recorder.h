@@ -0,0 +1,146 @@
+/**
+ * @file Recorder.h
+ * @brief Binary recorder of hooked calls (EngineConfig.Recorder).
+ *
+ * Hook lambdas place a CallRecorder::Scope next to their activity guard.
+ * While recording is off the scope costs one relaxed load. While on, it
+ * stamps the call with QueryPerformanceCounter and pushes a fixed-size
+ * record into a lock-free ring that the engine thread drains to disk in
+ * one sequential write per wake-up. Format: HydraHookRecord.h.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#pragma once
+
+#include "HydraHook/Engine/HydraHookCore.h"
+#include "HydraHook/Engine/HydraHookRecord.h"
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Ring capacity in records (2 MiB); must be a power of two.
+ *
+ * Sized for well over one second of calls at several thousand hooked
+ * calls per second, since the engine thread drains once per second.
+ */
+#define HYDRAHOOK_RECORDER_CAPACITY 65536
+
+/**
+ * @brief Process-wide multi-producer ring of pending records.
+ *
+ * Producers claim a slot by advancing the head with a CAS (only while the
+ * ring has room, so every claimed slot is eventually published) and
+ * publish it with a release store; the single consumer (engine thread,
+ * serialized by the flush lock) consumes published slots in order.
+ */
+struct CallRecorder
+{
+    struct Slot
+    {
+        std::atomic<uint32_t> ready;
+        HYDRAHOOK_RECORD record;
+    };
+
+    static inline std::atomic<bool> s_enabled{false};
+    static inline Slot* s_slots = nullptr;
+    static inline LONGLONG s_base = 0;
+    static inline std::atomic<uint64_t> s_head{0};
+    static inline std::atomic<uint64_t> s_tail{0};
+    static inline std::atomic<uint64_t> s_dropped{0};
+
+    /** @brief Queues one record, or counts it as dropped if the ring is full. */
+    static void push(const HYDRAHOOK_RECORD& record) noexcept
+    {
+        uint64_t head = s_head.load(std::memory_order_relaxed);
+
+        do
+        {
+            if (head - s_tail.load(std::memory_order_acquire) >= HYDRAHOOK_RECORDER_CAPACITY)
+            {
+                s_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        while (!s_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed));
+
+        auto& slot = s_slots[head & (HYDRAHOOK_RECORDER_CAPACITY - 1)];
+        slot.record = record;
+        slot.ready.store(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief RAII scope recording one hooked call from construction to destruction.
+     */
+    struct Scope
+    {
+        bool active;
+        LONGLONG start;
+        HYDRAHOOK_RECORD_SITE site;
+        uint32_t args[3];
+
+        explicit Scope(HYDRAHOOK_RECORD_SITE Site, uint32_t Arg0 = 0, uint32_t Arg1 = 0, uint32_t Arg2 = 0) noexcept
+            : active(s_enabled.load(std::memory_order_relaxed)), start(0), site(Site), args{ Arg0, Arg1, Arg2 }
+        {
+            if (!active)
+                return;
+
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            start = now.QuadPart;
+        }
+
+        ~Scope() noexcept
+        {
+            if (!active)
+                return;
+
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            const uint64_t elapsed = static_cast<uint64_t>(now.QuadPart - start);
+
+            HYDRAHOOK_RECORD record;
+            record.Start = static_cast<uint64_t>(start - s_base);
+            record.Duration = elapsed > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(elapsed);
+            record.ThreadId = GetCurrentThreadId();
+            record.Site = static_cast<uint16_t>(site);
+            record.Reserved = 0;
+            record.Args[0] = args[0];
+            record.Args[1] = args[1];
+            record.Args[2] = args[2];
+
+            push(record);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+/**
+ * @brief Opens the recording file and enables recording if configured.
+ *
+ * Called on the engine thread before any hook is applied. Failures are
+ * logged and leave recording disabled.
+ *
+ * @param engine Engine whose Recorder configuration is used.
+ */
+void HydraHookRecorderStart(PHYDRAHOOK_ENGINE engine);
+
+/**
+ * @brief Writes all published records to disk.
+ *
+ * Called periodically from the engine thread and once from shutdown
+ * cleanup; calls are serialized internally. No-op when not recording.
+ */
+void HydraHookRecorderFlush();
+
+/**
+ * @brief Disables recording, flushes and closes the file.
+ *
+ * @param releaseBuffer TRUE to free the ring; only safe once all hook
+ *                      lambdas have drained.
+ */
+void HydraHookRecorderStop(bool releaseBuffer);
@@ -0,0 +1,680 @@
+/**
+ * @file RotatingLogSink.cpp
+ * @brief Rotating log sink and the archive thread compressing rotated files.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "HydraHook/Engine/HydraHookCore.h"
+#include "Allocator.h"
+#include "RotatingLogSink.h"
+
+//
+// Logging
+//
+#include <spdlog/spdlog.h>
+#include <spdlog/details/file_helper.h>
+
+//
+// Compression
+//
+#include <zlib.h>
+
+//
+// STL
+//
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Length of the rotation timestamp (YYYYMMDD-HHMMSS-mmm).
+ */
+#define HYDRAHOOK_LOG_TIMESTAMP_LENGTH 19
+
+namespace HydraHook
+{
+	namespace Core
+	{
+		namespace Logging
+		{
+			/**
+			 * @brief Active log file, shared with the archive thread while it rotates it.
+			 *
+			 * The sink owns File except while Rotating is set; then the archive thread
+			 * closes, renames and reopens it and the sink keeps new lines in Pending.
+			 * Lock guards Rotating, Pending and Dropped.
+			 */
+			struct ActiveLogFile
+			{
+				explicit ActiveLogFile(std::string path)
+					: Path(std::move(path)),
+					  Buffer(new char[HYDRAHOOK_LOG_WRITE_BUFFER_SIZE]),
+					  File(MakeEventHandlers(Buffer.get()))
+				{
+				}
+
+				/**
+				 * @brief Closes the file, renames it to @p rotated and opens a fresh one.
+				 *
+				 * @return TRUE if the file was renamed.
+				 * @throws spdlog::spdlog_ex if the fresh file can not be opened.
+				 */
+				bool Rotate(const std::string& rotated)
+				{
+					File.close();
+
+					const bool moved = MoveFileExA(Path.c_str(), rotated.c_str(), MOVEFILE_REPLACE_EXISTING) != FALSE;
+
+					//
+					// If the file can't be renamed (e.g. opened without sharing by a viewer)
+					// it is truncated instead so the size cap still holds
+					//
+					File.open(Path, true);
+
+					return moved;
+				}
+
+				std::string Path;
+				std::unique_ptr<char[]> Buffer;    /**< Must outlive every FILE* of File. */
+				spdlog::details::file_helper File;
+
+				SRWLOCK Lock = SRWLOCK_INIT;
+				bool Rotating = false;
+				spdlog::memory_buf_t Pending;
+				uint64_t Dropped = 0;
+
+			private:
+				static spdlog::file_event_handlers MakeEventHandlers(char* buffer)
+				{
+					spdlog::file_event_handlers handlers;
+
+					//
+					// Full buffering turns per-line fwrite calls into large sequential writes
+					//
+					handlers.after_open = [buffer](const spdlog::filename_t&, std::FILE* file)
+					{
+						(void)setvbuf(file, buffer, _IOFBF, HYDRAHOOK_LOG_WRITE_BUFFER_SIZE);
+					};
+
+					return handlers;
+				}
+			};
+
+			/**
+			 * @brief Low-priority thread rotating the active file, compressing rotated
+			 *        files and pruning old ones.
+			 *
+			 * The thread holds a reference on the module containing this code and exits
+			 * via FreeLibraryAndExitThread once stopped and drained, so the sink never
+			 * waits for it (the logger may be destroyed under the loader lock). Until
+			 * Stop is called that reference keeps the module loaded, so the engine
+			 * thread stops it (StopArchiving) before it unloads the host.
+			 */
+			class ArchiveWorker
+			{
+			public:
+				ArchiveWorker(const std::string& path, uint32_t maxFiles, bool compress)
+					: m_MaxFiles(maxFiles), m_Compress(compress)
+				{
+					const auto slash = path.find_last_of("\\/");
+					const auto name = slash == std::string::npos ? 0 : slash + 1;
+					const auto dot = path.find_last_of('.');
+
+					m_Directory = path.substr(0, name);
+
+					if (dot == std::string::npos || dot < name)
+					{
+						m_Stem = path.substr(name);
+					}
+					else
+					{
+						m_Stem = path.substr(name, dot - name);
+						m_Extension = path.substr(dot);
+					}
+				}
+
+				static void Start(const std::shared_ptr<ArchiveWorker>& worker)
+				{
+					if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS,
+					                        reinterpret_cast<LPCSTR>(&ArchiveWorker::ThreadProc),
+					                        &worker->m_Module))
+					{
+						return;
+					}
+
+					const auto self = new std::shared_ptr<ArchiveWorker>(worker);
+					const HANDLE thread = CreateThread(nullptr, 0, ThreadProc, self, 0, nullptr);
+
+					if (!thread)
+					{
+						delete self;
+						FreeLibrary(worker->m_Module);
+						return;
+					}
+
+					CloseHandle(thread);
+					worker->m_Running = true;
+				}
+
+				/** @brief Full path a file rotated now is renamed to. */
+				std::string RotatedPath() const
+				{
+					SYSTEMTIME now;
+					GetLocalTime(&now);
+
+					char timestamp[HYDRAHOOK_LOG_TIMESTAMP_LENGTH + 1];
+					sprintf_s(timestamp, "%04u%02u%02u-%02u%02u%02u-%03u",
+					          now.wYear, now.wMonth, now.wDay, now.wHour, now.wMinute, now.wSecond,
+					          now.wMilliseconds);
+
+					return m_Directory + m_Stem + "." + timestamp + m_Extension;
+				}
+
+				/**
+				 * @brief Queues a rotated file (empty path = prune only).
+				 *
+				 * Without a running thread (or once stopped) the file stays
+				 * uncompressed and pruning happens inline.
+				 */
+				void Enqueue(std::string rotatedPath)
+				{
+					AcquireSRWLockExclusive(&m_Lock);
+
+					const bool queued = m_Running && !m_Stop;
+					if (queued)
+					{
+						m_Queue.push_back(std::move(rotatedPath));
+					}
+
+					ReleaseSRWLockExclusive(&m_Lock);
+
+					if (!queued)
+					{
+						Prune();
+						return;
+					}
+
+					WakeConditionVariable(&m_Wake);
+				}
+
+				/**
+				 * @brief Queues a rotation of @p active; the caller has set Rotating.
+				 *
+				 * @return FALSE without a running thread (or once stopped); the caller
+				 *         then rotates inline.
+				 */
+				bool EnqueueRotation(std::shared_ptr<ActiveLogFile> active)
+				{
+					AcquireSRWLockExclusive(&m_Lock);
+
+					const bool queued = m_Running && !m_Stop && !m_Rotation;
+					if (queued)
+					{
+						m_Rotation = std::move(active);
+					}
+
+					ReleaseSRWLockExclusive(&m_Lock);
+
+					if (queued)
+					{
+						WakeConditionVariable(&m_Wake);
+					}
+
+					return queued;
+				}
+
+				/** @brief Queues files an earlier session rotated but did not compress. */
+				void EnqueueLeftovers()
+				{
+					if (m_Compress)
+					{
+						EnumerateRotated([this](const std::string& key, bool compressed)
+						{
+							if (!compressed)
+								Enqueue(m_Directory + m_Stem + "." + key + m_Extension);
+						});
+					}
+
+					Enqueue({});
+				}
+
+				/** @brief Lets the thread exit once the queue is drained; does not wait. */
+				void Stop()
+				{
+					AcquireSRWLockExclusive(&m_Lock);
+					m_Stop = true;
+					ReleaseSRWLockExclusive(&m_Lock);
+
+					WakeConditionVariable(&m_Wake);
+				}
+
+			private:
+				static DWORD WINAPI ThreadProc(LPVOID Params)
+				{
+					auto self = static_cast<std::shared_ptr<ArchiveWorker>*>(Params);
+					const HMODULE module = (*self)->m_Module;
+
+					SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+					{
+						Memory::TagScope tag(HydraHookMemoryTagLogging);
+
+						(*self)->Run();
+						delete self;
+					}
+
+					FreeLibraryAndExitThread(module, 0);
+				}
+
+				void Run()
+				{
+					AcquireSRWLockExclusive(&m_Lock);
+
+					for (;;)
+					{
+						while (m_Queue.empty() && !m_Rotation && !m_Stop)
+						{
+							SleepConditionVariableSRW(&m_Wake, &m_Lock, INFINITE, 0);
+						}
+
+						std::string path;
+
+						if (m_Rotation)
+						{
+							const auto active = std::move(m_Rotation);
+
+							ReleaseSRWLockExclusive(&m_Lock);
+
+							path = Rotate(*active);
+						}
+						else if (!m_Queue.empty())
+						{
+							path = std::move(m_Queue.front());
+							m_Queue.pop_front();
+
+							ReleaseSRWLockExclusive(&m_Lock);
+						}
+						else
+						{
+							break;
+						}
+
+						if (m_Compress && !path.empty())
+						{
+							Compress(path);
+						}
+
+						Prune();
+
+						AcquireSRWLockExclusive(&m_Lock);
+					}
+
+					ReleaseSRWLockExclusive(&m_Lock);
+				}
+
+				/**
+				 * @brief Rotates the active file off the logging thread, then writes the
+				 *        lines logged meanwhile and hands the file back to the sink.
+				 *
+				 * @return The rotated path, empty if the file was truncated instead.
+				 */
+				std::string Rotate(ActiveLogFile& active)
+				{
+					//
+					// The sink is buffering lines in memory until this returns, don't
+					// queue its I/O behind everything else on the disk
+					//
+					SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+
+					auto rotated = RotatedPath();
+					bool moved = false;
+					bool opened = false;
+
+					try
+					{
+						moved = active.Rotate(rotated);
+						opened = true;
+					}
+					catch (const spdlog::spdlog_ex&)
+					{
+					}
+
+					//
+					// Keep retrying to open the fresh file until stopped; lines beyond
+					// HYDRAHOOK_LOG_ROTATION_BACKLOG_SIZE are dropped meanwhile
+					//
+					while (!opened && !IsStopping())
+					{
+						Sleep(HYDRAHOOK_LOG_ROTATION_RETRY_MS);
+
+						try
+						{
+							active.File.open(active.Path, true);
+							opened = true;
+						}
+						catch (const spdlog::spdlog_ex&)
+						{
+						}
+					}
+
+					uint64_t dropped = 0;
+
+					if (opened)
+					{
+						AcquireSRWLockExclusive(&active.Lock);
+
+						try
+						{
+							active.File.write(active.Pending);
+						}
+						catch (const spdlog::spdlog_ex&)
+						{
+						}
+
+						active.Pending.clear();
+						dropped = active.Dropped;
+						active.Dropped = 0;
+						active.Rotating = false;
+
+						ReleaseSRWLockExclusive(&active.Lock);
+					}
+
+					SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+					if (const auto logger = spdlog::get("HYDRAHOOK"))
+					{
+						if (!opened)
+						{
+							logger->error("Failed to reopen log file {} after rotation", active.Path);
+						}
+						else if (dropped)
+						{
+							logger->warn("Dropped {} log lines while rotating {}", dropped, active.Path);
+						}
+					}
+
+					return moved ? rotated : std::string();
+				}
+
+				bool IsStopping()
+				{
+					AcquireSRWLockShared(&m_Lock);
+					const bool stopping = m_Stop;
+					ReleaseSRWLockShared(&m_Lock);
+
+					return stopping;
+				}
+
+				/** @brief Gzips a rotated file next to itself, deleting the source on success. */
+				static void Compress(const std::string& path)
+				{
+					const auto archive = path + ".gz";
+
+					FILE* in = nullptr;
+					if (fopen_s(&in, path.c_str(), "rb") != 0 || !in)
+						return;
+
+					const gzFile out = gzopen(archive.c_str(), "wb6");
+					if (!out)
+					{
+						fclose(in);
+						return;
+					}
+
+					gzbuffer(out, HYDRAHOOK_LOG_WRITE_BUFFER_SIZE);
+
+					const std::unique_ptr<char[]> chunk(new char[HYDRAHOOK_LOG_WRITE_BUFFER_SIZE]);
+					bool succeeded = true;
+					size_t read;
+
+					while ((read = fread(chunk.get(), 1, HYDRAHOOK_LOG_WRITE_BUFFER_SIZE, in)) > 0)
+					{
+						if (gzwrite(out, chunk.get(), static_cast<unsigned>(read)) != static_cast<int>(read))
+						{
+							succeeded = false;
+							break;
+						}
+					}
+
+					if (ferror(in))
+						succeeded = false;
+
+					fclose(in);
+
+					if (gzclose(out) != Z_OK)
+						succeeded = false;
+
+					//
+					// Keep the uncompressed file if anything went wrong, the next session retries
+					//
+					DeleteFileA(succeeded ? path.c_str() : archive.c_str());
+
+					if (!succeeded)
+					{
+						if (const auto logger = spdlog::get("HYDRAHOOK"))
+						{
+							logger->warn("Failed to compress rotated log file {}", path);
+						}
+					}
+				}
+
+				/**
+				 * @brief Calls back with the timestamp key of every rotated file.
+				 *
+				 * A file being compressed shows up twice (plain and .gz); that is fine
+				 * for both callers.
+				 */
+				void EnumerateRotated(const std::function<void(const std::string&, bool)>& callback) const
+				{
+					WIN32_FIND_DATAA data;
+					const HANDLE find = FindFirstFileA((m_Directory + m_Stem + ".*").c_str(), &data);
+
+					if (find == INVALID_HANDLE_VALUE)
+						return;
+
+					const auto prefixLength = m_Stem.size() + 1;
+
+					do
+					{
+						if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+							continue;
+
+						const std::string name = data.cFileName;
+
+						//
+						// <stem>.<timestamp><ext>[.gz]; wildcard matching also returns the active file
+						//
+						if (name.size() < prefixLength + HYDRAHOOK_LOG_TIMESTAMP_LENGTH + m_Extension.size()
+							|| name.compare(0, prefixLength, m_Stem + ".") != 0)
+							continue;
+
+						const auto suffix = name.substr(prefixLength + HYDRAHOOK_LOG_TIMESTAMP_LENGTH);
+						const bool compressed = suffix == m_Extension + ".gz";
+
+						if (suffix != m_Extension && !compressed)
+							continue;
+
+						callback(name.substr(prefixLength, HYDRAHOOK_LOG_TIMESTAMP_LENGTH), compressed);
+					}
+					while (FindNextFileA(find, &data));
+
+					FindClose(find);
+				}
+
+				/** @brief Deletes all but the newest m_MaxFiles rotated files. */
+				void Prune() const
+				{
+					std::vector<std::string> keys;
+
+					EnumerateRotated([&keys](const std::string& key, bool)
+					{
+						keys.push_back(key);
+					});
+
+					//
+					// Timestamps sort chronologically, newest first
+					//
+					std::sort(keys.begin(), keys.end(), std::greater<>());
+					keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+					for (size_t i = m_MaxFiles; i < keys.size(); i++)
+					{
+						const auto rotated = m_Directory + m_Stem + "." + keys[i] + m_Extension;
+
+						DeleteFileA(rotated.c_str());
+						DeleteFileA((rotated + ".gz").c_str());
+					}
+				}
+
+				std::string m_Directory;
+				std::string m_Stem;
+				std::string m_Extension;
+				uint32_t m_MaxFiles;
+				bool m_Compress;
+
+				HMODULE m_Module = nullptr;
+				bool m_Running = false;
+
+				SRWLOCK m_Lock = SRWLOCK_INIT;
+				CONDITION_VARIABLE m_Wake = CONDITION_VARIABLE_INIT;
+				std::deque<std::string> m_Queue;
+				std::shared_ptr<ActiveLogFile> m_Rotation;
+				bool m_Stop = false;
+			};
+
+			RotatingCompressedSink::RotatingCompressedSink(std::string path, uint64_t maxSize, uint32_t maxFiles,
+			                                               bool compress)
+				: m_MaxSize(maxSize),
+				  m_CurrentSize(0),
+				  m_Active(std::make_shared<ActiveLogFile>(std::move(path)))
+			{
+				m_Active->File.open(m_Active->Path, false);
+				m_CurrentSize = m_Active->File.size();
+
+				m_Worker = std::make_shared<ArchiveWorker>(m_Active->Path, maxFiles, compress);
+				ArchiveWorker::Start(m_Worker);
+				m_Worker->EnqueueLeftovers();
+			}
+
+			RotatingCompressedSink::~RotatingCompressedSink()
+			{
+				//
+				// A pending rotation keeps its own reference on the active file
+				//
+				m_Worker->Stop();
+			}
+
+			void RotatingCompressedSink::StopArchiving()
+			{
+				m_Worker->Stop();
+			}
+
+			void StopArchiving(const std::shared_ptr<spdlog::logger>& logger)
+			{
+				if (!logger)
+					return;
+
+				for (const auto& sink : logger->sinks())
+				{
+					if (const auto rotating = std::dynamic_pointer_cast<RotatingCompressedSink>(sink))
+					{
+						rotating->StopArchiving();
+					}
+				}
+			}
+
+			void RotatingCompressedSink::sink_it_(const spdlog::details::log_msg& msg)
+			{
+				spdlog::memory_buf_t formatted;
+				formatter_->format(msg, formatted);
+
+				const auto size = static_cast<uint64_t>(formatted.size());
+				auto& active = *m_Active;
+
+				//
+				// Only this thread (holding the sink mutex) sets Rotating, so File is
+				// safe to use after the lock is released if it was clear
+				//
+				AcquireSRWLockExclusive(&active.Lock);
+
+				if (!active.Rotating && m_CurrentSize && m_CurrentSize + size > m_MaxSize)
+				{
+					active.Rotating = true;
+
+					if (m_Worker->EnqueueRotation(m_Active))
+					{
+						m_CurrentSize = 0;
+					}
+					else
+					{
+						active.Rotating = false;
+					}
+				}
+
+				if (active.Rotating)
+				{
+					if (active.Pending.size() + formatted.size() <= HYDRAHOOK_LOG_ROTATION_BACKLOG_SIZE)
+					{
+						active.Pending.append(formatted.data(), formatted.data() + formatted.size());
+						m_CurrentSize += size;
+					}
+					else
+					{
+						active.Dropped++;
+					}
+
+					ReleaseSRWLockExclusive(&active.Lock);
+					return;
+				}
+
+				ReleaseSRWLockExclusive(&active.Lock);
+
+				//
+				// No archive thread to hand the rotation to
+				//
+				if (m_CurrentSize && m_CurrentSize + size > m_MaxSize)
+				{
+					rotate_();
+				}
+
+				active.File.write(formatted);
+				m_CurrentSize += size;
+			}
+
+			void RotatingCompressedSink::flush_()
+			{
+				AcquireSRWLockExclusive(&m_Active->Lock);
+				const bool rotating = m_Active->Rotating;
+				ReleaseSRWLockExclusive(&m_Active->Lock);
+
+				//
+				// Mid-rotation the lines are in memory and the archive thread owns the file
+				//
+				if (!rotating)
+				{
+					m_Active->File.flush();
+				}
+			}
+
+			void RotatingCompressedSink::rotate_()
+			{
+				const auto rotated = m_Worker->RotatedPath();
+				const bool moved = m_Active->Rotate(rotated);
+
+				m_CurrentSize = 0;
+
+				if (moved)
+				{
+					m_Worker->Enqueue(rotated);
+				}
+			}
+		}
+	}
+}
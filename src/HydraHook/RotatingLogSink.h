@@ -0,0 +1,104 @@
+/**
+ * @file RotatingLogSink.h
+ * @brief Size-capped, rotating spdlog file sink with background gzip compression.
+ *
+ * The active file is written through a large stdio buffer, so lines are
+ * coalesced into big sequential writes and only reach the disk on an
+ * explicit flush (engine thread tick, warnings and above, shutdown). Once
+ * the active file would exceed the size cap a low-priority archive thread
+ * closes it, renames it to `<stem>.<timestamp><ext>` and opens a fresh one
+ * while the logging thread keeps new lines in memory; it then gzips the
+ * rotated file and prunes all but the newest archives.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#pragma once
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief stdio buffer size of the active log file.
+ */
+#define HYDRAHOOK_LOG_WRITE_BUFFER_SIZE (256 * 1024)
+
+/**
+ * @brief Bytes of lines kept in memory while the archive thread rotates the
+ *        active file; further lines are dropped and counted.
+ */
+#define HYDRAHOOK_LOG_ROTATION_BACKLOG_SIZE (1024 * 1024)
+
+/**
+ * @brief Interval between attempts to reopen the active file after rotation.
+ */
+#define HYDRAHOOK_LOG_ROTATION_RETRY_MS 1000
+
+namespace HydraHook
+{
+    namespace Core
+    {
+        namespace Logging
+        {
+            class ArchiveWorker;
+            struct ActiveLogFile;
+
+            /**
+             * @brief Rotating file sink; see file description.
+             *
+             * Files rotated by an earlier session that were not compressed yet
+             * (e.g. process exited mid-compression) are picked up on construction.
+             */
+            class RotatingCompressedSink final : public spdlog::sinks::base_sink<std::mutex>
+            {
+            public:
+                /**
+                 * @param path Active log file path.
+                 * @param maxSize Size cap of the active file in bytes.
+                 * @param maxFiles Rotated files to keep (compressed or not); 0 keeps none.
+                 * @param compress TRUE to gzip rotated files.
+                 * @throws spdlog::spdlog_ex if the file can not be opened.
+                 */
+                RotatingCompressedSink(std::string path, uint64_t maxSize, uint32_t maxFiles, bool compress);
+                ~RotatingCompressedSink() override;
+
+                RotatingCompressedSink(const RotatingCompressedSink&) = delete;
+                RotatingCompressedSink& operator=(const RotatingCompressedSink&) = delete;
+
+                /**
+                 * @brief Lets the archive thread drain its queue and exit, releasing its
+                 *        reference on this module; does not wait.
+                 *
+                 * Files rotated afterwards stay uncompressed until the next session.
+                 */
+                void StopArchiving();
+
+            protected:
+                void sink_it_(const spdlog::details::log_msg& msg) override;
+                void flush_() override;
+
+            private:
+                /** @brief Rotates on the logging thread; only without an archive thread. */
+                void rotate_();
+
+                uint64_t m_MaxSize;
+                uint64_t m_CurrentSize;
+                std::shared_ptr<ActiveLogFile> m_Active;
+                std::shared_ptr<ArchiveWorker> m_Worker;
+            };
+
+            /**
+             * @brief Calls StopArchiving on every RotatingCompressedSink of @p logger.
+             *
+             * Must run before the module is unloaded; the archive thread pins it until then.
+             */
+            void StopArchiving(const std::shared_ptr<spdlog::logger>& logger);
+        }
+    }
+}
@@ -0,0 +1,1362 @@
+/**
+ * @file SwapChainSimulation.cpp
+ * @brief Opt-in mock swap chain driver for running the hook dispatch without a GPU.
+ *
+ * The mocks are plain structs whose first member points at a hand-built
+ * COM vtable. Only the methods the dispatch path and the driver touch are
+ * implemented; every other slot fails fast with its index so a host that
+ * reaches further into the mocks is easy to spot. Observation counters live
+ * on the chain and are only touched by its own presenting thread, since the
+ * hook lambdas invoke host callbacks synchronously.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#include "SwapChainSimulation.h"
+
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <dxgi1_4.h>
+#include <d3d10.h>
+#include <d3d11.h>
+#include <d3d12.h>
+
+//
+// Public
+//
+#include "HydraHook/Engine/HydraHookCore.h"
+#include "HydraHook/Engine/HydraHookDirect3D9.h"
+#include "HydraHook/Engine/HydraHookDirect3D10.h"
+#include "HydraHook/Engine/HydraHookDirect3D11.h"
+#include "HydraHook/Engine/HydraHookDirect3D12.h"
+#include "HydraHook/Engine/HydraHookCoreAudio.h"
+#include "HydraHook/Engine/HydraHookRecord.h"
+
+//
+// Internal
+//
+#include "Engine.h"
+#include "Game/Game.h"
+#include "Game/Hook/DXGI.h"
+#include "Utils/Global.h"
+
+//
+// STL
+//
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//
+// Logging
+//
+#include <spdlog/spdlog.h>
+
+constexpr size_t SwapChainVtblSize = 41;  // through IDXGISwapChain4::SetHDRMetaData
+constexpr size_t DeviceVtblSize = 64;     // covers ID3D10Device, ID3D11Device and ID3D12Device
+constexpr size_t QueueVtblSize = 19;      // through ID3D12CommandQueue::GetDesc
+
+constexpr size_t QueueGetDeviceIndex = 7;
+constexpr size_t QueueExecuteCommandListsIndex = 10;
+
+struct MockDevice
+{
+	void** Vtbl;
+	volatile LONG Refs;
+	HYDRAHOOK_D3D_VERSION Version;
+};
+
+struct MockQueue
+{
+	void** Vtbl;
+	volatile LONG Refs;
+	MockDevice* Device;
+	LONG64 Executed;
+};
+
+struct MockSwapChain
+{
+	void** Vtbl;
+	volatile LONG Refs;
+
+	ULONG Index;
+	HYDRAHOOK_D3D_VERSION Version;
+	bool UsePresent1;
+	MockDevice Device;
+	MockQueue Queue;
+	UINT Width;
+	UINT Height;
+
+	//
+	// Calls that reached the mock bodies
+	//
+	LONG64 Presented;
+	LONG64 Resized;
+
+	//
+	// Calls issued by the driver
+	//
+	LONG64 Presents;
+	LONG64 Resizes;
+	LONG64 ShutdownPresents;
+
+	//
+	// What the host callbacks observed
+	//
+	LONG64 PrePresent;
+	LONG64 PostPresent;
+	LONG64 PreResize;
+	LONG64 PostResize;
+	LONG64 Misrouted;
+	LONG64 Unpaired;
+	LONG64 LateCallbacks;
+	bool PendingPre;
+	int QueueResolved; // -1 not checked yet
+
+	std::thread Thread;
+};
+
+static void* g_SwapChainVtbl[SwapChainVtblSize];
+static void* g_DeviceVtbl[DeviceVtblSize];
+static void* g_QueueVtbl[QueueVtblSize];
+static std::once_flag g_VtblOnce;
+
+static std::vector<std::unique_ptr<MockSwapChain>> g_Chains;
+static std::atomic<bool> g_Stop{false};
+static std::atomic<bool> g_ShuttingDown{false};
+static LARGE_INTEGER g_ShutdownStart;
+static LONGLONG g_PresentBurnTicks;
+
+static std::mutex g_InterposeLock;
+static HYDRAHOOK_D3D10_EVENT_CALLBACKS g_HostD3D10;
+static HYDRAHOOK_D3D11_EVENT_CALLBACKS g_HostD3D11;
+static HYDRAHOOK_D3D12_EVENT_CALLBACKS g_HostD3D12;
+
+//
+// Mock method bodies; kept distinct so the linker cannot fold them and
+// Detours patches exactly the method it was pointed at
+//
+
+static __declspec(noinline) void MockFatal(size_t slot)
+{
+	const auto logger = spdlog::get("HYDRAHOOK");
+	logger->critical("swapchain-simulation: unimplemented mock method in vtable slot {} called", slot);
+	logger->flush();
+	__fastfail(FAST_FAIL_FATAL_APP_EXIT);
+}
+
+template <size_t Slot>
+static void STDMETHODCALLTYPE MockUnimplemented()
+{
+	MockFatal(Slot);
+}
+
+template <size_t... Slots>
+static void FillUnimplemented(void** vtbl, std::index_sequence<Slots...>)
+{
+	((vtbl[Slots] = reinterpret_cast<void*>(&MockUnimplemented<Slots>)), ...);
+}
+
+static REFIID MockDeviceIid(HYDRAHOOK_D3D_VERSION version)
+{
+	switch (version)
+	{
+	case HydraHookDirect3DVersion10:
+		return __uuidof(ID3D10Device);
+	case HydraHookDirect3DVersion11:
+		return __uuidof(ID3D11Device);
+	default:
+		return __uuidof(ID3D12Device);
+	}
+}
+
+static MockSwapChain* MockSwapChainFrom(IUnknown* pObject)
+{
+	const auto chain = reinterpret_cast<MockSwapChain*>(pObject);
+
+	return chain && chain->Vtbl == g_SwapChainVtbl ? chain : nullptr;
+}
+
+static void MockBurn()
+{
+	if (g_PresentBurnTicks <= 0)
+		return;
+
+	LARGE_INTEGER start, now;
+	QueryPerformanceCounter(&start);
+	do
+	{
+		YieldProcessor();
+		QueryPerformanceCounter(&now);
+	}
+	while (now.QuadPart - start.QuadPart < g_PresentBurnTicks);
+}
+
+static HRESULT STDMETHODCALLTYPE MockSwapChain_QueryInterface(MockSwapChain* This, REFIID riid, void** ppvObject)
+{
+	if (!ppvObject)
+		return E_POINTER;
+
+	if (riid == __uuidof(IUnknown) || riid == __uuidof(IDXGIObject) || riid == __uuidof(IDXGIDeviceSubObject)
+		|| riid == __uuidof(IDXGISwapChain) || riid == __uuidof(IDXGISwapChain1)
+		|| riid == __uuidof(IDXGISwapChain2) || riid == __uuidof(IDXGISwapChain3))
+	{
+		InterlockedIncrement(&This->Refs);
+		*ppvObject = This;
+		return S_OK;
+	}
+
+	*ppvObject = nullptr;
+	return E_NOINTERFACE;
+}
+
+static ULONG STDMETHODCALLTYPE MockSwapChain_AddRef(MockSwapChain* This)
+{
+	return static_cast<ULONG>(InterlockedIncrement(&This->Refs));
+}
+
+static ULONG STDMETHODCALLTYPE MockSwapChain_Release(MockSwapChain* This)
+{
+	// Owned by the driver; the count is only kept for balance checks
+	return static_cast<ULONG>(InterlockedDecrement(&This->Refs));
+}
+
+static HRESULT STDMETHODCALLTYPE MockSwapChain_GetDevice(MockSwapChain* This, REFIID riid, void** ppDevice)
+{
+	if (!ppDevice)
+		return E_POINTER;
+
+	if (riid == MockDeviceIid(This->Version))
+	{
+		InterlockedIncrement(&This->Device.Refs);
+		*ppDevice = &This->Device;
+		return S_OK;
+	}
+
+	*ppDevice = nullptr;
+	return E_NOINTERFACE;
+}
+
+static HRESULT STDMETHODCALLTYPE MockSwapChain_Present(MockSwapChain* This, UINT SyncInterval, UINT Flags)
+{
+	UNREFERENCED_PARAMETER(SyncInterval);
+
+	if (Flags & DXGI_PRESENT_TEST)
+		return S_OK;
+
+	This->Presented++;
+	MockBurn();
+
+	return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE MockSwapChain_GetDesc(MockSwapChain* This, DXGI_SWAP_CHAIN_DESC* pDesc)
+{
+	if (!pDesc)
+		return E_INVALIDARG;
+
+	ZeroMemory(pDesc, sizeof(*pDesc));
+	pDesc->BufferDesc.Width = This->Width;
+	pDesc->BufferDesc.Height = This->Height;
+	pDesc->BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	pDesc->SampleDesc.Count = 1;
+	pDesc->BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+	pDesc->BufferCount = 2;
+	pDesc->Windowed = TRUE;
+	pDesc->SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+
+	return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE MockSwapChain_ResizeBuffers(MockSwapChain* This, UINT BufferCount, UINT Width,
+                                                             UINT Height, DXGI_FORMAT NewFormat, UINT SwapChainFlags)
+{
+	UNREFERENCED_PARAMETER(BufferCount);
+	UNREFERENCED_PARAMETER(NewFormat);
+	UNREFERENCED_PARAMETER(SwapChainFlags);
+
+	if (Width)
+		This->Width = Width;
+	if (Height)
+		This->Height = Height;
+	This->Resized++;
+
+	return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE MockSwapChain_ResizeTarget(MockSwapChain* This,
+                                                            const DXGI_MODE_DESC* pNewTargetParameters)
+{
+	if (!pNewTargetParameters)
+		return DXGI_ERROR_INVALID_CALL;
+
+	This->Width = pNewTargetParameters->Width;
+	This->Height = pNewTargetParameters->Height;
+
+	return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE MockSwapChain_Present1(MockSwapChain* This, UINT SyncInterval, UINT PresentFlags,
+                                                        const DXGI_PRESENT_PARAMETERS* pPresentParameters)
+{
+	UNREFERENCED_PARAMETER(SyncInterval);
+	UNREFERENCED_PARAMETER(PresentFlags);
+
+	if (!pPresentParameters)
+		return DXGI_ERROR_INVALID_CALL;
+
+	This->Presented++;
+	MockBurn();
+
+	return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE MockSwapChain_ResizeBuffers1(MockSwapChain* This, UINT BufferCount, UINT Width,
+                                                              UINT Height, DXGI_FORMAT Format, UINT SwapChainFlags,
+                                                              const UINT* pCreationNodeMask,
+                                                              IUnknown* const* ppPresentQueue)
+{
+	UNREFERENCED_PARAMETER(Format);
+	UNREFERENCED_PARAMETER(SwapChainFlags);
+	UNREFERENCED_PARAMETER(pCreationNodeMask);
+
+	//
+	// D3D12 chains must name a queue per buffer, like the real runtime requires
+	//
+	if (This->Version == HydraHookDirect3DVersion12 && !ppPresentQueue)
+		return DXGI_ERROR_INVALID_CALL;
+
+	if (Width)
+		This->Width = Width;
+	if (Height)
+		This->Height = Height;
+	This->Resized++;
+
+	return S_OK;
+}
+
+static HRESULT STDMETHODCALLTYPE MockDevice_QueryInterface(MockDevice* This, REFIID riid, void** ppvObject)
+{
+	if (!ppvObject)
+		return E_POINTER;
+
+	if (riid == __uuidof(IUnknown) || riid == MockDeviceIid(This->Version))
+	{
+		InterlockedIncrement(&This->Refs);
+		*ppvObject = This;
+		return S_OK;
+	}
+
+	*ppvObject = nullptr;
+	return E_NOINTERFACE;
+}
+
+static ULONG STDMETHODCALLTYPE MockDevice_AddRef(MockDevice* This)
+{
+	return static_cast<ULONG>(InterlockedIncrement(&This->Refs));
+}
+
+static ULONG STDMETHODCALLTYPE MockDevice_Release(MockDevice* This)
+{
+	return static_cast<ULONG>(InterlockedDecrement(&This->Refs));
+}
+
+static HRESULT STDMETHODCALLTYPE MockQueue_QueryInterface(MockQueue* This, REFIID riid, void** ppvObject)
+{
+	if (!ppvObject)
+		return E_POINTER;
+
+	if (riid == __uuidof(IUnknown) || riid == __uuidof(ID3D12Object) || riid == __uuidof(ID3D12DeviceChild)
+		|| riid == __uuidof(ID3D12Pageable) || riid == __uuidof(ID3D12CommandQueue))
+	{
+		InterlockedIncrement(&This->Refs);
+		*ppvObject = This;
+		return S_OK;
+	}
+
+	*ppvObject = nullptr;
+	return E_NOINTERFACE;
+}
+
+static ULONG STDMETHODCALLTYPE MockQueue_AddRef(MockQueue* This)
+{
+	return static_cast<ULONG>(InterlockedIncrement(&This->Refs));
+}
+
+static ULONG STDMETHODCALLTYPE MockQueue_Release(MockQueue* This)
+{
+	return static_cast<ULONG>(InterlockedDecrement(&This->Refs));
+}
+
+static HRESULT STDMETHODCALLTYPE MockQueue_GetDevice(MockQueue* This, REFIID riid, void** ppvDevice)
+{
+	if (!ppvDevice)
+		return E_POINTER;
+
+	if (riid == __uuidof(ID3D12Device))
+	{
+		InterlockedIncrement(&This->Device->Refs);
+		*ppvDevice = This->Device;
+		return S_OK;
+	}
+
+	*ppvDevice = nullptr;
+	return E_NOINTERFACE;
+}
+
+static void STDMETHODCALLTYPE MockQueue_ExecuteCommandLists(MockQueue* This, UINT NumCommandLists,
+                                                            ID3D12CommandList* const* ppCommandLists)
+{
+	UNREFERENCED_PARAMETER(ppCommandLists);
+
+	This->Executed += 1 + NumCommandLists;
+}
+
+static void BuildVtables()
+{
+	FillUnimplemented(g_SwapChainVtbl, std::make_index_sequence<SwapChainVtblSize>());
+	FillUnimplemented(g_DeviceVtbl, std::make_index_sequence<DeviceVtblSize>());
+	FillUnimplemented(g_QueueVtbl, std::make_index_sequence<QueueVtblSize>());
+
+	g_SwapChainVtbl[DXGIHooking::QueryInterface] = reinterpret_cast<void*>(&MockSwapChain_QueryInterface);
+	g_SwapChainVtbl[DXGIHooking::AddRef] = reinterpret_cast<void*>(&MockSwapChain_AddRef);
+	g_SwapChainVtbl[DXGIHooking::Release] = reinterpret_cast<void*>(&MockSwapChain_Release);
+	g_SwapChainVtbl[DXGIHooking::GetDevice] = reinterpret_cast<void*>(&MockSwapChain_GetDevice);
+	g_SwapChainVtbl[DXGIHooking::Present] = reinterpret_cast<void*>(&MockSwapChain_Present);
+	g_SwapChainVtbl[DXGIHooking::GetDesc] = reinterpret_cast<void*>(&MockSwapChain_GetDesc);
+	g_SwapChainVtbl[DXGIHooking::ResizeBuffers] = reinterpret_cast<void*>(&MockSwapChain_ResizeBuffers);
+	g_SwapChainVtbl[DXGIHooking::ResizeTarget] = reinterpret_cast<void*>(&MockSwapChain_ResizeTarget);
+	g_SwapChainVtbl[DXGIHooking::DXGI1::Present1] = reinterpret_cast<void*>(&MockSwapChain_Present1);
+	g_SwapChainVtbl[DXGIHooking::DXGI3::ResizeBuffers1] = reinterpret_cast<void*>(&MockSwapChain_ResizeBuffers1);
+
+	g_DeviceVtbl[0] = reinterpret_cast<void*>(&MockDevice_QueryInterface);
+	g_DeviceVtbl[1] = reinterpret_cast<void*>(&MockDevice_AddRef);
+	g_DeviceVtbl[2] = reinterpret_cast<void*>(&MockDevice_Release);
+
+	g_QueueVtbl[0] = reinterpret_cast<void*>(&MockQueue_QueryInterface);
+	g_QueueVtbl[1] = reinterpret_cast<void*>(&MockQueue_AddRef);
+	g_QueueVtbl[2] = reinterpret_cast<void*>(&MockQueue_Release);
+	g_QueueVtbl[QueueGetDeviceIndex] = reinterpret_cast<void*>(&MockQueue_GetDevice);
+	g_QueueVtbl[QueueExecuteCommandListsIndex] = reinterpret_cast<void*>(&MockQueue_ExecuteCommandLists);
+}
+
+std::vector<size_t> HydraHookSwapChainSimulationVtable()
+{
+	std::call_once(g_VtblOnce, BuildVtables);
+
+	std::vector<size_t> vtable(SwapChainVtblSize);
+	for (size_t i = 0; i < SwapChainVtblSize; i++)
+		vtable[i] = reinterpret_cast<size_t>(g_SwapChainVtbl[i]);
+
+	return vtable;
+}
+
+void** HydraHookSwapChainSimulationQueueVtable()
+{
+	std::call_once(g_VtblOnce, BuildVtables);
+
+	return g_QueueVtbl;
+}
+
+//
+// Host callback forwarders
+//
+
+enum class ObservedEvent
+{
+	PrePresent,
+	PostPresent,
+	PreResize,
+	PostResize
+};
+
+static void Observe(IDXGISwapChain* pSwapChain, HYDRAHOOK_D3D_VERSION version, ObservedEvent event)
+{
+	const auto chain = MockSwapChainFrom(pSwapChain);
+	if (!chain)
+		return;
+
+	if (chain->Version != version)
+		chain->Misrouted++;
+
+	if (g_ShuttingDown.load(std::memory_order_relaxed))
+		chain->LateCallbacks++;
+
+	switch (event)
+	{
+	case ObservedEvent::PrePresent:
+		chain->PrePresent++;
+		chain->PendingPre = true;
+		break;
+	case ObservedEvent::PostPresent:
+		chain->PostPresent++;
+		if (!chain->PendingPre)
+			chain->Unpaired++;
+		chain->PendingPre = false;
+		break;
+	case ObservedEvent::PreResize:
+		chain->PreResize++;
+		break;
+	case ObservedEvent::PostResize:
+		chain->PostResize++;
+		break;
+	}
+}
+
+static void SimD3D10PrePresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion10, ObservedEvent::PrePresent);
+	if (const auto host = g_HostD3D10.EvtHydraHookD3D10PrePresent)
+		host(pSwapChain, SyncInterval, Flags);
+}
+
+static void SimD3D10PostPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion10, ObservedEvent::PostPresent);
+	if (const auto host = g_HostD3D10.EvtHydraHookD3D10PostPresent)
+		host(pSwapChain, SyncInterval, Flags);
+}
+
+static void SimD3D10PreResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount, UINT Width, UINT Height,
+                                     DXGI_FORMAT NewFormat, UINT SwapChainFlags)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion10, ObservedEvent::PreResize);
+	if (const auto host = g_HostD3D10.EvtHydraHookD3D10PreResizeBuffers)
+		host(pSwapChain, BufferCount, Width, Height, NewFormat, SwapChainFlags);
+}
+
+static void SimD3D10PostResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount, UINT Width, UINT Height,
+                                      DXGI_FORMAT NewFormat, UINT SwapChainFlags)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion10, ObservedEvent::PostResize);
+	if (const auto host = g_HostD3D10.EvtHydraHookD3D10PostResizeBuffers)
+		host(pSwapChain, BufferCount, Width, Height, NewFormat, SwapChainFlags);
+}
+
+static void SimD3D11PrePresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags,
+                               PHYDRAHOOK_EVT_PRE_EXTENSION Extension)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion11, ObservedEvent::PrePresent);
+	if (const auto host = g_HostD3D11.EvtHydraHookD3D11PrePresent)
+		host(pSwapChain, SyncInterval, Flags, Extension);
+}
+
+static void SimD3D11PostPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags,
+                                PHYDRAHOOK_EVT_POST_EXTENSION Extension)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion11, ObservedEvent::PostPresent);
+	if (const auto host = g_HostD3D11.EvtHydraHookD3D11PostPresent)
+		host(pSwapChain, SyncInterval, Flags, Extension);
+}
+
+static void SimD3D11PreResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount, UINT Width, UINT Height,
+                                     DXGI_FORMAT NewFormat, UINT SwapChainFlags,
+                                     PHYDRAHOOK_EVT_PRE_EXTENSION Extension)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion11, ObservedEvent::PreResize);
+	if (const auto host = g_HostD3D11.EvtHydraHookD3D11PreResizeBuffers)
+		host(pSwapChain, BufferCount, Width, Height, NewFormat, SwapChainFlags, Extension);
+}
+
+static void SimD3D11PostResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount, UINT Width, UINT Height,
+                                      DXGI_FORMAT NewFormat, UINT SwapChainFlags,
+                                      PHYDRAHOOK_EVT_POST_EXTENSION Extension)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion11, ObservedEvent::PostResize);
+	if (const auto host = g_HostD3D11.EvtHydraHookD3D11PostResizeBuffers)
+		host(pSwapChain, BufferCount, Width, Height, NewFormat, SwapChainFlags, Extension);
+}
+
+static void SimD3D12PrePresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags,
+                               PHYDRAHOOK_EVT_PRE_EXTENSION Extension)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion12, ObservedEvent::PrePresent);
+	if (const auto host = g_HostD3D12.EvtHydraHookD3D12PrePresent)
+		host(pSwapChain, SyncInterval, Flags, Extension);
+}
+
+static void SimD3D12PostPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags,
+                                PHYDRAHOOK_EVT_POST_EXTENSION Extension)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion12, ObservedEvent::PostPresent);
+	if (const auto host = g_HostD3D12.EvtHydraHookD3D12PostPresent)
+		host(pSwapChain, SyncInterval, Flags, Extension);
+}
+
+static void SimD3D12PreResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount, UINT Width, UINT Height,
+                                     DXGI_FORMAT NewFormat, UINT SwapChainFlags,
+                                     PHYDRAHOOK_EVT_PRE_EXTENSION Extension)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion12, ObservedEvent::PreResize);
+	if (const auto host = g_HostD3D12.EvtHydraHookD3D12PreResizeBuffers)
+		host(pSwapChain, BufferCount, Width, Height, NewFormat, SwapChainFlags, Extension);
+}
+
+static void SimD3D12PostResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount, UINT Width, UINT Height,
+                                      DXGI_FORMAT NewFormat, UINT SwapChainFlags,
+                                      PHYDRAHOOK_EVT_POST_EXTENSION Extension)
+{
+	Observe(pSwapChain, HydraHookDirect3DVersion12, ObservedEvent::PostResize);
+	if (const auto host = g_HostD3D12.EvtHydraHookD3D12PostResizeBuffers)
+		host(pSwapChain, BufferCount, Width, Height, NewFormat, SwapChainFlags, Extension);
+}
+
+//
+// Moves whatever the host put into _slot_ aside and puts the forwarder in its place
+//
+#define SIM_INTERPOSE(_events_, _host_, _slot_, _forwarder_) \
+	if ((_events_)._slot_ != (_forwarder_)) \
+	{ \
+		(_host_)._slot_ = (_events_)._slot_; \
+		(_events_)._slot_ = (_forwarder_); \
+	}
+
+//
+// Puts the host's callback back if the forwarder still occupies _slot_
+//
+#define SIM_RESTORE(_events_, _host_, _slot_, _forwarder_) \
+	if ((_events_)._slot_ == (_forwarder_)) \
+	{ \
+		(_events_)._slot_ = (_host_)._slot_; \
+	}
+
+#define SIM_FOR_EACH_SLOT(_op_, _engine_) \
+	_op_(_engine_->EventsD3D10, g_HostD3D10, EvtHydraHookD3D10PrePresent, SimD3D10PrePresent) \
+	_op_(_engine_->EventsD3D10, g_HostD3D10, EvtHydraHookD3D10PostPresent, SimD3D10PostPresent) \
+	_op_(_engine_->EventsD3D10, g_HostD3D10, EvtHydraHookD3D10PreResizeBuffers, SimD3D10PreResizeBuffers) \
+	_op_(_engine_->EventsD3D10, g_HostD3D10, EvtHydraHookD3D10PostResizeBuffers, SimD3D10PostResizeBuffers) \
+	_op_(_engine_->EventsD3D11, g_HostD3D11, EvtHydraHookD3D11PrePresent, SimD3D11PrePresent) \
+	_op_(_engine_->EventsD3D11, g_HostD3D11, EvtHydraHookD3D11PostPresent, SimD3D11PostPresent) \
+	_op_(_engine_->EventsD3D11, g_HostD3D11, EvtHydraHookD3D11PreResizeBuffers, SimD3D11PreResizeBuffers) \
+	_op_(_engine_->EventsD3D11, g_HostD3D11, EvtHydraHookD3D11PostResizeBuffers, SimD3D11PostResizeBuffers) \
+	_op_(_engine_->EventsD3D12, g_HostD3D12, EvtHydraHookD3D12PrePresent, SimD3D12PrePresent) \
+	_op_(_engine_->EventsD3D12, g_HostD3D12, EvtHydraHookD3D12PostPresent, SimD3D12PostPresent) \
+	_op_(_engine_->EventsD3D12, g_HostD3D12, EvtHydraHookD3D12PreResizeBuffers, SimD3D12PreResizeBuffers) \
+	_op_(_engine_->EventsD3D12, g_HostD3D12, EvtHydraHookD3D12PostResizeBuffers, SimD3D12PostResizeBuffers)
+
+void HydraHookSwapChainSimulationInterpose(PHYDRAHOOK_ENGINE Engine)
+{
+	if (!Engine)
+		return;
+
+	std::lock_guard<std::mutex> lock(g_InterposeLock);
+
+	SIM_FOR_EACH_SLOT(SIM_INTERPOSE, Engine)
+}
+
+//
+// Driver
+//
+// Driver
+//
+
+static MockSwapChain* CreateChain(HYDRAHOOK_D3D_VERSION version, bool usePresent1)
+{
+	auto chain = std::make_unique<MockSwapChain>();
+
+	chain->Vtbl = g_SwapChainVtbl;
+	chain->Refs = 1;
+	chain->Index = static_cast<ULONG>(g_Chains.size());
+	chain->Version = version;
+	chain->UsePresent1 = usePresent1;
+	chain->Device.Vtbl = g_DeviceVtbl;
+	chain->Device.Refs = 1;
+	chain->Device.Version = version;
+	chain->Queue.Vtbl = g_QueueVtbl;
+	chain->Queue.Refs = 1;
+	chain->Queue.Device = &chain->Device;
+	chain->Width = 1280;
+	chain->Height = 720;
+	chain->QueueResolved = -1;
+
+	g_Chains.push_back(std::move(chain));
+
+	return g_Chains.back().get();
+}
+
+static int ApiNumber(HYDRAHOOK_D3D_VERSION version)
+{
+	switch (version)
+	{
+	case HydraHookDirect3DVersion10:
+		return 10;
+	case HydraHookDirect3DVersion11:
+		return 11;
+	default:
+		return 12;
+	}
+}
+
+static const char* QueueResolvedJson(const MockSwapChain* chain)
+{
+	if (chain->QueueResolved < 0)
+		return "null";
+
+	return chain->QueueResolved ? "true" : "false";
+}
+
+static void Report(const std::shared_ptr<spdlog::logger>& logger, const MockSwapChain* chain, const char* phase,
+                   double fps, double presentUs, double presentUsMax)
+{
+	logger->info(
+		"swapchain-simulation {{\"phase\":\"{}\",\"chain\":{},\"api\":{},\"present1\":{},\"presents\":{},\"fps\":{:.1f},"
+		"\"present_us\":{:.3f},\"present_us_max\":{:.3f},\"pre_present\":{},\"post_present\":{},\"resizes\":{},"
+		"\"pre_resize\":{},\"post_resize\":{},\"misrouted\":{},\"unpaired\":{},\"queue_resolved\":{}}}",
+		phase, chain->Index, ApiNumber(chain->Version), chain->UsePresent1 ? "true" : "false", chain->Presents, fps,
+		presentUs, presentUsMax, chain->PrePresent, chain->PostPresent, chain->Resizes, chain->PreResize,
+		chain->PostResize, chain->Misrouted, chain->Unpaired, QueueResolvedJson(chain));
+}
+
+/**
+ * Checks that the engine resolves the chain's own queue; only valid while hooks are installed.
+ */
+static void CheckQueue(MockSwapChain* chain)
+{
+	if (chain->Version != HydraHookDirect3DVersion12 || g_ShuttingDown.load(std::memory_order_relaxed))
+		return;
+
+	const auto resolved = GetD3D12CommandQueueForSwapChain(reinterpret_cast<IDXGISwapChain*>(chain));
+	chain->QueueResolved = resolved == reinterpret_cast<ID3D12CommandQueue*>(&chain->Queue);
+	if (resolved)
+		resolved->Release();
+}
+
+/**
+ * Presents once through the (hooked) mock vtable and returns the ticks the call took.
+ */
+static LONGLONG PresentOnce(MockSwapChain* chain, UINT syncInterval, UINT flags, bool present1)
+{
+	const auto swapChain = reinterpret_cast<IDXGISwapChain1*>(chain);
+
+	//
+	// Submit work like a game would, so the queue capture hook sees this chain's device
+	//
+	if (chain->Version == HydraHookDirect3DVersion12)
+		reinterpret_cast<ID3D12CommandQueue*>(&chain->Queue)->ExecuteCommandLists(0, nullptr);
+
+	LARGE_INTEGER before, after;
+	QueryPerformanceCounter(&before);
+
+	if (present1)
+	{
+		DXGI_PRESENT_PARAMETERS params = {};
+		swapChain->Present1(syncInterval, flags, &params);
+	}
+	else
+	{
+		swapChain->Present(syncInterval, flags);
+	}
+
+	QueryPerformanceCounter(&after);
+
+	//
+	// Pre ran but Post was skipped for the same call
+	//
+	if (chain->PendingPre)
+	{
+		chain->Unpaired++;
+		chain->PendingPre = false;
+	}
+
+	chain->Presents++;
+	if (g_ShuttingDown.load(std::memory_order_relaxed))
+		chain->ShutdownPresents++;
+
+	return after.QuadPart - before.QuadPart;
+}
+
+static void ResizeOnce(MockSwapChain* chain, UINT bufferCount, UINT width, UINT height, bool resizeBuffers1)
+{
+	const auto swapChain = reinterpret_cast<IDXGISwapChain3*>(chain);
+
+	if (resizeBuffers1)
+	{
+		UINT nodeMasks[DXGI_MAX_SWAP_CHAIN_BUFFERS];
+		IUnknown* queues[DXGI_MAX_SWAP_CHAIN_BUFFERS];
+
+		for (UINT i = 0; i < DXGI_MAX_SWAP_CHAIN_BUFFERS; i++)
+		{
+			nodeMasks[i] = 1;
+			queues[i] = reinterpret_cast<IUnknown*>(&chain->Queue);
+		}
+
+		swapChain->ResizeBuffers1((std::min)(bufferCount, static_cast<UINT>(DXGI_MAX_SWAP_CHAIN_BUFFERS)), width, height,
+		                          DXGI_FORMAT_UNKNOWN, 0, nodeMasks, queues);
+	}
+	else
+	{
+		swapChain->ResizeBuffers(bufferCount, width, height, DXGI_FORMAT_UNKNOWN, 0);
+	}
+
+	chain->Resizes++;
+}
+
+static void WaitUntil(LONGLONG deadline, LONGLONG ticksPerMs)
+{
+	LARGE_INTEGER now;
+
+	for (;;)
+	{
+		QueryPerformanceCounter(&now);
+
+		const LONGLONG remaining = deadline - now.QuadPart;
+		if (remaining <= 0)
+			return;
+
+		if (remaining > 2 * ticksPerMs)
+			Sleep(1);
+		else
+			YieldProcessor();
+	}
+}
+
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY
+
+//
+// Replay of a HydraHookRecord file; every recorded thread gets its own
+// replay thread and one mock chain per API it presented with
+//
+
+struct ReplayStream
+{
+	uint32_t ThreadId;
+	std::vector<HYDRAHOOK_RECORD> Records;
+	std::vector<MockSwapChain*> Targets; // per record, nullptr when not replayed
+	std::vector<MockSwapChain*> Chains;
+
+	LONG64 Replayed;
+	LONG64 Nested;
+	LONG64 Skipped;
+	LONGLONG LagTicks;
+	LONGLONG LagTicksMax;
+	LONGLONG CallTicks;
+	LONGLONG RecordedTicks;
+
+	std::thread Thread;
+};
+
+static std::vector<std::unique_ptr<ReplayStream>> g_Streams;
+static LONGLONG g_ReplayOrigin;      // QPC the earliest record is replayed at
+static uint64_t g_ReplayFirstStart;  // earliest replayed Start, in recorded ticks
+static double g_ReplayTickRatio;     // local QPC ticks per recorded tick
+
+static HYDRAHOOK_D3D_VERSION ReplayVersion(const HYDRAHOOK_RECORD& record, HYDRAHOOK_D3D_VERSION lastPresent1)
+{
+	switch (record.Site)
+	{
+	case HydraHookRecordSiteD3D10Present:
+	case HydraHookRecordSiteD3D10ResizeTarget:
+	case HydraHookRecordSiteD3D10ResizeBuffers:
+		return HydraHookDirect3DVersion10;
+	case HydraHookRecordSiteD3D11Present:
+	case HydraHookRecordSiteD3D11ResizeTarget:
+	case HydraHookRecordSiteD3D11ResizeBuffers:
+		return HydraHookDirect3DVersion11;
+	case HydraHookRecordSiteD3D12Present:
+	case HydraHookRecordSiteD3D12ResizeTarget:
+	case HydraHookRecordSiteD3D12ResizeBuffers:
+		return HydraHookDirect3DVersion12;
+	case HydraHookRecordSiteDXGIPresent1:
+		if (record.Args[2] == HydraHookDirect3DVersion11 || record.Args[2] == HydraHookDirect3DVersion12)
+			return static_cast<HYDRAHOOK_D3D_VERSION>(record.Args[2]);
+		return HydraHookDirect3DVersionUnknown;
+	case HydraHookRecordSiteDXGIResizeBuffers1:
+		// Not recorded with a version; belongs to whatever this thread last presented through Present1
+		return lastPresent1;
+	default:
+		// D3D9 and audio calls have no mock to replay on
+		return HydraHookDirect3DVersionUnknown;
+	}
+}
+
+static bool LoadRecording(const std::string& path, const std::shared_ptr<spdlog::logger>& logger)
+{
+	const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+	                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		logger->error("Failed to open recording {}: {}", path, GetLastError());
+		return false;
+	}
+
+	std::vector<uint8_t> data;
+	LARGE_INTEGER size;
+	DWORD read = 0;
+
+	bool ok = GetFileSizeEx(file, &size) && size.QuadPart >= static_cast<LONGLONG>(sizeof(
+		HYDRAHOOK_RECORD_FILE_HEADER)) && size.QuadPart < MAXDWORD;
+
+	if (ok)
+	{
+		data.resize(static_cast<size_t>(size.QuadPart));
+		ok = ReadFile(file, data.data(), static_cast<DWORD>(data.size()), &read, nullptr) && read == data.size();
+	}
+
+	CloseHandle(file);
+
+	if (!ok)
+	{
+		logger->error("Failed to read recording {}: {}", path, GetLastError());
+		return false;
+	}
+
+	HYDRAHOOK_RECORD_FILE_HEADER header;
+	memcpy(&header, data.data(), sizeof(header));
+
+	if (header.Magic != HYDRAHOOK_RECORD_MAGIC || header.Version != HYDRAHOOK_RECORD_VERSION
+		|| header.RecordSize < sizeof(HYDRAHOOK_RECORD) || header.QpcFrequency <= 0)
+	{
+		logger->error("{} is not a version {} HydraHook recording", path, HYDRAHOOK_RECORD_VERSION);
+		return false;
+	}
+
+	//
+	// Split by recording thread; the ring drains in claim order, not start order
+	//
+	std::map<uint32_t, ReplayStream*> byThread;
+	uint64_t dropped = 0;
+	size_t total = 0;
+
+	for (size_t offset = sizeof(header); offset + header.RecordSize <= data.size(); offset += header.RecordSize)
+	{
+		HYDRAHOOK_RECORD record;
+		memcpy(&record, data.data() + offset, sizeof(record));
+		total++;
+
+		if (record.Site == HydraHookRecordSiteDropped)
+		{
+			dropped += record.Args[0];
+			continue;
+		}
+
+		auto& stream = byThread[record.ThreadId];
+		if (!stream)
+		{
+			g_Streams.push_back(std::make_unique<ReplayStream>());
+			stream = g_Streams.back().get();
+			stream->ThreadId = record.ThreadId;
+		}
+
+		stream->Records.push_back(record);
+	}
+
+	g_ReplayFirstStart = UINT64_MAX;
+	size_t replayed = 0;
+
+	for (const auto& stream : g_Streams)
+	{
+		auto& records = stream->Records;
+		std::stable_sort(records.begin(), records.end(), [](const HYDRAHOOK_RECORD& a, const HYDRAHOOK_RECORD& b)
+		{
+			return a.Start < b.Start;
+		});
+
+		stream->Targets.assign(records.size(), nullptr);
+
+		std::map<HYDRAHOOK_D3D_VERSION, MockSwapChain*> chains;
+		HYDRAHOOK_D3D_VERSION lastPresent1 = HydraHookDirect3DVersion12;
+		uint64_t busyUntil = 0;
+
+		for (size_t i = 0; i < records.size(); i++)
+		{
+			const auto& record = records[i];
+
+			//
+			// A record that starts inside the previous replayed call came from a hook further
+			// down the same call chain (e.g. D3D12 Present reaching the D3D10 hook); replaying
+			// the outer call already re-enters it
+			//
+			if (record.Start < busyUntil)
+			{
+				stream->Nested++;
+				continue;
+			}
+
+			const auto version = ReplayVersion(record, lastPresent1);
+			if (version == HydraHookDirect3DVersionUnknown)
+			{
+				stream->Skipped++;
+				continue;
+			}
+
+			const bool dxgi1 = record.Site == HydraHookRecordSiteDXGIPresent1
+				|| record.Site == HydraHookRecordSiteDXGIResizeBuffers1;
+
+			if (record.Site == HydraHookRecordSiteDXGIPresent1)
+				lastPresent1 = version;
+
+			auto& chain = chains[version];
+			if (!chain)
+			{
+				chain = CreateChain(version, false);
+				stream->Chains.push_back(chain);
+			}
+
+			if (dxgi1)
+				chain->UsePresent1 = true;
+
+			stream->Targets[i] = chain;
+			busyUntil = record.Start + record.Duration;
+			g_ReplayFirstStart = (std::min)(g_ReplayFirstStart, record.Start);
+			replayed++;
+		}
+	}
+
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	g_ReplayTickRatio = static_cast<double>(freq.QuadPart) / static_cast<double>(header.QpcFrequency);
+
+	logger->info("Replaying {} of {} recorded calls from {} (process {}) on {} thread(s) and {} chain(s), "
+	             "{} calls were dropped while recording",
+	             replayed, total, path, header.ProcessId, g_Streams.size(), g_Chains.size(), dropped);
+
+	return replayed > 0;
+}
+
+static void ReplayRecord(MockSwapChain* chain, const HYDRAHOOK_RECORD& record)
+{
+	switch (record.Site)
+	{
+	case HydraHookRecordSiteD3D10Present:
+	case HydraHookRecordSiteD3D11Present:
+	case HydraHookRecordSiteD3D12Present:
+		PresentOnce(chain, record.Args[0], record.Args[1], false);
+		break;
+	case HydraHookRecordSiteDXGIPresent1:
+		PresentOnce(chain, record.Args[0], record.Args[1], true);
+		break;
+	case HydraHookRecordSiteD3D10ResizeTarget:
+	case HydraHookRecordSiteD3D11ResizeTarget:
+	case HydraHookRecordSiteD3D12ResizeTarget:
+		{
+			DXGI_MODE_DESC desc = {};
+			desc.Width = record.Args[0];
+			desc.Height = record.Args[1];
+			desc.RefreshRate.Numerator = record.Args[2];
+			desc.RefreshRate.Denominator = record.Args[2] ? 1 : 0;
+
+			reinterpret_cast<IDXGISwapChain*>(chain)->ResizeTarget(&desc);
+			break;
+		}
+	case HydraHookRecordSiteD3D10ResizeBuffers:
+	case HydraHookRecordSiteD3D11ResizeBuffers:
+	case HydraHookRecordSiteD3D12ResizeBuffers:
+		ResizeOnce(chain, record.Args[0], record.Args[1], record.Args[2], false);
+		break;
+	case HydraHookRecordSiteDXGIResizeBuffers1:
+		ResizeOnce(chain, record.Args[0], record.Args[1], record.Args[2], true);
+		break;
+	default:
+		break;
+	}
+}
+
+static void ReplayThreadProc(ReplayStream* stream)
+{
+	const auto logger = spdlog::get("HYDRAHOOK")->clone("simulation");
+
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+
+	const LONGLONG ticksPerMs = freq.QuadPart / 1000;
+	const double speed = HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY_SPEED;
+
+	for (size_t i = 0; i < stream->Records.size() && !g_Stop.load(std::memory_order_acquire); i++)
+	{
+		const auto chain = stream->Targets[i];
+		if (!chain)
+			continue;
+
+		const auto& record = stream->Records[i];
+		const LONGLONG target = g_ReplayOrigin + static_cast<LONGLONG>(
+			static_cast<double>(record.Start - g_ReplayFirstStart) * g_ReplayTickRatio / speed);
+
+		WaitUntil(target, ticksPerMs);
+
+		LARGE_INTEGER before, after;
+		QueryPerformanceCounter(&before);
+		ReplayRecord(chain, record);
+		QueryPerformanceCounter(&after);
+
+		const LONGLONG lag = before.QuadPart - target;
+		stream->LagTicks += lag;
+		if (lag > stream->LagTicksMax)
+			stream->LagTicksMax = lag;
+		stream->CallTicks += after.QuadPart - before.QuadPart;
+		stream->RecordedTicks += static_cast<LONGLONG>(record.Duration * g_ReplayTickRatio);
+		stream->Replayed++;
+	}
+
+	for (const auto chain : stream->Chains)
+		CheckQueue(chain);
+
+	const double replayed = stream->Replayed ? static_cast<double>(stream->Replayed) : 1.0;
+	const double ticksPerUs = static_cast<double>(freq.QuadPart) / 1e6;
+
+	logger->info(
+		"swapchain-replay {{\"thread\":{},\"records\":{},\"replayed\":{},\"nested\":{},\"skipped\":{},"
+		"\"lag_us\":{:.3f},\"lag_us_max\":{:.3f},\"call_us\":{:.3f},\"recorded_call_us\":{:.3f}}}",
+		stream->ThreadId, stream->Records.size(), stream->Replayed, stream->Nested, stream->Skipped,
+		stream->LagTicks / ticksPerUs / replayed, stream->LagTicksMax / ticksPerUs,
+		stream->CallTicks / ticksPerUs / replayed, stream->RecordedTicks / ticksPerUs / replayed);
+}
+
+#else
+
+static bool ParseChains(const std::string& spec, const std::shared_ptr<spdlog::logger>& logger)
+{
+	size_t begin = 0;
+
+	while (begin <= spec.size())
+	{
+		auto end = spec.find(',', begin);
+		if (end == std::string::npos)
+			end = spec.size();
+
+		const auto token = spec.substr(begin, end - begin);
+		begin = end + 1;
+
+		if (token.empty())
+			continue;
+
+		HYDRAHOOK_D3D_VERSION version;
+
+		if (token.compare(0, 2, "10") == 0)
+			version = HydraHookDirect3DVersion10;
+		else if (token.compare(0, 2, "11") == 0)
+			version = HydraHookDirect3DVersion11;
+		else if (token.compare(0, 2, "12") == 0)
+			version = HydraHookDirect3DVersion12;
+		else
+		{
+			logger->error("Unknown simulated chain \"{}\", expected 10, 11 or 12 with optional p1 suffix", token);
+			return false;
+		}
+
+		const bool usePresent1 = token.size() > 2;
+
+		if (usePresent1 && token.compare(2, std::string::npos, "p1") != 0)
+		{
+			logger->error("Unknown simulated chain \"{}\", expected 10, 11 or 12 with optional p1 suffix", token);
+			return false;
+		}
+
+		if (usePresent1 && version == HydraHookDirect3DVersion10)
+		{
+			logger->error("Simulated chain \"{}\": D3D10 swap chains have no DXGI 1.2 methods", token);
+			return false;
+		}
+
+		CreateChain(version, usePresent1);
+	}
+
+	return !g_Chains.empty();
+}
+
+static void ChainThreadProc(MockSwapChain* chain)
+{
+	const auto logger = spdlog::get("HYDRAHOOK")->clone("simulation");
+
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+
+	const LONGLONG ticksPerMs = freq.QuadPart / 1000;
+	const LONGLONG interval = HYDRAHOOK_SWAPCHAIN_SIMULATION_FPS > 0
+		                          ? freq.QuadPart / HYDRAHOOK_SWAPCHAIN_SIMULATION_FPS
+		                          : 0;
+	const LONGLONG reportTicks = ticksPerMs * HYDRAHOOK_SWAPCHAIN_SIMULATION_REPORT_MS;
+	const ULONG resizeInterval = HYDRAHOOK_SWAPCHAIN_SIMULATION_RESIZE_INTERVAL;
+
+	LONGLONG next = now.QuadPart + interval;
+	LONGLONG windowStart = now.QuadPart;
+	LONGLONG windowPresents = 0;
+	LONGLONG windowTicks = 0;
+	LONGLONG windowTicksMax = 0;
+
+	while (!g_Stop.load(std::memory_order_acquire))
+	{
+		if (resizeInterval && chain->Presents % resizeInterval == resizeInterval - 1)
+		{
+			const bool large = chain->Width < 1920;
+
+			ResizeOnce(chain, chain->UsePresent1 ? 2 : 0, large ? 1920 : 1280, large ? 1080 : 720,
+			           chain->UsePresent1);
+		}
+
+		const LONGLONG ticks = PresentOnce(chain, 0, 0, chain->UsePresent1);
+
+		windowPresents++;
+		windowTicks += ticks;
+		if (ticks > windowTicksMax)
+			windowTicksMax = ticks;
+
+		QueryPerformanceCounter(&now);
+
+		if (now.QuadPart - windowStart >= reportTicks && !g_ShuttingDown.load(std::memory_order_relaxed))
+		{
+			CheckQueue(chain);
+
+			const double seconds = static_cast<double>(now.QuadPart - windowStart) / freq.QuadPart;
+			Report(logger, chain, "run", windowPresents / seconds,
+			       windowTicks * 1e6 / freq.QuadPart / windowPresents, windowTicksMax * 1e6 / freq.QuadPart);
+
+			windowStart = now.QuadPart;
+			windowPresents = windowTicks = windowTicksMax = 0;
+		}
+
+		if (interval)
+		{
+			WaitUntil(next, ticksPerMs);
+
+			//
+			// Don't try to catch up after falling behind
+			//
+			QueryPerformanceCounter(&now);
+			next = (now.QuadPart - next > interval) ? now.QuadPart + interval : next + interval;
+		}
+	}
+}
+
+#endif
+
+void HydraHookSwapChainSimulationStart(PHYDRAHOOK_ENGINE Engine)
+{
+	auto logger = spdlog::get("HYDRAHOOK")->clone("simulation");
+
+	std::call_once(g_VtblOnce, BuildVtables);
+
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY
+	const auto path = HydraHook::Core::Util::expand_environment_variables(HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY);
+
+	if (!LoadRecording(path, logger))
+	{
+		logger->error("Nothing to replay, simulation not started");
+		g_Streams.clear();
+		g_Chains.clear();
+		return;
+	}
+#else
+	if (!ParseChains(HYDRAHOOK_SWAPCHAIN_SIMULATION_CHAINS, logger))
+	{
+		logger->error("No simulated swap chains configured, simulation not started");
+		g_Chains.clear();
+		return;
+	}
+#endif
+
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	g_PresentBurnTicks = freq.QuadPart * HYDRAHOOK_SWAPCHAIN_SIMULATION_PRESENT_US / 1000000;
+
+	HydraHookSwapChainSimulationInterpose(Engine);
+
+	g_Stop = false;
+	g_ShuttingDown = false;
+
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY
+	//
+	// Give every replay thread time to start before the first recorded call is due
+	//
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	g_ReplayOrigin = now.QuadPart + freq.QuadPart / 10;
+
+	for (const auto& stream : g_Streams)
+	{
+		stream->Thread = std::thread(ReplayThreadProc, stream.get());
+	}
+#else
+	logger->info("Simulating {} swap chain(s) \"{}\" at {} fps, resizing every {} presents",
+	             g_Chains.size(), HYDRAHOOK_SWAPCHAIN_SIMULATION_CHAINS, HYDRAHOOK_SWAPCHAIN_SIMULATION_FPS,
+	             HYDRAHOOK_SWAPCHAIN_SIMULATION_RESIZE_INTERVAL);
+
+	for (const auto& chain : g_Chains)
+	{
+		chain->Thread = std::thread(ChainThreadProc, chain.get());
+	}
+#endif
+}
+
+void HydraHookSwapChainSimulationShutdownBegin()
+{
+	QueryPerformanceCounter(&g_ShutdownStart);
+	g_ShuttingDown.store(true, std::memory_order_relaxed);
+}
+
+void HydraHookSwapChainSimulationStop(PHYDRAHOOK_ENGINE Engine)
+{
+	if (g_Chains.empty())
+		return;
+
+	auto logger = spdlog::get("HYDRAHOOK")->clone("simulation");
+
+	//
+	// Everything up to here (hook removal and drain) happened with the chains still presenting
+	//
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	const double shutdownMs = g_ShuttingDown
+		                          ? static_cast<double>(now.QuadPart - g_ShutdownStart.QuadPart) * 1e3 / freq.QuadPart
+		                          : 0.0;
+
+	g_Stop.store(true, std::memory_order_release);
+
+#ifdef HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY
+	for (const auto& stream : g_Streams)
+	{
+		if (stream->Thread.joinable())
+			stream->Thread.join();
+	}
+
+	g_Streams.clear();
+#endif
+
+	for (const auto& chain : g_Chains)
+	{
+		if (chain->Thread.joinable())
+			chain->Thread.join();
+	}
+
+	LONG64 shutdownPresents = 0, lateCallbacks = 0;
+
+	for (const auto& chain : g_Chains)
+	{
+		Report(logger, chain.get(), "final", 0.0, 0.0, 0.0);
+		shutdownPresents += chain->ShutdownPresents;
+		lateCallbacks += chain->LateCallbacks;
+	}
+
+	logger->info(
+		"swapchain-simulation {{\"phase\":\"shutdown\",\"shutdown_ms\":{:.3f},\"presents_during_shutdown\":{},\"late_callbacks\":{}}}",
+		shutdownMs, shutdownPresents, lateCallbacks);
+
+	{
+		std::lock_guard<std::mutex> lock(g_InterposeLock);
+
+		SIM_FOR_EACH_SLOT(SIM_RESTORE, Engine)
+	}
+
+	//
+	// Don't leave the engine pointing at freed mocks
+	//
+	if (MockSwapChainFrom(reinterpret_cast<IUnknown*>(Engine->RenderPipeline.pSwapChain)))
+		Engine->RenderPipeline.pSwapChain = nullptr;
+
+	g_Chains.clear();
+}
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file SwapChainSimulation.h
+ * @brief Opt-in mock swap chain driver for running the hook dispatch without a GPU.
+ *
+ * Compiled only with HYDRAHOOK_SWAPCHAIN_SIMULATION defined. Replaces the
+ * prober vtables with mock IDXGISwapChain / device / ID3D12CommandQueue
+ * vtables, so Game.cpp detours the mock methods with its real lambdas, then
+ * presents on those mocks from one thread per chain and logs what the host
+ * callbacks observed. With HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY set, the
+ * calls of a HydraHookRecord file are replayed instead, with their recorded
+ * timing.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#pragma once
+
+#if defined(HYDRAHOOK_SWAPCHAIN_SIMULATION) && !defined(HYDRAHOOK_NO_D3D10) && !defined(HYDRAHOOK_NO_D3D11) && !defined(HYDRAHOOK_NO_D3D12)
+
+#define HYDRAHOOK_SWAPCHAIN_SIMULATION_ENABLED
+
+#include "HydraHook/Engine/HydraHookCore.h"
+
+#include <vector>
+
+/**
+ * @brief Comma-separated chains to simulate: "10", "11" or "12", with a
+ *        "p1" suffix to present (and resize) through the DXGI 1.2+ methods.
+ */
+#ifndef HYDRAHOOK_SWAPCHAIN_SIMULATION_CHAINS
+#define HYDRAHOOK_SWAPCHAIN_SIMULATION_CHAINS "11,11p1,12,12p1"
+#endif
+
+/**
+ * @brief Presents per second on each chain; 0 presents as fast as possible.
+ */
+#ifndef HYDRAHOOK_SWAPCHAIN_SIMULATION_FPS
+#define HYDRAHOOK_SWAPCHAIN_SIMULATION_FPS 240
+#endif
+
+/**
+ * @brief Presents between two ResizeBuffers calls on each chain; 0 never resizes.
+ */
+#ifndef HYDRAHOOK_SWAPCHAIN_SIMULATION_RESIZE_INTERVAL
+#define HYDRAHOOK_SWAPCHAIN_SIMULATION_RESIZE_INTERVAL 600
+#endif
+
+/**
+ * @brief Microseconds the mock Present spins, standing in for driver time.
+ */
+#ifndef HYDRAHOOK_SWAPCHAIN_SIMULATION_PRESENT_US
+#define HYDRAHOOK_SWAPCHAIN_SIMULATION_PRESENT_US 0
+#endif
+
+/**
+ * @brief Interval of the per-chain "swapchain-simulation {json}" report.
+ */
+#ifndef HYDRAHOOK_SWAPCHAIN_SIMULATION_REPORT_MS
+#define HYDRAHOOK_SWAPCHAIN_SIMULATION_REPORT_MS 1000
+#endif
+
+/**
+ * @brief Recording (HydraHookRecord.h format) to replay instead of the synthetic chains,
+ *        e.g. "%TEMP%\\HydraHook-replay.hhrec"; environment variables are expanded.
+ *
+ * Must not be the file EngineConfig.Recorder writes to, which is truncated
+ * before the replay reads it.
+ */
+// #define HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY "%TEMP%\\HydraHook-replay.hhrec"
+
+/**
+ * @brief Replay speed factor; 2.0 replays twice as fast as recorded.
+ */
+#ifndef HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY_SPEED
+#define HYDRAHOOK_SWAPCHAIN_SIMULATION_REPLAY_SPEED 1.0
+#endif
+
+/**
+ * @brief Mock IDXGISwapChain3 vtable, in place of the Direct3D10/11/12 prober vtables.
+ */
+std::vector<size_t> HydraHookSwapChainSimulationVtable();
+
+/**
+ * @brief Mock ID3D12CommandQueue vtable, in place of Direct3D12::commandQueueVtable().
+ */
+void** HydraHookSwapChainSimulationQueueVtable();
+
+/**
+ * @brief Routes the engine's Present/ResizeBuffers callbacks through counting forwarders.
+ *
+ * Called after every HydraHookEngineSetD3D1xEventCallbacks so host callbacks
+ * registered later still get observed; the host's callbacks keep running.
+ */
+void HydraHookSwapChainSimulationInterpose(PHYDRAHOOK_ENGINE Engine);
+
+/**
+ * @brief Starts one presenting thread per configured chain.
+ *
+ * Must be called after the hooks have been applied.
+ */
+void HydraHookSwapChainSimulationStart(PHYDRAHOOK_ENGINE Engine);
+
+/**
+ * @brief Marks the start of shutdown; the chains keep presenting while hooks are removed.
+ */
+void HydraHookSwapChainSimulationShutdownBegin();
+
+/**
+ * @brief Stops and joins the chain threads, logs the final report and frees the mocks.
+ *
+ * Must be called after hooks were removed and in-flight calls drained.
+ */
+void HydraHookSwapChainSimulationStop(PHYDRAHOOK_ENGINE Engine);
+
+#endif
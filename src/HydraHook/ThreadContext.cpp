@@ -0,0 +1,226 @@
+/**
+ * @file ThreadContext.cpp
+ * @brief Lazily created, cache-line isolated per-thread callback contexts.
+ *
+ * Each thread caches the slot it last resolved together with the engine's
+ * generation, so the lookup on the callback hot path is a thread-local
+ * compare. The engine lock is only taken to create a slot, to enumerate,
+ * or to replace all slots.
+ *
+ * @internal
+ * @copyright MIT License (c) 2018-2026 Benjamin Höglinger-Stelzer
+ */
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "HydraHook/Engine/HydraHookCore.h"
+#include "HydraHook/Engine/HydraHookDirect3D9.h"
+#include "HydraHook/Engine/HydraHookDirect3D10.h"
+#include "HydraHook/Engine/HydraHookDirect3D11.h"
+#include "HydraHook/Engine/HydraHookDirect3D12.h"
+#include "HydraHook/Engine/HydraHookCoreAudio.h"
+#include "Engine.h"
+#include "Allocator.h"
+
+#include <cstdint>
+
+constexpr size_t kCacheLineSize = 64;
+
+/**
+ * @brief Bookkeeping for one thread's slot; the slot data itself is separately aligned.
+ */
+typedef struct _HYDRAHOOK_THREAD_CONTEXT_SLOT
+{
+	struct _HYDRAHOOK_THREAD_CONTEXT_SLOT* Next;
+	DWORD ThreadId;
+	PVOID Raw;   // allocation base
+	PVOID Data;  // cache-line aligned slot handed to the host
+} HYDRAHOOK_THREAD_CONTEXT_SLOT, *PHYDRAHOOK_THREAD_CONTEXT_SLOT;
+
+//
+// Generations are unique across engines so a recycled engine address can
+// never match a stale thread-local cache entry
+// 
+static std::atomic<uint32_t> g_ThreadContextGeneration{ 1 };
+
+static thread_local struct
+{
+	PHYDRAHOOK_ENGINE Engine;
+	uint32_t Generation;
+	PVOID Data;
+} t_ThreadContext;
+
+static void FreeSlotList(PHYDRAHOOK_THREAD_CONTEXT_SLOT slot)
+{
+	while (slot)
+	{
+		const auto next = slot->Next;
+		HydraHook::Core::Memory::Free(slot->Raw);
+		HydraHook::Core::Memory::Free(slot);
+		slot = next;
+	}
+}
+
+static PHYDRAHOOK_THREAD_CONTEXT_SLOT CreateSlot(size_t slotSize, DWORD threadId)
+{
+	using namespace HydraHook::Core::Memory;
+
+	const auto slot = static_cast<PHYDRAHOOK_THREAD_CONTEXT_SLOT>(
+		Allocate(sizeof(HYDRAHOOK_THREAD_CONTEXT_SLOT), HydraHookMemoryTagContext));
+	if (!slot)
+	{
+		return nullptr;
+	}
+
+	//
+	// Over-allocate by one line so the aligned slot owns all lines it touches
+	// 
+	slot->Raw = Allocate(slotSize + kCacheLineSize, HydraHookMemoryTagContext);
+	if (!slot->Raw)
+	{
+		Free(slot);
+		return nullptr;
+	}
+
+	const auto base = reinterpret_cast<uintptr_t>(slot->Raw);
+	slot->Data = reinterpret_cast<PVOID>((base + kCacheLineSize - 1) & ~(kCacheLineSize - 1));
+	slot->ThreadId = threadId;
+	slot->Next = nullptr;
+
+	ZeroMemory(slot->Data, slotSize);
+
+	return slot;
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineAllocThreadContext(PHYDRAHOOK_ENGINE Engine, size_t ContextSize)
+{
+	if (!Engine)
+	{
+		return HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!ContextSize || ContextSize > SIZE_MAX - 2 * kCacheLineSize)
+	{
+		return HYDRAHOOK_ERROR_INVALID_PARAMETER;
+	}
+
+	AcquireSRWLockExclusive(&Engine->ThreadContexts.Lock);
+	const auto old = Engine->ThreadContexts.Slots;
+	Engine->ThreadContexts.Slots = nullptr;
+	Engine->ThreadContexts.SlotSize = (ContextSize + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
+	Engine->ThreadContexts.Generation.store(g_ThreadContextGeneration.fetch_add(1), std::memory_order_release);
+	ReleaseSRWLockExclusive(&Engine->ThreadContexts.Lock);
+
+	FreeSlotList(old);
+
+	return HYDRAHOOK_ERROR_NONE;
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API PVOID HydraHookEngineGetThreadContext(PHYDRAHOOK_ENGINE Engine)
+{
+	if (!Engine)
+	{
+		return nullptr;
+	}
+
+	const uint32_t generation = Engine->ThreadContexts.Generation.load(std::memory_order_acquire);
+
+	if (t_ThreadContext.Engine == Engine && t_ThreadContext.Generation == generation)
+	{
+		return t_ThreadContext.Data;
+	}
+
+	const DWORD threadId = GetCurrentThreadId();
+	PVOID data = nullptr;
+
+	AcquireSRWLockExclusive(&Engine->ThreadContexts.Lock);
+
+	//
+	// Re-check under the lock; slots may have been replaced or freed meanwhile
+	// 
+	const uint32_t current = Engine->ThreadContexts.Generation.load(std::memory_order_relaxed);
+
+	if (Engine->ThreadContexts.SlotSize)
+	{
+		for (auto slot = Engine->ThreadContexts.Slots; slot; slot = slot->Next)
+		{
+			if (slot->ThreadId == threadId)
+			{
+				data = slot->Data;
+				break;
+			}
+		}
+
+		if (!data)
+		{
+			if (const auto slot = CreateSlot(Engine->ThreadContexts.SlotSize, threadId))
+			{
+				slot->Next = Engine->ThreadContexts.Slots;
+				Engine->ThreadContexts.Slots = slot;
+				data = slot->Data;
+			}
+		}
+	}
+
+	ReleaseSRWLockExclusive(&Engine->ThreadContexts.Lock);
+
+	if (data)
+	{
+		t_ThreadContext.Engine = Engine;
+		t_ThreadContext.Generation = current;
+		t_ThreadContext.Data = data;
+	}
+
+	return data;
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineEnumerateThreadContexts(PHYDRAHOOK_ENGINE Engine,
+                                                                     PFN_HYDRAHOOK_THREAD_CONTEXT_VISITOR Visitor,
+                                                                     PVOID UserData)
+{
+	if (!Engine)
+	{
+		return HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Visitor)
+	{
+		return HYDRAHOOK_ERROR_INVALID_PARAMETER;
+	}
+
+	AcquireSRWLockShared(&Engine->ThreadContexts.Lock);
+	for (auto slot = Engine->ThreadContexts.Slots; slot; slot = slot->Next)
+	{
+		if (!Visitor(Engine, slot->ThreadId, slot->Data, UserData))
+		{
+			break;
+		}
+	}
+	ReleaseSRWLockShared(&Engine->ThreadContexts.Lock);
+
+	return HYDRAHOOK_ERROR_NONE;
+}
+
+_Use_decl_annotations_
+HYDRAHOOK_API HYDRAHOOK_ERROR HydraHookEngineFreeThreadContexts(PHYDRAHOOK_ENGINE Engine)
+{
+	if (!Engine)
+	{
+		return HYDRAHOOK_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	AcquireSRWLockExclusive(&Engine->ThreadContexts.Lock);
+	const auto old = Engine->ThreadContexts.Slots;
+	Engine->ThreadContexts.Slots = nullptr;
+	Engine->ThreadContexts.SlotSize = 0;
+	Engine->ThreadContexts.Generation.store(g_ThreadContextGeneration.fetch_add(1), std::memory_order_release);
+	ReleaseSRWLockExclusive(&Engine->ThreadContexts.Lock);
+
+	FreeSlotList(old);
+
+	return HYDRAHOOK_ERROR_NONE;
+}